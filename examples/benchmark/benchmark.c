@@ -0,0 +1,253 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <time.h>
+
+#include "benchmark.h"
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+
+/*-----------------------------------------------------------*/
+
+static uint32_t ulRandomState = 1U;
+static BaseType_t xFirstResult = pdTRUE;
+
+/*-----------------------------------------------------------*/
+
+uint64_t ullBenchNowNs( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+void vBenchRandomSeed( uint32_t ulSeed )
+{
+    /* xorshift32 must not be seeded with 0. */
+    ulRandomState = ( ulSeed != 0U ) ? ulSeed : 1U;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulBenchRandom( void )
+{
+    ulRandomState ^= ulRandomState << 13;
+    ulRandomState ^= ulRandomState >> 17;
+    ulRandomState ^= ulRandomState << 5;
+
+    return ulRandomState;
+}
+/*-----------------------------------------------------------*/
+
+void vBenchSamplesReset( BenchSamples_t * pxSamples )
+{
+    pxSamples->xCount = 0U;
+    pxSamples->xDropped = 0U;
+}
+/*-----------------------------------------------------------*/
+
+void vBenchSamplesAdd( BenchSamples_t * pxSamples,
+                       uint64_t ullNs )
+{
+    if( pxSamples->xCount < benchMAX_SAMPLES )
+    {
+        pxSamples->ulSamples[ pxSamples->xCount ] = ( ullNs > UINT32_MAX ) ? UINT32_MAX : ( uint32_t ) ullNs;
+        pxSamples->xCount++;
+    }
+    else
+    {
+        pxSamples->xDropped++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Heap sort rather than qsort() - qsort() may allocate from the C library
+ * heap, which is not safe while the scheduler is running. */
+static void prvSiftDown( uint32_t * pulValues,
+                         size_t xRoot,
+                         size_t xEnd )
+{
+    size_t xChild;
+    uint32_t ulSwap;
+
+    while( ( 2U * xRoot ) + 1U < xEnd )
+    {
+        xChild = ( 2U * xRoot ) + 1U;
+
+        if( ( xChild + 1U < xEnd ) && ( pulValues[ xChild ] < pulValues[ xChild + 1U ] ) )
+        {
+            xChild++;
+        }
+
+        if( pulValues[ xRoot ] >= pulValues[ xChild ] )
+        {
+            break;
+        }
+
+        ulSwap = pulValues[ xRoot ];
+        pulValues[ xRoot ] = pulValues[ xChild ];
+        pulValues[ xChild ] = ulSwap;
+        xRoot = xChild;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSort( uint32_t * pulValues,
+                     size_t xCount )
+{
+    size_t x;
+    uint32_t ulSwap;
+
+    for( x = xCount / 2U; x > 0U; x-- )
+    {
+        prvSiftDown( pulValues, x - 1U, xCount );
+    }
+
+    for( x = xCount; x > 1U; x-- )
+    {
+        ulSwap = pulValues[ 0 ];
+        pulValues[ 0 ] = pulValues[ x - 1U ];
+        pulValues[ x - 1U ] = ulSwap;
+        prvSiftDown( pulValues, 0U, x - 1U );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvPercentile( const BenchSamples_t * pxSamples,
+                               uint32_t ulPercent )
+{
+    size_t xIndex = ( ( pxSamples->xCount - 1U ) * ulPercent ) / 100U;
+
+    return pxSamples->ulSamples[ xIndex ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvBeginResult( const char * pcName,
+                            const char * pcParameters )
+{
+    ( void ) printf( "%s\n    { \"name\": \"%s\"", ( xFirstResult != pdFALSE ) ? "" : ",", pcName );
+    xFirstResult = pdFALSE;
+
+    if( pcParameters != NULL )
+    {
+        ( void ) printf( ", %s", pcParameters );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vBenchReportBegin( const char * pcSuite,
+                        uint32_t ulIterations )
+{
+    xFirstResult = pdTRUE;
+
+    ( void ) printf( "{\n  \"suite\": \"%s\",\n", pcSuite );
+    ( void ) printf( "  \"config\": { \"tick_rate_hz\": %u, \"cores\": %u, \"iterations\": %u },\n",
+                     ( unsigned ) configTICK_RATE_HZ, ( unsigned ) configNUMBER_OF_CORES, ( unsigned ) ulIterations );
+    ( void ) printf( "  \"results\": [" );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchReportLatency( const char * pcName,
+                          const char * pcParameters,
+                          BenchSamples_t * pxSamples )
+{
+    uint64_t ullSum = 0U;
+    size_t x;
+
+    prvBeginResult( pcName, pcParameters );
+
+    if( pxSamples->xCount == 0U )
+    {
+        ( void ) printf( ", \"samples\": 0 }" );
+    }
+    else
+    {
+        prvSort( pxSamples->ulSamples, pxSamples->xCount );
+
+        for( x = 0U; x < pxSamples->xCount; x++ )
+        {
+            ullSum += pxSamples->ulSamples[ x ];
+        }
+
+        ( void ) printf( ", \"samples\": %lu, \"unit\": \"ns\", \"min\": %u, \"mean\": %lu, \"p50\": %u, \"p90\": %u, \"p99\": %u, \"max\": %u }",
+                         ( unsigned long ) pxSamples->xCount,
+                         ( unsigned ) pxSamples->ulSamples[ 0 ],
+                         ( unsigned long ) ( ullSum / pxSamples->xCount ),
+                         ( unsigned ) prvPercentile( pxSamples, 50U ),
+                         ( unsigned ) prvPercentile( pxSamples, 90U ),
+                         ( unsigned ) prvPercentile( pxSamples, 99U ),
+                         ( unsigned ) pxSamples->ulSamples[ pxSamples->xCount - 1U ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vBenchReportThroughput( const char * pcName,
+                             const char * pcParameters,
+                             uint64_t ullItems,
+                             uint64_t ullBytes,
+                             uint64_t ullElapsedNs )
+{
+    double dSeconds = ( double ) ullElapsedNs / 1e9;
+
+    if( dSeconds <= 0.0 )
+    {
+        dSeconds = 1e-9;
+    }
+
+    prvBeginResult( pcName, pcParameters );
+
+    ( void ) printf( ", \"items\": %lu, \"bytes\": %lu, \"elapsed_ns\": %lu, \"items_per_sec\": %.0f, \"bytes_per_sec\": %.0f }",
+                     ( unsigned long ) ullItems,
+                     ( unsigned long ) ullBytes,
+                     ( unsigned long ) ullElapsedNs,
+                     ( double ) ullItems / dSeconds,
+                     ( double ) ullBytes / dSeconds );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchReportValues( const char * pcName,
+                         const char * pcParameters,
+                         const char * pcValues )
+{
+    prvBeginResult( pcName, pcParameters );
+
+    ( void ) printf( ", %s }", pcValues );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchReportEnd( void )
+{
+    ( void ) printf( "\n  ]\n}\n" );
+    ( void ) fflush( stdout );
+}
+/*-----------------------------------------------------------*/
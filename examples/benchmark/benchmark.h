@@ -0,0 +1,91 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Helpers shared by the kernel benchmarks - time stamps, latency sample sets
+ * and the JSON report written to stdout.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* The most samples a sample set holds.  Samples added to a full set are
+ * counted but not stored. */
+#ifndef benchMAX_SAMPLES
+    #define benchMAX_SAMPLES    ( 100000U )
+#endif
+
+/* Latencies of one operation, in nanoseconds. */
+typedef struct BenchSamples
+{
+    size_t xCount;
+    size_t xDropped;
+    uint32_t ulSamples[ benchMAX_SAMPLES ];
+} BenchSamples_t;
+
+/* Monotonic host time in nanoseconds. */
+uint64_t ullBenchNowNs( void );
+
+/* Pseudo random sequence that restarts from the same seed every time
+ * vBenchRandomSeed() is called, so runs can be compared. */
+void vBenchRandomSeed( uint32_t ulSeed );
+uint32_t ulBenchRandom( void );
+
+void vBenchSamplesReset( BenchSamples_t * pxSamples );
+void vBenchSamplesAdd( BenchSamples_t * pxSamples,
+                       uint64_t ullNs );
+
+/* The report is a single JSON object:
+ *
+ * { "suite": ..., "config": { ... }, "results": [ { "name": ..., ... }, ... ] }
+ *
+ * pcParameters is an optional (NULL if unused) JSON fragment holding the
+ * parameters of a result, for example "\"item_size\": 16". */
+void vBenchReportBegin( const char * pcSuite,
+                        uint32_t ulIterations );
+void vBenchReportLatency( const char * pcName,
+                          const char * pcParameters,
+                          BenchSamples_t * pxSamples );
+void vBenchReportThroughput( const char * pcName,
+                             const char * pcParameters,
+                             uint64_t ullItems,
+                             uint64_t ullBytes,
+                             uint64_t ullElapsedNs );
+
+/* A result whose fields are given by pcValues, a JSON fragment in the same
+ * form as pcParameters. */
+void vBenchReportValues( const char * pcName,
+                         const char * pcParameters,
+                         const char * pcValues );
+
+void vBenchReportEnd( void );
+
+#endif /* BENCHMARK_H */
@@ -0,0 +1,87 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#include "benchmark_heaps.h"
+
+/*-----------------------------------------------------------*/
+
+/* The renamed functions of each heap (see CMakeLists.txt). */
+#define benchDECLARE_HEAP( n )                                         \
+    void * benchHeap ## n ## _pvPortMalloc( size_t xWantedSize );     \
+    void benchHeap ## n ## _vPortFree( void * pv );                   \
+    void benchHeap ## n ## _vPortHeapResetState( void )
+
+benchDECLARE_HEAP( 1 );
+benchDECLARE_HEAP( 2 );
+benchDECLARE_HEAP( 3 );
+benchDECLARE_HEAP( 4 );
+benchDECLARE_HEAP( 5 );
+
+size_t benchHeap1_xPortGetFreeHeapSize( void );
+size_t benchHeap2_xPortGetFreeHeapSize( void );
+size_t benchHeap4_xPortGetFreeHeapSize( void );
+size_t benchHeap5_xPortGetFreeHeapSize( void );
+void benchHeap2_vPortGetHeapStats( HeapStats_t * pxHeapStats );
+void benchHeap4_vPortGetHeapStats( HeapStats_t * pxHeapStats );
+void benchHeap5_vPortGetHeapStats( HeapStats_t * pxHeapStats );
+void benchHeap5_vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions );
+
+/*-----------------------------------------------------------*/
+
+static void prvResetHeap5( void );
+
+/*-----------------------------------------------------------*/
+
+/* heap_5 is given a single region the same size as the other heaps. */
+static uint8_t ucHeap5Region[ configTOTAL_HEAP_SIZE ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+
+const BenchHeap_t xBenchHeaps[] =
+{
+    { "heap_1", benchHeap1_pvPortMalloc, NULL,                    benchHeap1_vPortHeapResetState, benchHeap1_xPortGetFreeHeapSize, NULL,                         configTOTAL_HEAP_SIZE },
+    { "heap_2", benchHeap2_pvPortMalloc, benchHeap2_vPortFree,    benchHeap2_vPortHeapResetState, benchHeap2_xPortGetFreeHeapSize, benchHeap2_vPortGetHeapStats, configTOTAL_HEAP_SIZE },
+    { "heap_3", benchHeap3_pvPortMalloc, benchHeap3_vPortFree,    benchHeap3_vPortHeapResetState, NULL,                            NULL,                         0U                    },
+    { "heap_4", benchHeap4_pvPortMalloc, benchHeap4_vPortFree,    benchHeap4_vPortHeapResetState, benchHeap4_xPortGetFreeHeapSize, benchHeap4_vPortGetHeapStats, configTOTAL_HEAP_SIZE },
+    { "heap_5", benchHeap5_pvPortMalloc, benchHeap5_vPortFree,    prvResetHeap5,                  benchHeap5_xPortGetFreeHeapSize, benchHeap5_vPortGetHeapStats, configTOTAL_HEAP_SIZE }
+};
+
+const size_t xBenchHeapCount = sizeof( xBenchHeaps ) / sizeof( xBenchHeaps[ 0 ] );
+
+/*-----------------------------------------------------------*/
+
+static void prvResetHeap5( void )
+{
+    const HeapRegion_t xHeapRegions[] =
+    {
+        { ucHeap5Region, sizeof( ucHeap5Region ) },
+        { NULL,          0                       }
+    };
+
+    benchHeap5_vPortHeapResetState();
+    benchHeap5_vPortDefineHeapRegions( xHeapRegions );
+}
+/*-----------------------------------------------------------*/
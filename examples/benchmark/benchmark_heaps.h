@@ -0,0 +1,58 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * The heap implementations in portable/MemMang, side by side in one program.
+ * CMakeLists.txt builds a copy of each heap_n.c with its functions renamed to
+ * benchHeapn_<function>, so they can be benchmarked against each other while
+ * the kernel itself allocates from the heap selected by FREERTOS_HEAP.
+ */
+
+#ifndef BENCHMARK_HEAPS_H
+#define BENCHMARK_HEAPS_H
+
+#include <stddef.h>
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+
+typedef struct BenchHeap
+{
+    const char * pcName;
+    void * ( *pvMalloc )( size_t xWantedSize );
+    void ( * vFree )( void * pv );                            /* NULL if the heap cannot free memory (heap_1). */
+    void ( * vReset )( void );                                /* Returns the heap to its initial, empty, state. */
+    size_t ( * xGetFreeHeapSize )( void );                    /* NULL if not provided (heap_3). */
+    void ( * vGetHeapStats )( HeapStats_t * pxHeapStats );    /* NULL if not provided (heap_1 and heap_3). */
+    size_t xHeapSize;                                         /* 0 if the heap is the C library heap (heap_3). */
+} BenchHeap_t;
+
+extern const BenchHeap_t xBenchHeaps[];
+extern const size_t xBenchHeapCount;
+
+#endif /* BENCHMARK_HEAPS_H */
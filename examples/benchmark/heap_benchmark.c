@@ -0,0 +1,753 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Heap benchmarks.  Replays sequences of allocations and frees against each
+ * heap implementation and reports the malloc and free latencies, how
+ * fragmented the free space becomes and the point at which allocations start
+ * to fail, and writes the results to stdout as JSON.  The sequences are either
+ * synthetic workloads or traces of the pvPortMalloc() and vPortFree() calls
+ * made by an application (see README.md).
+ *
+ * Usage: heap_benchmark [--operations n] [trace files...]
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "benchmark.h"
+#include "benchmark_heaps.h"
+
+/*-----------------------------------------------------------*/
+
+#define benchCONTROL_PRIORITY         ( tskIDLE_PRIORITY + 1 )
+
+#define benchDEFAULT_OPERATIONS       ( 20000U )
+#define benchMAX_WORKLOADS            ( 16U )
+#define benchMAX_LINE_LENGTH          ( 256U )
+
+/* The random workloads keep up to benchRANDOM_SLOTS blocks allocated at once,
+ * the FIFO workload exactly benchFIFO_DEPTH blocks, and the LIFO workload up to
+ * benchLIFO_DEPTH blocks. */
+#define benchRANDOM_SLOTS             ( 256U )
+#define benchFIFO_DEPTH               ( 128U )
+#define benchLIFO_DEPTH               ( 256U )
+#define benchLIFO_MAX_BURST           ( 32U )
+
+/* The fragmenter workload fills part of the heap with small blocks, frees
+ * every other one, then asks for blocks that are too large to fit in the holes
+ * left behind. */
+#define benchFRAGMENT_SMALL_BLOCK     ( 64U )
+#define benchFRAGMENT_LARGE_BLOCK     ( 128U )
+#define benchFRAGMENT_BLOCKS          ( ( uint32_t ) configTOTAL_HEAP_SIZE / 128U )
+
+/*-----------------------------------------------------------*/
+
+typedef enum
+{
+    eHeapMalloc = 0,
+    eHeapFree
+} HeapOperationType_t;
+
+typedef struct HeapOperation
+{
+    uint32_t ulSlot; /* Identifies the block, so a free can name the allocation it releases. */
+    uint32_t ulSize; /* The size of an allocation, unused by frees. */
+    uint8_t ucType;  /* One of HeapOperationType_t. */
+} HeapOperation_t;
+
+typedef struct HeapWorkload
+{
+    char cName[ 64 ];
+    HeapOperation_t * pxOperations;
+    size_t xOperationCount;
+    size_t xOperationCapacity;
+    uint32_t ulSlotCount; /* The number of blocks that can be allocated at once. */
+} HeapWorkload_t;
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvReplayWorkload( const BenchHeap_t * pxHeap,
+                               const HeapWorkload_t * pxWorkload );
+static BaseType_t prvGetFreeSpace( const BenchHeap_t * pxHeap,
+                                   size_t * pxFreeBytes,
+                                   size_t * pxLargestFreeBlock );
+
+static HeapWorkload_t * prvNewWorkload( const char * pcName );
+static void prvAddOperation( HeapWorkload_t * pxWorkload,
+                             HeapOperationType_t eType,
+                             uint32_t ulSlot,
+                             uint32_t ulSize );
+static void prvGenerateRandom( const char * pcName,
+                               uint32_t ulMinSize,
+                               uint32_t ulMaxSize,
+                               BaseType_t xLogarithmic );
+static void prvGenerateFifo( void );
+static void prvGenerateLifo( void );
+static void prvGenerateFragmenter( void );
+static BaseType_t prvLoadTrace( const char * pcPath );
+
+/*-----------------------------------------------------------*/
+
+static uint32_t ulOperations = benchDEFAULT_OPERATIONS;
+
+static HeapWorkload_t xWorkloads[ benchMAX_WORKLOADS ];
+static size_t xWorkloadCount = 0U;
+
+/* The blocks allocated by the workload being replayed, indexed by slot. */
+static void ** ppvBlocks = NULL;
+
+static BenchSamples_t xMallocSamples;
+static BenchSamples_t xFreeSamples;
+
+/*-----------------------------------------------------------*/
+
+/* Free space and largest free block of the heap, if the heap can report them.
+ * heap_1 allocates from the end of a single region, so all of its free space
+ * is one block. */
+static BaseType_t prvGetFreeSpace( const BenchHeap_t * pxHeap,
+                                   size_t * pxFreeBytes,
+                                   size_t * pxLargestFreeBlock )
+{
+    HeapStats_t xHeapStats;
+    BaseType_t xReturn = pdTRUE;
+
+    if( pxHeap->vGetHeapStats != NULL )
+    {
+        pxHeap->vGetHeapStats( &xHeapStats );
+        *pxFreeBytes = xHeapStats.xAvailableHeapSpaceInBytes;
+        *pxLargestFreeBlock = xHeapStats.xSizeOfLargestFreeBlockInBytes;
+    }
+    else if( pxHeap->xGetFreeHeapSize != NULL )
+    {
+        *pxFreeBytes = pxHeap->xGetFreeHeapSize();
+        *pxLargestFreeBlock = *pxFreeBytes;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/* Fragmentation is the share of the free space that is not in the largest
+ * free block - 0 when all the free space could be handed out by a single
+ * allocation, approaching 1 as the free space is split into small blocks. */
+static double prvFragmentation( size_t xFreeBytes,
+                                size_t xLargestFreeBlock )
+{
+    double dReturn = 0.0;
+
+    if( xFreeBytes > 0U )
+    {
+        dReturn = 1.0 - ( ( double ) xLargestFreeBlock / ( double ) xFreeBytes );
+    }
+
+    return dReturn;
+}
+/*-----------------------------------------------------------*/
+
+/* Runs the operations of the workload against the heap.  An allocation that
+ * fails leaves its slot empty, so the free that would have released it is
+ * skipped.  The free space is sampled after every operation, outside of the
+ * timed calls. */
+static void prvReplayWorkload( const BenchHeap_t * pxHeap,
+                               const HeapWorkload_t * pxWorkload )
+{
+    const HeapOperation_t * pxOperation;
+    char cParameters[ 128 ];
+    char cFirstFailure[ 160 ];
+    char cValues[ 512 ];
+    size_t xOperation;
+    size_t xFreeBytes = 0U;
+    size_t xLargestFreeBlock = 0U;
+    size_t xMinimumFreeBytes = SIZE_MAX;
+    uint32_t ulMallocs = 0U;
+    uint32_t ulFailures = 0U;
+    uint32_t ulSlot;
+    double dFragmentation = 0.0;
+    double dPeakFragmentation = 0.0;
+    BaseType_t xHasFreeSpace;
+    uint64_t ullCallNs;
+
+    pxHeap->vReset();
+    vBenchSamplesReset( &xMallocSamples );
+    vBenchSamplesReset( &xFreeSamples );
+    ( void ) strcpy( cFirstFailure, "null" );
+
+    for( ulSlot = 0U; ulSlot < pxWorkload->ulSlotCount; ulSlot++ )
+    {
+        ppvBlocks[ ulSlot ] = NULL;
+    }
+
+    for( xOperation = 0U; xOperation < pxWorkload->xOperationCount; xOperation++ )
+    {
+        pxOperation = &( pxWorkload->pxOperations[ xOperation ] );
+
+        if( pxOperation->ucType == ( uint8_t ) eHeapMalloc )
+        {
+            ullCallNs = ullBenchNowNs();
+            ppvBlocks[ pxOperation->ulSlot ] = pxHeap->pvMalloc( pxOperation->ulSize );
+            vBenchSamplesAdd( &xMallocSamples, ullBenchNowNs() - ullCallNs );
+
+            ulMallocs++;
+
+            if( ppvBlocks[ pxOperation->ulSlot ] == NULL )
+            {
+                ulFailures++;
+
+                if( ulFailures == 1U )
+                {
+                    if( prvGetFreeSpace( pxHeap, &xFreeBytes, &xLargestFreeBlock ) != pdFALSE )
+                    {
+                        ( void ) snprintf( cFirstFailure, sizeof( cFirstFailure ),
+                                           "{ \"operation\": %lu, \"size\": %lu, \"free_bytes\": %lu, \"largest_free_block\": %lu }",
+                                           ( unsigned long ) xOperation, ( unsigned long ) pxOperation->ulSize,
+                                           ( unsigned long ) xFreeBytes, ( unsigned long ) xLargestFreeBlock );
+                    }
+                    else
+                    {
+                        ( void ) snprintf( cFirstFailure, sizeof( cFirstFailure ),
+                                           "{ \"operation\": %lu, \"size\": %lu, \"free_bytes\": null, \"largest_free_block\": null }",
+                                           ( unsigned long ) xOperation, ( unsigned long ) pxOperation->ulSize );
+                    }
+                }
+            }
+        }
+        else
+        {
+            if( ( ppvBlocks[ pxOperation->ulSlot ] != NULL ) && ( pxHeap->vFree != NULL ) )
+            {
+                ullCallNs = ullBenchNowNs();
+                pxHeap->vFree( ppvBlocks[ pxOperation->ulSlot ] );
+                vBenchSamplesAdd( &xFreeSamples, ullBenchNowNs() - ullCallNs );
+            }
+
+            ppvBlocks[ pxOperation->ulSlot ] = NULL;
+        }
+
+        if( prvGetFreeSpace( pxHeap, &xFreeBytes, &xLargestFreeBlock ) != pdFALSE )
+        {
+            dFragmentation = prvFragmentation( xFreeBytes, xLargestFreeBlock );
+
+            if( dFragmentation > dPeakFragmentation )
+            {
+                dPeakFragmentation = dFragmentation;
+            }
+
+            if( xFreeBytes < xMinimumFreeBytes )
+            {
+                xMinimumFreeBytes = xFreeBytes;
+            }
+        }
+    }
+
+    xHasFreeSpace = prvGetFreeSpace( pxHeap, &xFreeBytes, &xLargestFreeBlock );
+
+    if( xHasFreeSpace != pdFALSE )
+    {
+        ( void ) snprintf( cValues, sizeof( cValues ),
+                           "\"operations\": %lu, \"mallocs\": %lu, \"failures\": %lu, \"first_failure\": %s, "
+                           "\"peak_fragmentation\": %.4f, \"final_fragmentation\": %.4f, \"min_free_bytes\": %lu",
+                           ( unsigned long ) pxWorkload->xOperationCount, ( unsigned long ) ulMallocs,
+                           ( unsigned long ) ulFailures, cFirstFailure, dPeakFragmentation,
+                           prvFragmentation( xFreeBytes, xLargestFreeBlock ), ( unsigned long ) xMinimumFreeBytes );
+    }
+    else
+    {
+        ( void ) snprintf( cValues, sizeof( cValues ),
+                           "\"operations\": %lu, \"mallocs\": %lu, \"failures\": %lu, \"first_failure\": %s, "
+                           "\"peak_fragmentation\": null, \"final_fragmentation\": null, \"min_free_bytes\": null",
+                           ( unsigned long ) pxWorkload->xOperationCount, ( unsigned long ) ulMallocs,
+                           ( unsigned long ) ulFailures, cFirstFailure );
+    }
+
+    if( pxHeap->vFree != NULL )
+    {
+        for( ulSlot = 0U; ulSlot < pxWorkload->ulSlotCount; ulSlot++ )
+        {
+            pxHeap->vFree( ppvBlocks[ ulSlot ] );
+        }
+    }
+
+    pxHeap->vReset();
+
+    ( void ) snprintf( cParameters, sizeof( cParameters ), "\"heap\": \"%s\", \"workload\": \"%s\"", pxHeap->pcName, pxWorkload->cName );
+    vBenchReportLatency( "heap_malloc", cParameters, &xMallocSamples );
+
+    if( pxHeap->vFree != NULL )
+    {
+        vBenchReportLatency( "heap_free", cParameters, &xFreeSamples );
+    }
+
+    vBenchReportValues( "heap_fragmentation", cParameters, cValues );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    size_t xWorkload;
+    size_t xHeap;
+
+    ( void ) pvParameters;
+
+    vBenchReportBegin( "heap", ulOperations );
+
+    for( xWorkload = 0U; xWorkload < xWorkloadCount; xWorkload++ )
+    {
+        for( xHeap = 0U; xHeap < xBenchHeapCount; xHeap++ )
+        {
+            prvReplayWorkload( &( xBenchHeaps[ xHeap ] ), &( xWorkloads[ xWorkload ] ) );
+        }
+    }
+
+    vBenchReportEnd();
+
+    vTaskEndScheduler();
+
+    for( ; ; )
+    {
+        /* vTaskEndScheduler() does not return to a FreeRTOS task. */
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* The workloads are built before the scheduler is started, so can use the C
+ * library heap. */
+static HeapWorkload_t * prvNewWorkload( const char * pcName )
+{
+    HeapWorkload_t * pxWorkload;
+
+    if( xWorkloadCount >= benchMAX_WORKLOADS )
+    {
+        ( void ) fprintf( stderr, "too many workloads, at most %u can be run\n", ( unsigned ) benchMAX_WORKLOADS );
+        exit( 1 );
+    }
+
+    pxWorkload = &( xWorkloads[ xWorkloadCount ] );
+    xWorkloadCount++;
+
+    ( void ) snprintf( pxWorkload->cName, sizeof( pxWorkload->cName ), "%s", pcName );
+
+    return pxWorkload;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddOperation( HeapWorkload_t * pxWorkload,
+                             HeapOperationType_t eType,
+                             uint32_t ulSlot,
+                             uint32_t ulSize )
+{
+    HeapOperation_t * pxOperation;
+
+    if( pxWorkload->xOperationCount == pxWorkload->xOperationCapacity )
+    {
+        pxWorkload->xOperationCapacity = ( pxWorkload->xOperationCapacity == 0U ) ? 1024U : ( pxWorkload->xOperationCapacity * 2U );
+        pxWorkload->pxOperations = realloc( pxWorkload->pxOperations, pxWorkload->xOperationCapacity * sizeof( HeapOperation_t ) );
+
+        if( pxWorkload->pxOperations == NULL )
+        {
+            ( void ) fprintf( stderr, "out of memory building workload %s\n", pxWorkload->cName );
+            exit( 1 );
+        }
+    }
+
+    pxOperation = &( pxWorkload->pxOperations[ pxWorkload->xOperationCount ] );
+    pxOperation->ulSlot = ulSlot;
+    pxOperation->ulSize = ulSize;
+    pxOperation->ucType = ( uint8_t ) eType;
+    pxWorkload->xOperationCount++;
+
+    if( ulSlot >= pxWorkload->ulSlotCount )
+    {
+        pxWorkload->ulSlotCount = ulSlot + 1U;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* A random mix of allocations and frees of up to benchRANDOM_SLOTS blocks.
+ * The sizes are either uniformly distributed between ulMinSize and ulMaxSize
+ * or, if xLogarithmic is set, spread evenly over the powers of two between
+ * them, so small blocks are as common as large ones. */
+static void prvGenerateRandom( const char * pcName,
+                               uint32_t ulMinSize,
+                               uint32_t ulMaxSize,
+                               BaseType_t xLogarithmic )
+{
+    HeapWorkload_t * pxWorkload = prvNewWorkload( pcName );
+    uint8_t ucAllocated[ benchRANDOM_SLOTS ] = { 0 };
+    uint32_t ulSlot;
+    uint32_t ulSize;
+    uint32_t ulScales = 0U;
+
+    while( ( ulMinSize << ( ulScales + 1U ) ) <= ulMaxSize )
+    {
+        ulScales++;
+    }
+
+    vBenchRandomSeed( 0x4845u );
+
+    while( pxWorkload->xOperationCount < ulOperations )
+    {
+        ulSlot = ulBenchRandom() % benchRANDOM_SLOTS;
+
+        if( ucAllocated[ ulSlot ] != 0U )
+        {
+            prvAddOperation( pxWorkload, eHeapFree, ulSlot, 0U );
+            ucAllocated[ ulSlot ] = 0U;
+        }
+        else
+        {
+            if( xLogarithmic != pdFALSE )
+            {
+                ulSize = ulMinSize << ( ulBenchRandom() % ( ulScales + 1U ) );
+                ulSize += ulBenchRandom() % ulSize;
+
+                if( ulSize > ulMaxSize )
+                {
+                    ulSize = ulMaxSize;
+                }
+            }
+            else
+            {
+                ulSize = ulMinSize + ( ulBenchRandom() % ( ulMaxSize - ulMinSize + 1U ) );
+            }
+
+            prvAddOperation( pxWorkload, eHeapMalloc, ulSlot, ulSize );
+            ucAllocated[ ulSlot ] = 1U;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Each allocation frees the oldest block, as when messages are passed through
+ * a pipeline. */
+static void prvGenerateFifo( void )
+{
+    HeapWorkload_t * pxWorkload = prvNewWorkload( "fifo" );
+    uint32_t ulBlock;
+    uint32_t ulSlot;
+
+    vBenchRandomSeed( 0x4846u );
+
+    for( ulBlock = 0U; pxWorkload->xOperationCount < ulOperations; ulBlock++ )
+    {
+        ulSlot = ulBlock % benchFIFO_DEPTH;
+
+        if( ulBlock >= benchFIFO_DEPTH )
+        {
+            prvAddOperation( pxWorkload, eHeapFree, ulSlot, 0U );
+        }
+
+        prvAddOperation( pxWorkload, eHeapMalloc, ulSlot, 16U + ( ulBenchRandom() % 1009U ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Bursts of allocations followed by bursts of frees of the most recently
+ * allocated blocks, as when nested function calls allocate working memory. */
+static void prvGenerateLifo( void )
+{
+    HeapWorkload_t * pxWorkload = prvNewWorkload( "lifo" );
+    uint32_t ulDepth = 0U;
+    uint32_t ulBurst;
+
+    vBenchRandomSeed( 0x4847u );
+
+    while( pxWorkload->xOperationCount < ulOperations )
+    {
+        for( ulBurst = 1U + ( ulBenchRandom() % benchLIFO_MAX_BURST ); ( ulBurst > 0U ) && ( ulDepth < benchLIFO_DEPTH ); ulBurst-- )
+        {
+            prvAddOperation( pxWorkload, eHeapMalloc, ulDepth, 16U + ( ulBenchRandom() % 1009U ) );
+            ulDepth++;
+        }
+
+        for( ulBurst = 1U + ( ulBenchRandom() % benchLIFO_MAX_BURST ); ( ulBurst > 0U ) && ( ulDepth > 0U ); ulBurst-- )
+        {
+            ulDepth--;
+            prvAddOperation( pxWorkload, eHeapFree, ulDepth, 0U );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Leaves the free space as many holes too small for the allocations that
+ * follow.  The number of operations depends on the heap size, not on
+ * ulOperations. */
+static void prvGenerateFragmenter( void )
+{
+    HeapWorkload_t * pxWorkload = prvNewWorkload( "fragmenter" );
+    uint32_t ulBlock;
+
+    for( ulBlock = 0U; ulBlock < benchFRAGMENT_BLOCKS; ulBlock++ )
+    {
+        prvAddOperation( pxWorkload, eHeapMalloc, ulBlock, benchFRAGMENT_SMALL_BLOCK );
+    }
+
+    for( ulBlock = 0U; ulBlock < benchFRAGMENT_BLOCKS; ulBlock += 2U )
+    {
+        prvAddOperation( pxWorkload, eHeapFree, ulBlock, 0U );
+    }
+
+    for( ulBlock = 0U; ulBlock < ( benchFRAGMENT_BLOCKS / 2U ); ulBlock++ )
+    {
+        prvAddOperation( pxWorkload, eHeapMalloc, benchFRAGMENT_BLOCKS + ulBlock, benchFRAGMENT_LARGE_BLOCK );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Loads a recorded trace, one call per line:
+ *
+ *   malloc <address> <size>
+ *   free <address>
+ *
+ * Addresses are only used to pair each free with its allocation, and are
+ * mapped onto slots that are reused once the block is freed.  Allocations that
+ * returned NULL (address 0) are skipped, as are frees of blocks allocated
+ * before the trace started.  An allocation at the address of a block that is
+ * still allocated means the free of that block is missing from the trace, so a
+ * free is inserted for it. */
+static BaseType_t prvLoadTrace( const char * pcPath )
+{
+    HeapWorkload_t * pxWorkload;
+    FILE * pxFile;
+    const char * pcName;
+    char cLine[ benchMAX_LINE_LENGTH ];
+    char cCall[ 16 ];
+    char cAddress[ 32 ];
+    unsigned long ulSize;
+    unsigned long long * pullSlotAddresses = NULL;
+    uint32_t * pulFreeSlots = NULL;
+    uint32_t ulFreeSlotCount = 0U;
+    uint32_t ulSlotCount = 0U;
+    uint32_t ulSlot;
+    uint32_t ulLine = 0U;
+    uint32_t ulIgnored = 0U;
+    unsigned long long ullAddress;
+    int iFields;
+    BaseType_t xReturn = pdPASS;
+    char * pc;
+
+    pxFile = fopen( pcPath, "r" );
+
+    if( pxFile == NULL )
+    {
+        ( void ) fprintf( stderr, "cannot open trace %s\n", pcPath );
+        return pdFAIL;
+    }
+
+    /* Name the workload after the file, without characters that would need
+     * escaping in the JSON output. */
+    pcName = strrchr( pcPath, '/' );
+    pcName = ( pcName != NULL ) ? ( pcName + 1 ) : pcPath;
+    pxWorkload = prvNewWorkload( "" );
+    ( void ) snprintf( pxWorkload->cName, sizeof( pxWorkload->cName ), "trace:%s", pcName );
+
+    for( pc = pxWorkload->cName; *pc != '\0'; pc++ )
+    {
+        if( ( *pc == '"' ) || ( *pc == '\\' ) || ( ( unsigned char ) *pc < 0x20U ) )
+        {
+            *pc = '_';
+        }
+    }
+
+    while( ( xReturn == pdPASS ) && ( fgets( cLine, sizeof( cLine ), pxFile ) != NULL ) )
+    {
+        ulLine++;
+        iFields = sscanf( cLine, "%15s %31s %lu", cCall, cAddress, &ulSize );
+
+        if( ( iFields <= 0 ) || ( cCall[ 0 ] == '#' ) )
+        {
+            continue;
+        }
+
+        if( iFields < 2 )
+        {
+            xReturn = pdFAIL;
+            break;
+        }
+
+        ullAddress = strtoull( cAddress, &pc, 0 );
+
+        if( *pc != '\0' )
+        {
+            xReturn = pdFAIL;
+            break;
+        }
+
+        /* Find the slot of the block at this address, if it is allocated. */
+        for( ulSlot = 0U; ulSlot < ulSlotCount; ulSlot++ )
+        {
+            if( ( ullAddress != 0ULL ) && ( pullSlotAddresses[ ulSlot ] == ullAddress ) )
+            {
+                break;
+            }
+        }
+
+        if( ( strcmp( cCall, "malloc" ) == 0 ) && ( iFields == 3 ) )
+        {
+            if( ullAddress == 0ULL )
+            {
+                ulIgnored++;
+                continue;
+            }
+
+            if( ulSlot < ulSlotCount )
+            {
+                prvAddOperation( pxWorkload, eHeapFree, ulSlot, 0U );
+            }
+            else if( ulFreeSlotCount > 0U )
+            {
+                ulFreeSlotCount--;
+                ulSlot = pulFreeSlots[ ulFreeSlotCount ];
+            }
+            else
+            {
+                ulSlot = ulSlotCount;
+                ulSlotCount++;
+                pullSlotAddresses = realloc( pullSlotAddresses, ulSlotCount * sizeof( unsigned long long ) );
+                pulFreeSlots = realloc( pulFreeSlots, ulSlotCount * sizeof( uint32_t ) );
+
+                if( ( pullSlotAddresses == NULL ) || ( pulFreeSlots == NULL ) )
+                {
+                    ( void ) fprintf( stderr, "out of memory loading trace %s\n", pcPath );
+                    exit( 1 );
+                }
+            }
+
+            pullSlotAddresses[ ulSlot ] = ullAddress;
+            prvAddOperation( pxWorkload, eHeapMalloc, ulSlot, ( uint32_t ) ulSize );
+        }
+        else if( ( strcmp( cCall, "free" ) == 0 ) && ( iFields == 2 ) )
+        {
+            if( ulSlot < ulSlotCount )
+            {
+                prvAddOperation( pxWorkload, eHeapFree, ulSlot, 0U );
+                pullSlotAddresses[ ulSlot ] = 0ULL;
+                pulFreeSlots[ ulFreeSlotCount ] = ulSlot;
+                ulFreeSlotCount++;
+            }
+            else if( ullAddress != 0ULL )
+            {
+                ulIgnored++;
+            }
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+    }
+
+    if( xReturn == pdFAIL )
+    {
+        ( void ) fprintf( stderr, "%s:%lu: expected \"malloc <address> <size>\" or \"free <address>\"\n", pcPath, ( unsigned long ) ulLine );
+    }
+    else if( ulIgnored > 0U )
+    {
+        ( void ) fprintf( stderr, "%s: skipped %lu failed allocations and frees of blocks allocated before the trace started\n",
+                          pcPath, ( unsigned long ) ulIgnored );
+    }
+
+    ( void ) fclose( pxFile );
+    free( pullSlotAddresses );
+    free( pulFreeSlots );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    BaseType_t xResult;
+    uint32_t ulMaxSlots = 0U;
+    size_t x;
+    int iArgument;
+
+    for( iArgument = 1; iArgument < argc; iArgument++ )
+    {
+        if( ( strcmp( argv[ iArgument ], "--operations" ) == 0 ) && ( ( iArgument + 1 ) < argc ) )
+        {
+            iArgument++;
+            ulOperations = ( uint32_t ) strtoul( argv[ iArgument ], NULL, 0 );
+
+            if( ulOperations == 0U )
+            {
+                ( void ) fprintf( stderr, "usage: %s [--operations n] [trace files...]\n", argv[ 0 ] );
+                return 1;
+            }
+        }
+    }
+
+    prvGenerateRandom( "random_small", 16U, 256U, pdFALSE );
+    prvGenerateRandom( "random_mixed", 16U, 8192U, pdTRUE );
+    prvGenerateFifo();
+    prvGenerateLifo();
+    prvGenerateFragmenter();
+
+    for( iArgument = 1; iArgument < argc; iArgument++ )
+    {
+        if( strcmp( argv[ iArgument ], "--operations" ) == 0 )
+        {
+            iArgument++;
+        }
+        else if( prvLoadTrace( argv[ iArgument ] ) != pdPASS )
+        {
+            return 1;
+        }
+    }
+
+    for( x = 0U; x < xWorkloadCount; x++ )
+    {
+        if( xWorkloads[ x ].ulSlotCount > ulMaxSlots )
+        {
+            ulMaxSlots = xWorkloads[ x ].ulSlotCount;
+        }
+    }
+
+    ppvBlocks = calloc( ( ulMaxSlots > 0U ) ? ulMaxSlots : 1U, sizeof( void * ) );
+    configASSERT( ppvBlocks != NULL );
+
+    xResult = xTaskCreate( prvControlTask, "BenchCtrl", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, NULL );
+    configASSERT( xResult == pdPASS );
+    ( void ) xResult;
+
+    vTaskStartScheduler();
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,699 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Kernel microbenchmarks.  Measures context switch and wake up latencies,
+ * queue, stream buffer and message buffer throughput, timer command latency
+ * and the malloc/free latency of each heap implementation, and writes the
+ * results to stdout as JSON so they can be compared between commits.
+ *
+ * Usage: kernel_benchmark [iterations]
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+
+/* FreeRTOS includes. */
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+#include <timers.h>
+#include <stream_buffer.h>
+#include <message_buffer.h>
+
+#include "benchmark.h"
+#include "benchmark_heaps.h"
+
+/*-----------------------------------------------------------*/
+
+/* The control task runs below the timer task, so timer commands are processed
+ * as soon as they are sent, and above the workers, so it sees each worker
+ * finish as soon as it does. */
+#define benchCONTROL_PRIORITY       ( configMAX_PRIORITIES - 2 )
+#define benchWORKER_PRIORITY        ( tskIDLE_PRIORITY + 1 )
+
+#define benchDEFAULT_ITERATIONS     ( 10000U )
+#define benchMAX_ITEM_SIZE          ( 1024U )
+#define benchQUEUE_LENGTH           ( 16U )
+#define benchBUFFER_SIZE            ( 1024U )
+
+/* The heap workload keeps up to benchHEAP_SLOTS blocks of between
+ * benchHEAP_MIN_BLOCK and benchHEAP_MAX_BLOCK bytes allocated at once. */
+#define benchHEAP_SLOTS             ( 256U )
+#define benchHEAP_MIN_BLOCK         ( 16U )
+#define benchHEAP_MAX_BLOCK         ( 1024U )
+
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters );
+static void prvRunWorkers( TaskFunction_t pxWorkerA,
+                           TaskFunction_t pxWorkerB );
+static void prvWorkerFinished( void );
+
+static void prvBenchmarkClock( void );
+static void prvBenchmarkContextSwitch( void );
+static void prvBenchmarkSemaphore( void );
+static void prvBenchmarkMutex( void );
+static void prvBenchmarkNotification( void );
+static void prvBenchmarkQueue( size_t xItemSize );
+static void prvBenchmarkStreamBuffer( size_t xChunkSize );
+static void prvBenchmarkMessageBuffer( size_t xMessageSize );
+static void prvBenchmarkTimerCommands( void );
+static void prvBenchmarkHeap( const BenchHeap_t * pxHeap );
+
+/*-----------------------------------------------------------*/
+
+static uint32_t ulIterations = benchDEFAULT_ITERATIONS;
+
+static TaskHandle_t xControlTaskHandle = NULL;
+static TaskHandle_t xWorkerA = NULL;
+static TaskHandle_t xWorkerB = NULL;
+
+/* Latency samples, a second set for benchmarks that time two operations. */
+static BenchSamples_t xSamples;
+static BenchSamples_t xSecondSamples;
+
+/* State shared by the workers of the benchmark that is running. */
+static volatile uint64_t ullTimestampNs;
+static volatile uint64_t ullStartNs;
+static volatile uint64_t ullEndNs;
+static volatile uint32_t ulCompleted;
+static size_t xTransferSize;
+static QueueHandle_t xQueue;
+static SemaphoreHandle_t xPingSemaphore;
+static SemaphoreHandle_t xPongSemaphore;
+static SemaphoreHandle_t xMutex;
+static StreamBufferHandle_t xStreamBuffer;
+static uint8_t ucProducerBuffer[ benchMAX_ITEM_SIZE ];
+static uint8_t ucConsumerBuffer[ benchMAX_ITEM_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+static void prvWorkerFinished( void )
+{
+    xTaskNotifyGive( xControlTaskHandle );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Runs one or two workers at benchWORKER_PRIORITY and waits until each has
+ * called prvWorkerFinished(). */
+static void prvRunWorkers( TaskFunction_t pxWorkerA,
+                           TaskFunction_t pxWorkerB )
+{
+    uint32_t ulWorkers = 1U;
+    uint32_t ulFinished = 0U;
+    BaseType_t xResult;
+
+    ulCompleted = 0U;
+    ullTimestampNs = 0U;
+    xWorkerB = NULL;
+
+    xResult = xTaskCreate( pxWorkerA, "BenchA", configMINIMAL_STACK_SIZE, NULL, benchWORKER_PRIORITY, &xWorkerA );
+    configASSERT( xResult == pdPASS );
+
+    if( pxWorkerB != NULL )
+    {
+        xResult = xTaskCreate( pxWorkerB, "BenchB", configMINIMAL_STACK_SIZE, NULL, benchWORKER_PRIORITY, &xWorkerB );
+        configASSERT( xResult == pdPASS );
+        ulWorkers++;
+    }
+
+    ( void ) xResult;
+
+    while( ulFinished < ulWorkers )
+    {
+        ulFinished += ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+    }
+
+    vTaskDelete( xWorkerA );
+
+    if( xWorkerB != NULL )
+    {
+        vTaskDelete( xWorkerB );
+    }
+
+    /* Give the idle task the chance to free the deleted workers. */
+    vTaskDelay( 2 );
+}
+/*-----------------------------------------------------------*/
+
+/* The cost of reading the time, which is included in every latency below. */
+static void prvBenchmarkClock( void )
+{
+    uint32_t ulRound;
+    uint64_t ullCallNs;
+
+    vBenchSamplesReset( &xSamples );
+
+    for( ulRound = 0U; ulRound < ulIterations; ulRound++ )
+    {
+        ullCallNs = ullBenchNowNs();
+        vBenchSamplesAdd( &xSamples, ullBenchNowNs() - ullCallNs );
+    }
+
+    vBenchReportLatency( "clock_overhead", NULL, &xSamples );
+}
+/*-----------------------------------------------------------*/
+
+/* Both workers yield to each other; each sample is the time from one worker
+ * calling taskYIELD() to the other running. */
+static void prvYieldWorker( void * pvParameters )
+{
+    uint64_t ullNow;
+
+    ( void ) pvParameters;
+
+    while( ulCompleted < ulIterations )
+    {
+        ullNow = ullBenchNowNs();
+
+        if( ullTimestampNs != 0U )
+        {
+            vBenchSamplesAdd( &xSamples, ullNow - ullTimestampNs );
+            ulCompleted++;
+        }
+
+        ullTimestampNs = ullBenchNowNs();
+        taskYIELD();
+    }
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkContextSwitch( void )
+{
+    vBenchSamplesReset( &xSamples );
+    prvRunWorkers( prvYieldWorker, prvYieldWorker );
+    vBenchReportLatency( "context_switch", NULL, &xSamples );
+}
+/*-----------------------------------------------------------*/
+
+/* Ping gives a semaphore that pong is blocked on and then blocks on a second
+ * semaphore that pong gives back.  Each sample is the time from a give to
+ * the blocked task running. */
+static void prvSemaphorePingWorker( void * pvParameters )
+{
+    uint32_t ulRound;
+
+    ( void ) pvParameters;
+
+    for( ulRound = 0U; ulRound < ulIterations; ulRound++ )
+    {
+        ullTimestampNs = ullBenchNowNs();
+        ( void ) xSemaphoreGive( xPingSemaphore );
+        ( void ) xSemaphoreTake( xPongSemaphore, portMAX_DELAY );
+        vBenchSamplesAdd( &xSamples, ullBenchNowNs() - ullTimestampNs );
+    }
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphorePongWorker( void * pvParameters )
+{
+    uint32_t ulRound;
+
+    ( void ) pvParameters;
+
+    for( ulRound = 0U; ulRound < ulIterations; ulRound++ )
+    {
+        ( void ) xSemaphoreTake( xPingSemaphore, portMAX_DELAY );
+        vBenchSamplesAdd( &xSamples, ullBenchNowNs() - ullTimestampNs );
+        ullTimestampNs = ullBenchNowNs();
+        ( void ) xSemaphoreGive( xPongSemaphore );
+    }
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkSemaphore( void )
+{
+    xPingSemaphore = xSemaphoreCreateBinary();
+    xPongSemaphore = xSemaphoreCreateBinary();
+    configASSERT( ( xPingSemaphore != NULL ) && ( xPongSemaphore != NULL ) );
+
+    vBenchSamplesReset( &xSamples );
+    prvRunWorkers( prvSemaphorePingWorker, prvSemaphorePongWorker );
+    vBenchReportLatency( "semaphore_ping_pong", NULL, &xSamples );
+
+    vSemaphoreDelete( xPingSemaphore );
+    vSemaphoreDelete( xPongSemaphore );
+}
+/*-----------------------------------------------------------*/
+
+/* A single task takes and gives a mutex no other task uses; each sample is
+ * the time taken by the take and the give. */
+static void prvMutexWorker( void * pvParameters )
+{
+    uint32_t ulRound;
+    uint64_t ullCallNs;
+
+    ( void ) pvParameters;
+
+    for( ulRound = 0U; ulRound < ulIterations; ulRound++ )
+    {
+        ullCallNs = ullBenchNowNs();
+        ( void ) xSemaphoreTake( xMutex, portMAX_DELAY );
+        ( void ) xSemaphoreGive( xMutex );
+        vBenchSamplesAdd( &xSamples, ullBenchNowNs() - ullCallNs );
+    }
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkMutex( void )
+{
+    xMutex = xSemaphoreCreateMutex();
+    configASSERT( xMutex != NULL );
+
+    vBenchSamplesReset( &xSamples );
+    prvRunWorkers( prvMutexWorker, NULL );
+    vBenchReportLatency( "mutex_take_give", NULL, &xSamples );
+
+    vSemaphoreDelete( xMutex );
+}
+/*-----------------------------------------------------------*/
+
+/* As the semaphore ping-pong, but with direct to task notifications. */
+static void prvNotifyPingWorker( void * pvParameters )
+{
+    uint32_t ulRound;
+
+    ( void ) pvParameters;
+
+    for( ulRound = 0U; ulRound < ulIterations; ulRound++ )
+    {
+        ullTimestampNs = ullBenchNowNs();
+        xTaskNotifyGive( xWorkerB );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        vBenchSamplesAdd( &xSamples, ullBenchNowNs() - ullTimestampNs );
+    }
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyPongWorker( void * pvParameters )
+{
+    uint32_t ulRound;
+
+    ( void ) pvParameters;
+
+    for( ulRound = 0U; ulRound < ulIterations; ulRound++ )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        vBenchSamplesAdd( &xSamples, ullBenchNowNs() - ullTimestampNs );
+        ullTimestampNs = ullBenchNowNs();
+        xTaskNotifyGive( xWorkerA );
+    }
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkNotification( void )
+{
+    vBenchSamplesReset( &xSamples );
+    prvRunWorkers( prvNotifyPingWorker, prvNotifyPongWorker );
+    vBenchReportLatency( "task_notification_ping_pong", NULL, &xSamples );
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueProducer( void * pvParameters )
+{
+    uint32_t ulItem;
+
+    ( void ) pvParameters;
+
+    ullStartNs = ullBenchNowNs();
+
+    for( ulItem = 0U; ulItem < ulIterations; ulItem++ )
+    {
+        ( void ) xQueueSend( xQueue, ucProducerBuffer, portMAX_DELAY );
+    }
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueConsumer( void * pvParameters )
+{
+    uint32_t ulItem;
+
+    ( void ) pvParameters;
+
+    for( ulItem = 0U; ulItem < ulIterations; ulItem++ )
+    {
+        ( void ) xQueueReceive( xQueue, ucConsumerBuffer, portMAX_DELAY );
+    }
+
+    ullEndNs = ullBenchNowNs();
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkQueue( size_t xItemSize )
+{
+    char cParameters[ 32 ];
+
+    xQueue = xQueueCreate( benchQUEUE_LENGTH, ( UBaseType_t ) xItemSize );
+    configASSERT( xQueue != NULL );
+
+    prvRunWorkers( prvQueueProducer, prvQueueConsumer );
+
+    ( void ) snprintf( cParameters, sizeof( cParameters ), "\"item_size\": %lu", ( unsigned long ) xItemSize );
+    vBenchReportThroughput( "queue_throughput", cParameters, ulIterations, ( uint64_t ) ulIterations * xItemSize, ullEndNs - ullStartNs );
+
+    vQueueDelete( xQueue );
+}
+/*-----------------------------------------------------------*/
+
+/* Stream and message buffer workers - xTransferSize is the size of each
+ * write (and of each message). */
+static void prvBufferProducer( void * pvParameters )
+{
+    uint32_t ulWrite;
+
+    ( void ) pvParameters;
+
+    ullStartNs = ullBenchNowNs();
+
+    for( ulWrite = 0U; ulWrite < ulIterations; ulWrite++ )
+    {
+        ( void ) xStreamBufferSend( xStreamBuffer, ucProducerBuffer, xTransferSize, portMAX_DELAY );
+    }
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamBufferConsumer( void * pvParameters )
+{
+    uint64_t ullBytes = 0U;
+    const uint64_t ullTotalBytes = ( uint64_t ) ulIterations * xTransferSize;
+
+    ( void ) pvParameters;
+
+    while( ullBytes < ullTotalBytes )
+    {
+        ullBytes += xStreamBufferReceive( xStreamBuffer, ucConsumerBuffer, sizeof( ucConsumerBuffer ), portMAX_DELAY );
+    }
+
+    ullEndNs = ullBenchNowNs();
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMessageBufferConsumer( void * pvParameters )
+{
+    uint32_t ulMessage;
+
+    ( void ) pvParameters;
+
+    for( ulMessage = 0U; ulMessage < ulIterations; ulMessage++ )
+    {
+        ( void ) xMessageBufferReceive( xStreamBuffer, ucConsumerBuffer, sizeof( ucConsumerBuffer ), portMAX_DELAY );
+    }
+
+    ullEndNs = ullBenchNowNs();
+
+    prvWorkerFinished();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkStreamBuffer( size_t xChunkSize )
+{
+    char cParameters[ 32 ];
+
+    xStreamBuffer = xStreamBufferCreate( benchBUFFER_SIZE, 1U );
+    configASSERT( xStreamBuffer != NULL );
+    xTransferSize = xChunkSize;
+
+    prvRunWorkers( prvBufferProducer, prvStreamBufferConsumer );
+
+    ( void ) snprintf( cParameters, sizeof( cParameters ), "\"write_size\": %lu", ( unsigned long ) xChunkSize );
+    vBenchReportThroughput( "stream_buffer_throughput", cParameters, ulIterations, ( uint64_t ) ulIterations * xChunkSize, ullEndNs - ullStartNs );
+
+    vStreamBufferDelete( xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkMessageBuffer( size_t xMessageSize )
+{
+    char cParameters[ 32 ];
+
+    xStreamBuffer = xMessageBufferCreate( benchBUFFER_SIZE );
+    configASSERT( xStreamBuffer != NULL );
+    xTransferSize = xMessageSize;
+
+    /* xStreamBufferSend() writes a message when given a message buffer. */
+    prvRunWorkers( prvBufferProducer, prvMessageBufferConsumer );
+
+    ( void ) snprintf( cParameters, sizeof( cParameters ), "\"message_size\": %lu", ( unsigned long ) xMessageSize );
+    vBenchReportThroughput( "message_buffer_throughput", cParameters, ulIterations, ( uint64_t ) ulIterations * xMessageSize, ullEndNs - ullStartNs );
+
+    vMessageBufferDelete( xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPendedFunction( void * pvParameter1,
+                               uint32_t ulParameter2 )
+{
+    ( void ) pvParameter1;
+    ( void ) ulParameter2;
+
+    vBenchSamplesAdd( &xSamples, ullBenchNowNs() - ullTimestampNs );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+}
+/*-----------------------------------------------------------*/
+
+/* Run from the control task, which the timer task preempts as soon as a
+ * command is sent.  The pended function latency is the time from sending the
+ * command to the function running in the timer task; the reset latency is
+ * the time xTimerReset() takes to return, including the timer task
+ * processing the command. */
+static void prvBenchmarkTimerCommands( void )
+{
+    TimerHandle_t xTimer;
+    uint32_t ulRound;
+    uint64_t ullCallNs;
+
+    vBenchSamplesReset( &xSamples );
+
+    for( ulRound = 0U; ulRound < ulIterations; ulRound++ )
+    {
+        ullTimestampNs = ullBenchNowNs();
+        ( void ) xTimerPendFunctionCall( prvPendedFunction, NULL, 0U, portMAX_DELAY );
+    }
+
+    vBenchReportLatency( "timer_pend_function_call", NULL, &xSamples );
+
+    xTimer = xTimerCreate( "Bench", pdMS_TO_TICKS( 1000U ), pdFALSE, NULL, prvTimerCallback );
+    configASSERT( xTimer != NULL );
+
+    vBenchSamplesReset( &xSamples );
+
+    for( ulRound = 0U; ulRound < ulIterations; ulRound++ )
+    {
+        ullCallNs = ullBenchNowNs();
+        ( void ) xTimerReset( xTimer, portMAX_DELAY );
+        vBenchSamplesAdd( &xSamples, ullBenchNowNs() - ullCallNs );
+    }
+
+    vBenchReportLatency( "timer_reset_command", NULL, &xSamples );
+
+    ( void ) xTimerDelete( xTimer, portMAX_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+/* A random mix of allocations and frees, keeping up to benchHEAP_SLOTS blocks
+ * allocated.  heap_1 cannot free, so its blocks are abandoned instead and the
+ * heap is reset whenever it runs out. */
+static void prvBenchmarkHeap( const BenchHeap_t * pxHeap )
+{
+    static void * pvBlocks[ benchHEAP_SLOTS ];
+    char cParameters[ 64 ];
+    uint32_t ulOperation;
+    uint32_t ulFailures = 0U;
+    uint32_t ulSlot;
+    size_t xSize;
+    uint64_t ullCallNs;
+
+    pxHeap->vReset();
+    vBenchRandomSeed( 0x4845u );
+    vBenchSamplesReset( &xSamples );
+    vBenchSamplesReset( &xSecondSamples );
+
+    for( ulSlot = 0U; ulSlot < benchHEAP_SLOTS; ulSlot++ )
+    {
+        pvBlocks[ ulSlot ] = NULL;
+    }
+
+    for( ulOperation = 0U; ulOperation < ulIterations; ulOperation++ )
+    {
+        ulSlot = ulBenchRandom() % benchHEAP_SLOTS;
+
+        if( pvBlocks[ ulSlot ] != NULL )
+        {
+            if( pxHeap->vFree != NULL )
+            {
+                ullCallNs = ullBenchNowNs();
+                pxHeap->vFree( pvBlocks[ ulSlot ] );
+                vBenchSamplesAdd( &xSecondSamples, ullBenchNowNs() - ullCallNs );
+            }
+
+            pvBlocks[ ulSlot ] = NULL;
+        }
+        else
+        {
+            xSize = benchHEAP_MIN_BLOCK + ( ulBenchRandom() % ( benchHEAP_MAX_BLOCK - benchHEAP_MIN_BLOCK + 1U ) );
+
+            ullCallNs = ullBenchNowNs();
+            pvBlocks[ ulSlot ] = pxHeap->pvMalloc( xSize );
+            vBenchSamplesAdd( &xSamples, ullBenchNowNs() - ullCallNs );
+
+            if( pvBlocks[ ulSlot ] == NULL )
+            {
+                ulFailures++;
+
+                if( pxHeap->vFree == NULL )
+                {
+                    pxHeap->vReset();
+                }
+            }
+        }
+    }
+
+    if( pxHeap->vFree != NULL )
+    {
+        for( ulSlot = 0U; ulSlot < benchHEAP_SLOTS; ulSlot++ )
+        {
+            pxHeap->vFree( pvBlocks[ ulSlot ] );
+        }
+    }
+
+    pxHeap->vReset();
+
+    ( void ) snprintf( cParameters, sizeof( cParameters ), "\"heap\": \"%s\", \"failures\": %lu", pxHeap->pcName, ( unsigned long ) ulFailures );
+    vBenchReportLatency( "heap_malloc", cParameters, &xSamples );
+
+    if( pxHeap->vFree != NULL )
+    {
+        ( void ) snprintf( cParameters, sizeof( cParameters ), "\"heap\": \"%s\"", pxHeap->pcName );
+        vBenchReportLatency( "heap_free", cParameters, &xSecondSamples );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    static const size_t xItemSizes[] = { 4U, 16U, 64U, 256U, 1024U };
+    static const size_t xWriteSizes[] = { 16U, 64U, 256U };
+    size_t x;
+
+    ( void ) pvParameters;
+
+    vBenchReportBegin( "kernel", ulIterations );
+
+    prvBenchmarkClock();
+    prvBenchmarkContextSwitch();
+    prvBenchmarkSemaphore();
+    prvBenchmarkMutex();
+    prvBenchmarkNotification();
+
+    for( x = 0U; x < ( sizeof( xItemSizes ) / sizeof( xItemSizes[ 0 ] ) ); x++ )
+    {
+        prvBenchmarkQueue( xItemSizes[ x ] );
+    }
+
+    for( x = 0U; x < ( sizeof( xWriteSizes ) / sizeof( xWriteSizes[ 0 ] ) ); x++ )
+    {
+        prvBenchmarkStreamBuffer( xWriteSizes[ x ] );
+    }
+
+    for( x = 0U; x < ( sizeof( xWriteSizes ) / sizeof( xWriteSizes[ 0 ] ) ); x++ )
+    {
+        prvBenchmarkMessageBuffer( xWriteSizes[ x ] );
+    }
+
+    prvBenchmarkTimerCommands();
+
+    for( x = 0U; x < xBenchHeapCount; x++ )
+    {
+        prvBenchmarkHeap( &( xBenchHeaps[ x ] ) );
+    }
+
+    vBenchReportEnd();
+
+    vTaskEndScheduler();
+
+    for( ; ; )
+    {
+        /* vTaskEndScheduler() does not return to a FreeRTOS task. */
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    BaseType_t xResult;
+
+    if( argc > 1 )
+    {
+        ulIterations = ( uint32_t ) strtoul( argv[ 1 ], NULL, 0 );
+
+        if( ulIterations == 0U )
+        {
+            ( void ) fprintf( stderr, "usage: %s [iterations]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    xResult = xTaskCreate( prvControlTask, "BenchCtrl", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, &xControlTaskHandle );
+    configASSERT( xResult == pdPASS );
+    ( void ) xResult;
+
+    vTaskStartScheduler();
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
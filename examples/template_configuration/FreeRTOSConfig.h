@@ -91,6 +91,14 @@
  * https://freertos.org/single-core-amp-smp-rtos-scheduling.html. */
 #define configUSE_TIME_SLICING                     0
 
+/* Set configUSE_PER_TASK_TIME_SLICE to 1 to let each task specify, using
+ * vTaskSetTimeSlice(), how many ticks it may run before the scheduler switches
+ * to another Ready state task of equal priority.  New tasks start with a time
+ * slice of configTASK_DEFAULT_TIME_SLICE_TICKS ticks.  Requires both
+ * configUSE_PREEMPTION and configUSE_TIME_SLICING to be set to 1.  Defaults to
+ * 0 if left undefined. */
+#define configUSE_PER_TASK_TIME_SLICE              0
+
 /* Set configUSE_PORT_OPTIMISED_TASK_SELECTION to 1 to select the next task to
  * run using an algorithm optimised to the instruction set of the target
  * hardware - normally using a count leading zeros assembly instruction.  Set to
@@ -375,6 +383,32 @@
  */
 #define configGENERATE_RUN_TIME_STATS           0
 
+/* The run time counter provided by the application is commonly 32 bits wide,
+ * so wraps after 71 minutes when clocked at 1MHz.  Set
+ * configUSE_EXTENDED_RUN_TIME_COUNTER to 1, and configRUN_TIME_COUNTER_TYPE to
+ * uint64_t, to have the kernel accumulate the time elapsed between reads of the
+ * application's counter into configRUN_TIME_COUNTER_TYPE wide counters that do
+ * not wrap.  configRUN_TIME_PORT_COUNTER_TYPE is the type of the application's
+ * counter and defaults to uint32_t.  Defaults to 0 if left undefined. */
+#define configUSE_EXTENDED_RUN_TIME_COUNTER     0
+
+/* Set configGENERATE_CONTEXT_SWITCH_STATS to 1 to have FreeRTOS count how many
+ * times each task is switched in, how many times it is switched out while it
+ * is still able to run (preempted or yielded), how many times it is switched
+ * out because it blocked, and, in SMP builds, how many times it moved between
+ * cores.  The counts are reported by vTaskGetInfo() and uxTaskGetSystemState()
+ * so configUSE_TRACE_FACILITY must also be 1.  Defaults to 0 if left
+ * undefined. */
+#define configGENERATE_CONTEXT_SWITCH_STATS     0
+
+/* Set configUSE_TRACE_RECORDER to 1 to record scheduling, queue, notification
+ * and heap events into a per-core binary ring buffer (freertos_trace.c) that
+ * can be decoded into a timeline with tools/freertos_trace_decode.py.
+ * configTRACE_RECORDER_EVENTS_PER_CORE sets the ring length (a power of 2) and
+ * configTRACE_RECORDER_TIMESTAMP() the event time stamp, which defaults to
+ * portGET_RUN_TIME_COUNTER_VALUE().  Defaults to 0 if left undefined. */
+#define configUSE_TRACE_RECORDER                0
+
 /* Set configUSE_TRACE_FACILITY to include additional task structure members
  * are used by trace and visualisation functions and tools.  Set to 0 to exclude
  * the additional information from the structures. Defaults to 0 if left
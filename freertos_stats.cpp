@@ -1,5 +1,8 @@
 #include "freertos_stats.hpp"
 #include "freertos_mpool.h"             // for MemPool_t definition
+#include "timers.h"                     // for the task load sampler timer
+#include <cstdio>
+#include <cstring>
 
 void PrintFreeRtosHeapStats()
 {
@@ -8,7 +11,7 @@ void PrintFreeRtosHeapStats()
     vPortGetHeapStats(&heapStats);
 
     Dc_printf("\r\nFreeRTOS Heap Statistics:\r\n");
-    Dc_printf("|%-10s|%-10s|%-12s|%-12s|%-12s|%-12s|%-12s|%-10s|\r\n",
+    Dc_printf("|%-10s|%-10s|%-12s|%-12s|%-12s|%-12s|%-12s|%-10s|%-12s|%-12s|\r\n",
         "TotSize",
         "FreeSize",
         "MinimumEver",
@@ -16,9 +19,11 @@ void PrintFreeRtosHeapStats()
         "MinFreeBlkSz",
         "NumFreeBlks",
         "SucAllocs",
-        "SucFrees"
+        "SucFrees",
+        "InPlaceRealc",
+        "MovedRealc"
     );
-    Dc_printf("|%-10u|%-10u|%-12u|%-12u|%-12u|%-12u|%-12u|%-10u|\r\n",
+    Dc_printf("|%-10u|%-10u|%-12u|%-12u|%-12u|%-12u|%-12u|%-10u|%-12u|%-12u|\r\n",
         configTOTAL_HEAP_SIZE,
         heapStats.xAvailableHeapSpaceInBytes,
         heapStats.xMinimumEverFreeBytesRemaining,
@@ -26,10 +31,236 @@ void PrintFreeRtosHeapStats()
         heapStats.xSizeOfSmallestFreeBlockInBytes,
         heapStats.xNumberOfFreeBlocks,
         heapStats.xNumberOfSuccessfulAllocations,
-        heapStats.xNumberOfSuccessfulFrees
+        heapStats.xNumberOfSuccessfulFrees,
+        heapStats.xNumberOfInPlaceReallocations,
+        heapStats.xNumberOfMovedReallocations
     );
 }
 
+/* Maximum number of tasks held in the statically allocated per-task tables of this file. */
+#ifndef STATS_MAX_TRACKED_TASKS
+    #define STATS_MAX_TRACKED_TASKS     ( 32U )
+#endif
+
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+
+/* Maximum number of owner tasks and call sites PrintHeapAllocationStats() reports, the blocks of any others
+ * are added up in a final "(other)" row. */
+#ifndef STATS_MAX_HEAP_OWNERS
+    #define STATS_MAX_HEAP_OWNERS       ( STATS_MAX_TRACKED_TASKS )
+#endif
+
+#ifndef STATS_MAX_HEAP_SITES
+    #define STATS_MAX_HEAP_SITES        ( 32U )
+#endif
+
+namespace
+{
+    struct HeapUsage
+    {
+        const void * key;       /* Owner task handle or call site address. */
+        size_t blocks;
+        size_t bytes;
+        TickType_t maxAge;      /* Age of the oldest block still allocated, in ticks. */
+    };
+
+    struct HeapUsageTable
+    {
+        HeapUsage * rows;
+        UBaseType_t maxRows;
+        UBaseType_t numRows;
+        HeapUsage other;
+    };
+
+    /* Filled by the heap walk, which runs with the scheduler suspended, so the tables are statically allocated. */
+    HeapUsage s_heapOwnerRows[ STATS_MAX_HEAP_OWNERS ];
+    HeapUsage s_heapSiteRows[ STATS_MAX_HEAP_SITES ];
+    HeapUsageTable s_heapOwners = { s_heapOwnerRows, STATS_MAX_HEAP_OWNERS, 0, { NULL, 0, 0, 0 } };
+    HeapUsageTable s_heapSites = { s_heapSiteRows, STATS_MAX_HEAP_SITES, 0, { NULL, 0, 0, 0 } };
+    TickType_t s_heapWalkTime = 0;
+
+    void AddHeapUsage( HeapUsageTable & table, const void * key, const HeapAllocation_t * pxAllocation )
+    {
+        HeapUsage * usage = &table.other;
+        for ( UBaseType_t i = 0; i < table.numRows; i++ )
+        {
+            if ( table.rows[i].key == key )
+            {
+                usage = &table.rows[i];
+                break;
+            }
+        }
+        if ( usage == &table.other && table.numRows < table.maxRows )
+        {
+            usage = &table.rows[ table.numRows++ ];
+            usage->key = key;
+            usage->blocks = 0;
+            usage->bytes = 0;
+            usage->maxAge = 0;
+        }
+
+        TickType_t age = s_heapWalkTime - pxAllocation->xTimestamp;
+        usage->blocks++;
+        usage->bytes += pxAllocation->xBlockSize;
+        usage->maxAge = ( age > usage->maxAge ) ? age : usage->maxAge;
+    }
+
+    BaseType_t SummariseHeapAllocation( const HeapAllocation_t * pxAllocation, void * pvContext )
+    {
+        ( void ) pvContext;
+        AddHeapUsage( s_heapOwners, pxAllocation->xOwner, pxAllocation );
+        AddHeapUsage( s_heapSites, pxAllocation->pvCaller, pxAllocation );
+        return pdTRUE;
+    }
+
+    void SortHeapUsage( HeapUsageTable & table )
+    {
+        for ( UBaseType_t i = 1; i < table.numRows; i++ )
+        {
+            HeapUsage usage = table.rows[i];
+            UBaseType_t j = i;
+            for ( ; j > 0 && table.rows[j - 1].bytes < usage.bytes; j-- )
+            {
+                table.rows[j] = table.rows[j - 1];
+            }
+            table.rows[j] = usage;
+        }
+    }
+
+    void ResetHeapUsage( HeapUsageTable & table )
+    {
+        table.numRows = 0;
+        table.other.blocks = 0;
+        table.other.bytes = 0;
+        table.other.maxAge = 0;
+    }
+}
+
+void PrintHeapAllocationStats()
+{
+    ResetHeapUsage( s_heapOwners );
+    ResetHeapUsage( s_heapSites );
+    s_heapWalkTime = xTaskGetTickCount();
+    UBaseType_t numBlocks = uxPortWalkHeapAllocations( SummariseHeapAllocation, NULL );
+
+    SortHeapUsage( s_heapOwners );
+    SortHeapUsage( s_heapSites );
+
+    /* Owners are only known by their handle, so the names are looked up in a snapshot of the tasks that still
+     * exist, taken after the walk so it is not itself counted. */
+    UBaseType_t numTasks = uxTaskGetNumberOfTasks();
+    TaskStatus_t * pxTaskStatusArray = static_cast<TaskStatus_t*>( pvPortMalloc( numTasks * sizeof( TaskStatus_t ) ) );
+    if ( pxTaskStatusArray != NULL )
+    {
+        numTasks = uxTaskGetSystemState( pxTaskStatusArray, numTasks, NULL );
+    }
+
+    Dc_printf("\r\nHeap Allocation Statistics (%u live blocks):\r\n", numBlocks);
+    Dc_printf("|%-16s|%-10s|%-12s|%-16s|\r\n", "Owner", "Blocks", "Bytes", "OldestAge(ms)");
+    for ( UBaseType_t i = 0; i <= s_heapOwners.numRows; i++ )
+    {
+        const HeapUsage & usage = ( i < s_heapOwners.numRows ) ? s_heapOwners.rows[i] : s_heapOwners.other;
+        const char * name = ( i < s_heapOwners.numRows ) ? "(deleted)" : "(other)";
+
+        if ( i == s_heapOwners.numRows && usage.blocks == 0 )
+        {
+            break;
+        }
+        if ( i < s_heapOwners.numRows && usage.key == NULL )
+        {
+            name = "(startup)";
+        }
+        for ( UBaseType_t t = 0; pxTaskStatusArray != NULL && i < s_heapOwners.numRows && t < numTasks; t++ )
+        {
+            if ( pxTaskStatusArray[t].xHandle == usage.key )
+            {
+                name = pxTaskStatusArray[t].pcTaskName;
+                break;
+            }
+        }
+
+        Dc_printf("|%-16s|%-10u|%-12u|%-16lu|\r\n",
+            name,
+            usage.blocks,
+            usage.bytes,
+            static_cast<unsigned long>( usage.maxAge * portTICK_PERIOD_MS )
+        );
+    }
+
+    Dc_printf("|%-16s|%-10s|%-12s|%-16s|\r\n", "CallSite", "Blocks", "Bytes", "OldestAge(ms)");
+    for ( UBaseType_t i = 0; i <= s_heapSites.numRows; i++ )
+    {
+        const HeapUsage & usage = ( i < s_heapSites.numRows ) ? s_heapSites.rows[i] : s_heapSites.other;
+        char site[ 20 ];
+
+        if ( i == s_heapSites.numRows && usage.blocks == 0 )
+        {
+            break;
+        }
+        if ( i < s_heapSites.numRows )
+        {
+            snprintf( site, sizeof( site ), "0x%08lx", static_cast<unsigned long>( reinterpret_cast<uintptr_t>( usage.key ) ) );
+        }
+        else
+        {
+            snprintf( site, sizeof( site ), "(other)" );
+        }
+
+        Dc_printf("|%-16s|%-10u|%-12u|%-16lu|\r\n",
+            site,
+            usage.blocks,
+            usage.bytes,
+            static_cast<unsigned long>( usage.maxAge * portTICK_PERIOD_MS )
+        );
+    }
+
+    vPortFree( pxTaskStatusArray );
+}
+
+#endif /* configHEAP_TRACK_ALLOCATIONS */
+
+namespace
+{
+    struct TaskRunTimeSnapshot
+    {
+        UBaseType_t xTaskNumber;
+        configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;
+    };
+
+    /* The run time of the tasks at the previous call to PrintTaskStats(), so the load can be reported over the
+     * interval since that call rather than since boot. */
+    TaskRunTimeSnapshot s_prevTaskRunTime[ STATS_MAX_TRACKED_TASKS ];
+    UBaseType_t s_numPrevTaskRunTime = 0;
+    bool s_prevTaskRunTimeValid = true;     /* False if the previous call could not record every task. */
+    configRUN_TIME_COUNTER_TYPE s_prevTotRunTimeCounter = 0;
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+    configRUN_TIME_COUNTER_TYPE s_prevCoreRunTime[ configNUMBER_OF_CORES ];
+    configRUN_TIME_COUNTER_TYPE s_prevCoreIdleTime[ configNUMBER_OF_CORES ];
+#endif
+
+    /* Returns false if the run time of the task at the previous call is not known. */
+    bool PrevTaskRunTime( UBaseType_t xTaskNumber, configRUN_TIME_COUNTER_TYPE & runTime )
+    {
+        for ( UBaseType_t i = 0; i < s_numPrevTaskRunTime; i++ )
+        {
+            if ( s_prevTaskRunTime[i].xTaskNumber == xTaskNumber )
+            {
+                runTime = s_prevTaskRunTime[i].ulRunTimeCounter;
+                return true;
+            }
+        }
+        /* A task created since the previous call has run for its whole lifetime in this window, provided the
+         * previous call recorded every task that existed then. */
+        runTime = 0;
+        return s_prevTaskRunTimeValid;
+    }
+
+    double Percent( configRUN_TIME_COUNTER_TYPE part, configRUN_TIME_COUNTER_TYPE whole )
+    {
+        return (whole == 0) ? 0.0 : static_cast<double>(part) / static_cast<double>(whole) * 100.0;
+    }
+}
+
 void PrintTaskStats()
 {
     TaskStatus_t * pxTaskStatusArray;
@@ -42,23 +273,74 @@ void PrintTaskStats()
         configRUN_TIME_COUNTER_TYPE totRunTimeCounter = 0;
         numRecordedTasks = uxTaskGetSystemState( pxTaskStatusArray, numTasks, &totRunTimeCounter );
 
-        /* TODO: newlib nano printf does not support uint64_t and consumes large stack size, consider
-         * substitute it with nanoprintf */
+        /* Loads are reported over the window since the previous call, the first call covers the time since boot. */
+        configRUN_TIME_COUNTER_TYPE windowRunTime = totRunTimeCounter - s_prevTotRunTimeCounter;
+        s_prevTotRunTimeCounter = totRunTimeCounter;
+
+        /* NOTE: newlib nano printf does not support uint64_t and consumes large stack size, so the counters,
+         * which are 64-bit when configUSE_EXTENDED_RUN_TIME_COUNTER is 1, are printed in ms as unsigned long. */
         Dc_printf("\r\nTask Statistics:\r\n");
-        Dc_printf("Total Run Time: %lu us\r\n", totRunTimeCounter);
-        Dc_printf("|%-16s|%-8s|%-10s|%-12s|%-18s|%-10s|%-10s|%-16s|\r\n",
+        Dc_printf("Total Run Time: %lu ms, Window: %lu ms\r\n",
+            static_cast<unsigned long>(totRunTimeCounter / 1000U),
+            static_cast<unsigned long>(windowRunTime / 1000U)
+        );
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+        Dc_printf("|%-6s|%-10s|%-10s|\r\n", "Core", "Load(%)", "Idle(%)");
+        for ( BaseType_t core = 0; core < configNUMBER_OF_CORES; core++ )
+        {
+            configRUN_TIME_COUNTER_TYPE coreRunTime = ulTaskGetCoreRunTimeCounter( core );
+            configRUN_TIME_COUNTER_TYPE coreIdleTime = ulTaskGetCoreIdleRunTimeCounter( core );
+            configRUN_TIME_COUNTER_TYPE windowCoreRunTime = coreRunTime - s_prevCoreRunTime[core];
+            configRUN_TIME_COUNTER_TYPE windowCoreIdleTime = coreIdleTime - s_prevCoreIdleTime[core];
+            s_prevCoreRunTime[core] = coreRunTime;
+            s_prevCoreIdleTime[core] = coreIdleTime;
+
+            Dc_printf("|%-6ld|%-10.2f|%-10.2f|\r\n",
+                static_cast<long>(core),
+                100.0 - Percent(windowCoreIdleTime, windowCoreRunTime),
+                Percent(windowCoreIdleTime, windowCoreRunTime)
+            );
+        }
+#endif
+
+        Dc_printf("|%-16s|%-8s|%-10s|%-12s|%-18s|%-10s|%-10s|%-16s|",
             "Name",
             "State",
             "Priority",
             "BasePriority",
-            "RunTime(us)",
-            "(%)",
+            "RunTime(ms)",
+            "Load(%)",
             "StackSize",
             "EverMinFreeStack"
         );
+#if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+        Dc_printf("%-10s|%-10s|%-10s|",
+            "SwitchIns",
+            "Preempted",
+            "Blocked"
+        );
+    #if ( configNUMBER_OF_CORES > 1 )
+        Dc_printf("%-10s|", "Migrations");
+    #endif
+#endif
+        Dc_printf("\r\n");
         for ( UBaseType_t i = 0; i < numRecordedTasks; i++ )
         {
-            Dc_printf("|%-16s|%-8s|%-10u|%-12u|%-18lu|%-10.2f|%-10u|%-16u|\r\n",
+            configRUN_TIME_COUNTER_TYPE prevTaskRunTime;
+            char load[ 12 ];
+
+            if ( PrevTaskRunTime( pxTaskStatusArray[i].xTaskNumber, prevTaskRunTime ) )
+            {
+                snprintf( load, sizeof( load ), "%.2f",
+                          Percent( pxTaskStatusArray[i].ulRunTimeCounter - prevTaskRunTime, windowRunTime * configNUMBER_OF_CORES ) );
+            }
+            else
+            {
+                snprintf( load, sizeof( load ), "-" );
+            }
+
+            Dc_printf("|%-16s|%-8s|%-10u|%-12u|%-18lu|%-10s|%-10u|%-16u|",
                 pxTaskStatusArray[i].pcTaskName,
                 (pxTaskStatusArray[i].eCurrentState == eRunning) ? "Running" :
                 (pxTaskStatusArray[i].eCurrentState == eReady) ? "Ready" :
@@ -66,17 +348,347 @@ void PrintTaskStats()
                 (pxTaskStatusArray[i].eCurrentState == eSuspended) ? "Suspended" : "Deleted",
                 pxTaskStatusArray[i].uxCurrentPriority,
                 pxTaskStatusArray[i].uxBasePriority,
-                pxTaskStatusArray[i].ulRunTimeCounter,
-                static_cast<double>(pxTaskStatusArray[i].ulRunTimeCounter) / static_cast<double>(totRunTimeCounter) * 100.0f,
+                static_cast<unsigned long>(pxTaskStatusArray[i].ulRunTimeCounter / 1000U),
+                load,
                 (pxTaskStatusArray[i].pxEndOfStack - pxTaskStatusArray[i].pxStackBase + 1) * sizeof(StackType_t),
                 pxTaskStatusArray[i].usStackHighWaterMark * sizeof(StackType_t)
             );
+#if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+            Dc_printf("%-10u|%-10u|%-10u|",
+                pxTaskStatusArray[i].uxSwitchInCount,
+                pxTaskStatusArray[i].uxPreemptedCount,
+                pxTaskStatusArray[i].uxBlockedCount
+            );
+    #if ( configNUMBER_OF_CORES > 1 )
+            Dc_printf("%-10u|", pxTaskStatusArray[i].uxMigrationCount);
+    #endif
+#endif
+            Dc_printf("\r\n");
+        }
+
+        /* The tasks past the first STATS_MAX_TRACKED_TASKS are shown without a load by the next call.
+         * numRecordedTasks is 0 if tasks were created since uxTaskGetNumberOfTasks() was called. */
+        s_prevTaskRunTimeValid = ( numRecordedTasks > 0 ) && ( numRecordedTasks <= STATS_MAX_TRACKED_TASKS );
+        s_numPrevTaskRunTime = ( numRecordedTasks < STATS_MAX_TRACKED_TASKS ) ? numRecordedTasks : STATS_MAX_TRACKED_TASKS;
+        for ( UBaseType_t i = 0; i < s_numPrevTaskRunTime; i++ )
+        {
+            s_prevTaskRunTime[i].xTaskNumber = pxTaskStatusArray[i].xTaskNumber;
+            s_prevTaskRunTime[i].ulRunTimeCounter = pxTaskStatusArray[i].ulRunTimeCounter;
         }
 
         vPortFree( pxTaskStatusArray );
     }
 }
 
+/* Period of the task load sampler, every window reported by PrintTaskLoadStats() is a whole number of periods. */
+#ifndef STATS_SAMPLE_PERIOD_MS
+    #define STATS_SAMPLE_PERIOD_MS      ( 1000U )
+#endif
+
+/* Number of samples kept per task, enough to cover the longest reported window. */
+#define STATS_SAMPLE_HISTORY            ( 60000U / STATS_SAMPLE_PERIOD_MS )
+
+/* Loads are stored in units of 0.01% to keep the history of each task small. */
+#define STATS_LOAD_FULL_SCALE           ( 10000U )
+
+namespace
+{
+    struct TaskLoadHistory
+    {
+        bool inUse;
+        bool seen;
+        UBaseType_t xTaskNumber;
+        char name[ configMAX_TASK_NAME_LEN ];
+        configRUN_TIME_COUNTER_TYPE ulLastRunTimeCounter;
+        UBaseType_t numValid;           /* Number of valid loads, saturates at STATS_SAMPLE_HISTORY. */
+        uint16_t load[ STATS_SAMPLE_HISTORY ];
+    };
+
+    struct LoadWindow
+    {
+        uint16_t avg;
+        uint16_t min;
+        uint16_t max;
+    };
+
+    /* All the sampler state is statically allocated so sampling and printing never touch the heap. */
+    TaskStatus_t s_sampleTaskStatus[ STATS_MAX_TRACKED_TASKS ];
+    TaskLoadHistory s_taskLoad[ STATS_MAX_TRACKED_TASKS ];
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+    uint16_t s_coreLoad[ configNUMBER_OF_CORES ][ STATS_SAMPLE_HISTORY ];
+    configRUN_TIME_COUNTER_TYPE s_sampleLastCoreRunTime[ configNUMBER_OF_CORES ];
+    configRUN_TIME_COUNTER_TYPE s_sampleLastCoreIdleTime[ configNUMBER_OF_CORES ];
+#endif
+    UBaseType_t s_sampleHead = 0;       /* Index the next sample is written to. */
+    UBaseType_t s_numSamples = 0;       /* Number of valid core samples, saturates at STATS_SAMPLE_HISTORY. */
+    UBaseType_t s_numUntrackedTasks = 0;    /* Number of tasks at the last sample if there were too many to sample. */
+    TimerHandle_t s_samplerTimer = NULL;
+
+    uint16_t ToLoad( configRUN_TIME_COUNTER_TYPE part, configRUN_TIME_COUNTER_TYPE whole )
+    {
+        if ( whole == 0 )
+        {
+            return 0;
+        }
+        /* Widened first, part * STATS_LOAD_FULL_SCALE overflows a 32-bit counter above about 430000 counts. */
+        uint64_t load = ( static_cast<uint64_t>( part ) * STATS_LOAD_FULL_SCALE ) / whole;
+        return static_cast<uint16_t>( ( load > STATS_LOAD_FULL_SCALE ) ? STATS_LOAD_FULL_SCALE : load );
+    }
+
+    /* Computes the load over the last windowMs of a copy of a history ring whose next write index was head. */
+    LoadWindow LoadOverWindow( const uint16_t * history, UBaseType_t head, UBaseType_t numValid, uint32_t windowMs )
+    {
+        UBaseType_t numSamples = windowMs / STATS_SAMPLE_PERIOD_MS;
+        if ( numSamples == 0 )
+        {
+            numSamples = 1;
+        }
+        if ( numSamples > numValid )
+        {
+            numSamples = numValid;
+        }
+
+        LoadWindow window = { 0, 0, 0 };
+        if ( numSamples == 0 )
+        {
+            return window;
+        }
+
+        uint32_t sum = 0;
+        window.min = STATS_LOAD_FULL_SCALE;
+        for ( UBaseType_t n = 1; n <= numSamples; n++ )
+        {
+            uint16_t load = history[ ( head + STATS_SAMPLE_HISTORY - n ) % STATS_SAMPLE_HISTORY ];
+            sum += load;
+            window.min = ( load < window.min ) ? load : window.min;
+            window.max = ( load > window.max ) ? load : window.max;
+        }
+        window.avg = static_cast<uint16_t>( sum / numSamples );
+        return window;
+    }
+
+    /* A task without a history gets one starting from ulLastRunTimeCounter. */
+    TaskLoadHistory * FindTaskLoadHistory( UBaseType_t xTaskNumber, const char * name, configRUN_TIME_COUNTER_TYPE ulLastRunTimeCounter )
+    {
+        TaskLoadHistory * freeSlot = NULL;
+        for ( UBaseType_t i = 0; i < STATS_MAX_TRACKED_TASKS; i++ )
+        {
+            if ( s_taskLoad[i].inUse && s_taskLoad[i].xTaskNumber == xTaskNumber )
+            {
+                return &s_taskLoad[i];
+            }
+            if ( !s_taskLoad[i].inUse && freeSlot == NULL )
+            {
+                freeSlot = &s_taskLoad[i];
+            }
+        }
+
+        if ( freeSlot != NULL )
+        {
+            /* A task created since the previous sample, or one not sampled before, it has no history yet. */
+            memset( freeSlot, 0, sizeof( TaskLoadHistory ) );
+            freeSlot->inUse = true;
+            freeSlot->xTaskNumber = xTaskNumber;
+            freeSlot->ulLastRunTimeCounter = ulLastRunTimeCounter;
+            strncpy( freeSlot->name, name, configMAX_TASK_NAME_LEN - 1 );
+        }
+        return freeSlot;
+    }
+
+    void SamplerTimerCallback( TimerHandle_t xTimer )
+    {
+        ( void ) xTimer;
+        SampleTaskLoad();
+    }
+
+    double LoadToPercent( uint16_t load )
+    {
+        return static_cast<double>( load ) / ( STATS_LOAD_FULL_SCALE / 100.0 );
+    }
+}
+
+void SampleTaskLoad()
+{
+    static configRUN_TIME_COUNTER_TYPE lastTotRunTimeCounter = 0;
+    configRUN_TIME_COUNTER_TYPE totRunTimeCounter = 0;
+
+    /* Returns 0 if more than STATS_MAX_TRACKED_TASKS tasks exist, in which case only the cores are sampled and
+     * PrintTaskLoadStats() reports that the task loads are missing. */
+    UBaseType_t numRecordedTasks = uxTaskGetSystemState( s_sampleTaskStatus, STATS_MAX_TRACKED_TASKS, &totRunTimeCounter );
+    UBaseType_t numUntrackedTasks = ( numRecordedTasks == 0 ) ? uxTaskGetNumberOfTasks() : 0;
+    configRUN_TIME_COUNTER_TYPE windowRunTime = totRunTimeCounter - lastTotRunTimeCounter;
+
+    if ( numRecordedTasks != 0 )
+    {
+        if ( windowRunTime == 0 )
+        {
+            return;
+        }
+        lastTotRunTimeCounter = totRunTimeCounter;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        /* The tasks that were not sampled last time start from their current run time, not from 0, as their
+         * run time before this window is unknown.  They get no load for this window, only a baseline for the next. */
+        bool resync = ( s_numUntrackedTasks != 0 );
+        s_numUntrackedTasks = numUntrackedTasks;
+
+        for ( UBaseType_t i = 0; i < STATS_MAX_TRACKED_TASKS; i++ )
+        {
+            s_taskLoad[i].seen = false;
+        }
+
+        for ( UBaseType_t i = 0; i < numRecordedTasks; i++ )
+        {
+            TaskLoadHistory * history = FindTaskLoadHistory( s_sampleTaskStatus[i].xTaskNumber, s_sampleTaskStatus[i].pcTaskName,
+                                                             resync ? s_sampleTaskStatus[i].ulRunTimeCounter : 0 );
+            if ( history != NULL )
+            {
+                if ( !resync )
+                {
+                    configRUN_TIME_COUNTER_TYPE taskRunTime = s_sampleTaskStatus[i].ulRunTimeCounter - history->ulLastRunTimeCounter;
+                    history->ulLastRunTimeCounter = s_sampleTaskStatus[i].ulRunTimeCounter;
+                    history->load[ s_sampleHead ] = ToLoad( taskRunTime, windowRunTime * configNUMBER_OF_CORES );
+                    if ( history->numValid < STATS_SAMPLE_HISTORY )
+                    {
+                        history->numValid++;
+                    }
+                }
+                history->seen = true;
+            }
+        }
+
+        /* Forget the tasks that have been deleted, or all of them if they could not be sampled. */
+        for ( UBaseType_t i = 0; i < STATS_MAX_TRACKED_TASKS; i++ )
+        {
+            if ( !s_taskLoad[i].seen )
+            {
+                s_taskLoad[i].inUse = false;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+    for ( BaseType_t core = 0; core < configNUMBER_OF_CORES; core++ )
+    {
+        configRUN_TIME_COUNTER_TYPE coreRunTime = ulTaskGetCoreRunTimeCounter( core );
+        configRUN_TIME_COUNTER_TYPE coreIdleTime = ulTaskGetCoreIdleRunTimeCounter( core );
+        configRUN_TIME_COUNTER_TYPE windowCoreRunTime = coreRunTime - s_sampleLastCoreRunTime[core];
+        configRUN_TIME_COUNTER_TYPE windowCoreIdleTime = coreIdleTime - s_sampleLastCoreIdleTime[core];
+        s_sampleLastCoreRunTime[core] = coreRunTime;
+        s_sampleLastCoreIdleTime[core] = coreIdleTime;
+
+        s_coreLoad[core][ s_sampleHead ] = static_cast<uint16_t>( STATS_LOAD_FULL_SCALE - ToLoad( windowCoreIdleTime, windowCoreRunTime ) );
+    }
+#endif
+
+    taskENTER_CRITICAL();
+    {
+        s_sampleHead = ( s_sampleHead + 1U ) % STATS_SAMPLE_HISTORY;
+        if ( s_numSamples < STATS_SAMPLE_HISTORY )
+        {
+            s_numSamples++;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+#if ( configUSE_TIMERS == 1 )
+bool StartTaskLoadSampler()
+{
+    if ( s_samplerTimer == NULL )
+    {
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        static StaticTimer_t samplerTimerBuffer;
+        s_samplerTimer = xTimerCreateStatic( "StatsSampler", pdMS_TO_TICKS( STATS_SAMPLE_PERIOD_MS ), pdTRUE, NULL,
+                                             SamplerTimerCallback, &samplerTimerBuffer );
+#else
+        /* Allocated once, the sampler itself never allocates. */
+        s_samplerTimer = xTimerCreate( "StatsSampler", pdMS_TO_TICKS( STATS_SAMPLE_PERIOD_MS ), pdTRUE, NULL,
+                                       SamplerTimerCallback );
+#endif
+    }
+
+    return ( s_samplerTimer != NULL ) && ( xTimerStart( s_samplerTimer, 0 ) == pdPASS );
+}
+#endif /* configUSE_TIMERS */
+
+void PrintTaskLoadStats()
+{
+    static const uint32_t windowsMs[] = { 1000U, 10000U, 60000U };
+    uint16_t history[ STATS_SAMPLE_HISTORY ];
+    char name[ configMAX_TASK_NAME_LEN ];
+
+    Dc_printf("\r\nTask Load Statistics (%u samples of %u ms):\r\n", s_numSamples, STATS_SAMPLE_PERIOD_MS);
+    UBaseType_t numUntrackedTasks = s_numUntrackedTasks;
+    if ( numUntrackedTasks != 0 )
+    {
+        Dc_printf("Task loads not sampled: %u tasks exceed STATS_MAX_TRACKED_TASKS (%u)\r\n",
+            static_cast<unsigned>( numUntrackedTasks ),
+            static_cast<unsigned>( STATS_MAX_TRACKED_TASKS )
+        );
+    }
+    Dc_printf("|%-16s|%-8s|%-20s|%-20s|\r\n",
+        "Name",
+        "1s(%)",
+        "10s avg/min/max(%)",
+        "60s avg/min/max(%)"
+    );
+
+    /* The cores come first, then the tasks.  Each history is copied out under a critical section so the
+     * sampler can keep running while the row is printed. */
+    for ( UBaseType_t row = 0; row < configNUMBER_OF_CORES + STATS_MAX_TRACKED_TASKS; row++ )
+    {
+        bool valid = true;
+        UBaseType_t head;
+        UBaseType_t numValid;
+
+        taskENTER_CRITICAL();
+        {
+            head = s_sampleHead;
+            numValid = s_numSamples;
+            if ( row < configNUMBER_OF_CORES )
+            {
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+                memcpy( history, s_coreLoad[row], sizeof( history ) );
+#else
+                valid = false;      /* The core loads are sampled from the core run time counters. */
+#endif
+            }
+            else
+            {
+                const TaskLoadHistory & task = s_taskLoad[ row - configNUMBER_OF_CORES ];
+                valid = task.inUse && ( task.numValid != 0 );     /* No row until the task has a load. */
+                numValid = task.numValid;
+                memcpy( history, task.load, sizeof( history ) );
+                memcpy( name, task.name, sizeof( name ) );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if ( !valid )
+        {
+            continue;
+        }
+        if ( row < configNUMBER_OF_CORES )
+        {
+            snprintf( name, sizeof( name ), "Core%u", static_cast<unsigned>( row ) );
+        }
+
+        LoadWindow w1 = LoadOverWindow( history, head, numValid, windowsMs[0] );
+        LoadWindow w10 = LoadOverWindow( history, head, numValid, windowsMs[1] );
+        LoadWindow w60 = LoadOverWindow( history, head, numValid, windowsMs[2] );
+        Dc_printf("|%-16s|%-8.2f|%6.2f/%6.2f/%6.2f|%6.2f/%6.2f/%6.2f|\r\n",
+            name,
+            LoadToPercent( w1.avg ),
+            LoadToPercent( w10.avg ), LoadToPercent( w10.min ), LoadToPercent( w10.max ),
+            LoadToPercent( w60.avg ), LoadToPercent( w60.min ), LoadToPercent( w60.max )
+        );
+    }
+}
+
 void PrintQueueStats()
 {
     QueueStatus_t * pxQueueStatusArray;
@@ -0,0 +1,184 @@
+/*
+ * Binary trace recorder.  See include/freertos_trace.h.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* The events are indexed with a mask, so the ring length must be a power of 2
+ * (checked in freertos_trace.h). */
+    #define traceRECORDER_INDEX_MASK    ( ( uint32_t ) configTRACE_RECORDER_EVENTS_PER_CORE - 1U )
+
+/* The recorder is statically initialised so events can be recorded from the
+ * very first kernel call, before the scheduler has been started. */
+    TraceRecorder_t xTraceRecorder =
+    {
+        traceRECORDER_MAGIC,
+        traceRECORDER_VERSION,
+        ( uint16_t ) sizeof( TraceEvent_t ),
+        configTRACE_RECORDER_EVENTS_PER_CORE,
+        configNUMBER_OF_CORES,
+        configTRACE_RECORDER_TIMESTAMP_HZ,
+        configTRACE_RECORDER_MAX_OBJECT_NAMES,
+        1U,
+        { { 0U, { 0 } } },
+        { { 0U, { { 0U, 0U, 0U, 0U, 0U, 0U } } } }
+    };
+
+/* Next name table entry to replace once the table is full. */
+    static uint32_t ulNextObjectNameToReplace = 0U;
+
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderWrite( uint16_t usEventID,
+                              const void * pvHandle,
+                              uint32_t ulArgument )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        TraceCoreRing_t * pxRing;
+        TraceEvent_t * pxEvent;
+        BaseType_t xCoreID;
+
+        if( xTraceRecorder.ulEnabled != 0U )
+        {
+            /* Masking interrupts on this core is all that is needed - no other
+             * core writes to this core's ring, and the calling task cannot
+             * migrate to another core while interrupts are masked. */
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+                xCoreID = 0;
+            }
+            #else
+            {
+                uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+                xCoreID = ( BaseType_t ) portGET_CORE_ID();
+            }
+            #endif
+            {
+                pxRing = &( xTraceRecorder.xCores[ xCoreID ] );
+                pxEvent = &( pxRing->xEvents[ pxRing->ulHead & traceRECORDER_INDEX_MASK ] );
+
+                pxEvent->ulTimestamp = configTRACE_RECORDER_TIMESTAMP();
+                pxEvent->usEventID = usEventID;
+                pxEvent->ucCoreID = ( uint8_t ) xCoreID;
+                pxEvent->ucReserved = 0U;
+                pxEvent->ulHandle = ( uint32_t ) ( ( portPOINTER_SIZE_TYPE ) pvHandle );
+                pxEvent->ulArgument = ulArgument;
+
+                pxRing->ulHead++;
+            }
+            #if ( configNUMBER_OF_CORES == 1 )
+                portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+            #else
+                portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+            #endif
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderSetObjectName( const void * pvHandle,
+                                      const char * pcName )
+    {
+        TraceObjectName_t * pxEntry = NULL;
+        uint32_t ulHandle = ( uint32_t ) ( ( portPOINTER_SIZE_TYPE ) pvHandle );
+        uint32_t x;
+
+        if( ( pcName != NULL ) && ( ulHandle != 0U ) )
+        {
+            /* Reuse the entry of a handle that is named again (for example a
+             * task created in the memory of a deleted one), otherwise take the
+             * first free entry. */
+            for( x = 0U; x < ( uint32_t ) configTRACE_RECORDER_MAX_OBJECT_NAMES; x++ )
+            {
+                if( xTraceRecorder.xObjectNames[ x ].ulHandle == ulHandle )
+                {
+                    pxEntry = &( xTraceRecorder.xObjectNames[ x ] );
+                    break;
+                }
+                else if( ( pxEntry == NULL ) && ( xTraceRecorder.xObjectNames[ x ].ulHandle == 0U ) )
+                {
+                    pxEntry = &( xTraceRecorder.xObjectNames[ x ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( pxEntry == NULL )
+            {
+                pxEntry = &( xTraceRecorder.xObjectNames[ ulNextObjectNameToReplace ] );
+                ulNextObjectNameToReplace = ( ulNextObjectNameToReplace + 1U ) % ( uint32_t ) configTRACE_RECORDER_MAX_OBJECT_NAMES;
+            }
+
+            pxEntry->ulHandle = ulHandle;
+
+            for( x = 0U; x < ( traceRECORDER_NAME_LENGTH - 1U ); x++ )
+            {
+                pxEntry->cName[ x ] = pcName[ x ];
+
+                if( pcName[ x ] == ( char ) 0x00 )
+                {
+                    break;
+                }
+            }
+
+            pxEntry->cName[ traceRECORDER_NAME_LENGTH - 1U ] = ( char ) 0x00;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStart( void )
+    {
+        xTraceRecorder.ulEnabled = 1U;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStop( void )
+    {
+        xTraceRecorder.ulEnabled = 0U;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderClear( void )
+    {
+        uint32_t ulWasEnabled = xTraceRecorder.ulEnabled;
+        BaseType_t xCoreID;
+
+        xTraceRecorder.ulEnabled = 0U;
+
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            xTraceRecorder.xCores[ xCoreID ].ulHead = 0U;
+            ( void ) memset( xTraceRecorder.xCores[ xCoreID ].xEvents, 0x00, sizeof( xTraceRecorder.xCores[ xCoreID ].xEvents ) );
+        }
+
+        xTraceRecorder.ulEnabled = ulWasEnabled;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderDump( TraceRecorderWriteFunction_t pxWriteFunction,
+                             void * pvContext )
+    {
+        uint32_t ulWasEnabled = xTraceRecorder.ulEnabled;
+
+        configASSERT( pxWriteFunction != NULL );
+
+        /* Stop recording so the rings do not change while they are written
+         * out - the write function may itself call kernel APIs that would
+         * otherwise add events. */
+        xTraceRecorder.ulEnabled = 0U;
+
+        pxWriteFunction( &xTraceRecorder, sizeof( xTraceRecorder ), pvContext );
+
+        xTraceRecorder.ulEnabled = ulWasEnabled;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TRACE_RECORDER == 1 */
@@ -94,6 +94,22 @@
     #define configUSE_MALLOC_FAILED_HOOK    0
 #endif
 
+/* Set configHEAP_TRACK_ALLOCATIONS to 1 to have heap_4 and heap_5 record the
+ * owner task, call site and time of each allocation in the block header, so
+ * the blocks still allocated can be listed with uxPortWalkHeapAllocations().
+ * Must be defaulted before portable.h is included. */
+#ifndef configHEAP_TRACK_ALLOCATIONS
+    #define configHEAP_TRACK_ALLOCATIONS    0
+#endif
+
+/* Set configHEAP_NUMBER_OF_MEMORY_CLASSES above 1 to tag each heap_5 region
+ * with a memory class (for example fast, slow or DMA capable memory), so
+ * allocations can be made from a chosen class with pvPortMallocFromClass().
+ * Must be defaulted before portable.h is included. */
+#ifndef configHEAP_NUMBER_OF_MEMORY_CLASSES
+    #define configHEAP_NUMBER_OF_MEMORY_CLASSES    1
+#endif
+
 #ifndef configASSERT
     #define configASSERT( x )
     #define configASSERT_DEFINED    0
@@ -321,6 +337,39 @@
     #define configUSE_MUTEXES    0
 #endif
 
+/* Set configUSE_SEMAPHORE_FAST_PATH to 1 to have xSemaphoreTake() and
+ * xSemaphoreGive() complete in a single short critical section when no other
+ * task is blocked on, or about to block on, the semaphore or mutex. */
+#ifndef configUSE_SEMAPHORE_FAST_PATH
+    #define configUSE_SEMAPHORE_FAST_PATH    0
+#endif
+
+/* Set configMUTEX_SPIN_ITERATIONS above 0 to have a task that finds a mutex
+ * held by a task running on another core poll the mutex up to that many times
+ * before it blocks.  Has no effect when configNUMBER_OF_CORES is 1. */
+#ifndef configMUTEX_SPIN_ITERATIONS
+    #define configMUTEX_SPIN_ITERATIONS    0
+#endif
+
+#ifndef configUSE_RW_LOCKS
+    #define configUSE_RW_LOCKS    0
+#endif
+
+/* Set configUSE_PRIORITY_CEILING_MUTEXES to 1 to include
+ * xSemaphoreCreateMutexWithCeiling(), which creates mutexes that use the
+ * immediate priority ceiling protocol in place of priority inheritance. */
+#ifndef configUSE_PRIORITY_CEILING_MUTEXES
+    #define configUSE_PRIORITY_CEILING_MUTEXES    0
+#endif
+
+/* The number of mutex holders a task that blocks on a mutex passes its
+ * priority to.  1 raises only the holder of the mutex.  Higher values also
+ * raise the holder of the mutex that holder is blocked on, and so on along the
+ * chain, up to the given number of tasks. */
+#ifndef configMAX_PRIORITY_INHERITANCE_DEPTH
+    #define configMAX_PRIORITY_INHERITANCE_DEPTH    1
+#endif
+
 #ifndef configUSE_TIMERS
     #define configUSE_TIMERS    0
 #endif
@@ -581,6 +630,10 @@
     #define portTASK_SWITCH_HOOK( pxTCB )    ( void ) ( pxTCB )
 #endif
 
+#ifndef portSTOP_OTHER_CORES
+    #define portSTOP_OTHER_CORES()
+#endif
+
 #ifndef configQUEUE_REGISTRY_SIZE
     #define configQUEUE_REGISTRY_SIZE    0U
 #endif
@@ -599,6 +652,19 @@
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
 
+/* Must be defaulted before configUSE_TRACE_RECORDER is used below. */
+#ifndef configUSE_TRACE_RECORDER
+    #define configUSE_TRACE_RECORDER    0
+#endif
+
+/* The binary trace recorder defines the trace macros it uses, so it must be
+ * included before the unused ones are removed below. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+    #include "freertos_trace.h"
+
+#endif /* if ( configUSE_TRACE_RECORDER == 1 ) */
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 
@@ -1212,6 +1278,102 @@
     #define traceRETURN_xQueueCreateMutexStatic( xNewQueue )
 #endif
 
+#ifndef traceENTER_xQueueCreateMutexWithCeiling
+    #define traceENTER_xQueueCreateMutexWithCeiling( ucQueueType, uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_xQueueCreateMutexWithCeiling
+    #define traceRETURN_xQueueCreateMutexWithCeiling( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateMutexWithCeilingStatic
+    #define traceENTER_xQueueCreateMutexWithCeilingStatic( ucQueueType, uxCeilingPriority, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreateMutexWithCeilingStatic
+    #define traceRETURN_xQueueCreateMutexWithCeilingStatic( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateRWLock
+    #define traceENTER_xQueueCreateRWLock()
+#endif
+
+#ifndef traceRETURN_xQueueCreateRWLock
+    #define traceRETURN_xQueueCreateRWLock( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateRWLockStatic
+    #define traceENTER_xQueueCreateRWLockStatic( pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreateRWLockStatic
+    #define traceRETURN_xQueueCreateRWLockStatic( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueTakeRWLock
+    #define traceENTER_xQueueTakeRWLock( xRWLock, xWrite, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueTakeRWLock
+    #define traceRETURN_xQueueTakeRWLock( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueGiveRWLock
+    #define traceENTER_xQueueGiveRWLock( xRWLock, xWrite )
+#endif
+
+#ifndef traceRETURN_xQueueGiveRWLock
+    #define traceRETURN_xQueueGiveRWLock( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueTakeRWLockReadFromISR
+    #define traceENTER_xQueueTakeRWLockReadFromISR( xRWLock )
+#endif
+
+#ifndef traceRETURN_xQueueTakeRWLockReadFromISR
+    #define traceRETURN_xQueueTakeRWLockReadFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueGiveRWLockReadFromISR
+    #define traceENTER_xQueueGiveRWLockReadFromISR( xRWLock, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueGiveRWLockReadFromISR
+    #define traceRETURN_xQueueGiveRWLockReadFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSemaphoreGiveN
+    #define traceENTER_xQueueSemaphoreGiveN( xQueue, uxCount )
+#endif
+
+#ifndef traceRETURN_xQueueSemaphoreGiveN
+    #define traceRETURN_xQueueSemaphoreGiveN( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSemaphoreTakeN
+    #define traceENTER_xQueueSemaphoreTakeN( xQueue, uxCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueSemaphoreTakeN
+    #define traceRETURN_xQueueSemaphoreTakeN( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSemaphoreGiveNFromISR
+    #define traceENTER_xQueueSemaphoreGiveNFromISR( xQueue, uxCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueSemaphoreGiveNFromISR
+    #define traceRETURN_xQueueSemaphoreGiveNFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSemaphoreTakeNFromISR
+    #define traceENTER_xQueueSemaphoreTakeNFromISR( xQueue, uxCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueSemaphoreTakeNFromISR
+    #define traceRETURN_xQueueSemaphoreTakeNFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_xQueueGetMutexHolder
     #define traceENTER_xQueueGetMutexHolder( xSemaphore )
 #endif
@@ -1220,6 +1382,14 @@
     #define traceRETURN_xQueueGetMutexHolder( pxReturn )
 #endif
 
+#ifndef traceENTER_vQueueGetMutexSpinStats
+    #define traceENTER_vQueueGetMutexSpinStats( xMutex, pxSpinStats )
+#endif
+
+#ifndef traceRETURN_vQueueGetMutexSpinStats
+    #define traceRETURN_vQueueGetMutexSpinStats()
+#endif
+
 #ifndef traceENTER_xQueueGetMutexHolderFromISR
     #define traceENTER_xQueueGetMutexHolderFromISR( xSemaphore )
 #endif
@@ -1340,6 +1510,14 @@
     #define traceRETURN_uxQueueSpacesAvailable( uxReturn )
 #endif
 
+#ifndef traceENTER_uxQueueGetOverrunCount
+    #define traceENTER_uxQueueGetOverrunCount( xQueue )
+#endif
+
+#ifndef traceRETURN_uxQueueGetOverrunCount
+    #define traceRETURN_uxQueueGetOverrunCount( uxReturn )
+#endif
+
 #ifndef traceENTER_uxQueueMessagesWaitingFromISR
     #define traceENTER_uxQueueMessagesWaitingFromISR( xQueue )
 #endif
@@ -1492,6 +1670,22 @@
     #define traceRETURN_xQueueCreateSetStatic( pxQueue )
 #endif
 
+#ifndef traceENTER_xQueueCreatePrioritySet
+    #define traceENTER_xQueueCreatePrioritySet( uxNumberOfPriorities )
+#endif
+
+#ifndef traceRETURN_xQueueCreatePrioritySet
+    #define traceRETURN_xQueueCreatePrioritySet( pxQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreatePrioritySetStatic
+    #define traceENTER_xQueueCreatePrioritySetStatic( uxNumberOfPriorities )
+#endif
+
+#ifndef traceRETURN_xQueueCreatePrioritySetStatic
+    #define traceRETURN_xQueueCreatePrioritySetStatic( pxQueue )
+#endif
+
 #ifndef traceENTER_xQueueAddToSet
     #define traceENTER_xQueueAddToSet( xQueueOrSemaphore, xQueueSet )
 #endif
@@ -1500,6 +1694,14 @@
     #define traceRETURN_xQueueAddToSet( xReturn )
 #endif
 
+#ifndef traceENTER_xQueueAddToPrioritySet
+    #define traceENTER_xQueueAddToPrioritySet( xQueueOrSemaphore, xQueueSet, uxPriority )
+#endif
+
+#ifndef traceRETURN_xQueueAddToPrioritySet
+    #define traceRETURN_xQueueAddToPrioritySet( xReturn )
+#endif
+
 #ifndef traceENTER_xQueueRemoveFromSet
     #define traceENTER_xQueueRemoveFromSet( xQueueOrSemaphore, xQueueSet )
 #endif
@@ -1836,6 +2038,22 @@
     #define traceRETURN_vTaskCoreAffinityGet( uxCoreAffinityMask )
 #endif
 
+#ifndef traceENTER_vTaskSetTimeSlice
+    #define traceENTER_vTaskSetTimeSlice( xTask, xTimeSliceTicks )
+#endif
+
+#ifndef traceRETURN_vTaskSetTimeSlice
+    #define traceRETURN_vTaskSetTimeSlice()
+#endif
+
+#ifndef traceENTER_xTaskGetTimeSlice
+    #define traceENTER_xTaskGetTimeSlice( xTask )
+#endif
+
+#ifndef traceRETURN_xTaskGetTimeSlice
+    #define traceRETURN_xTaskGetTimeSlice( xTimeSliceTicks )
+#endif
+
 #ifndef traceENTER_vTaskPreemptionDisable
     #define traceENTER_vTaskPreemptionDisable( xTask )
 #endif
@@ -2248,6 +2466,22 @@
     #define traceRETURN_vTaskPriorityDisinheritAfterTimeout()
 #endif
 
+#ifndef traceENTER_vTaskSetBlockingMutexHolder
+    #define traceENTER_vTaskSetBlockingMutexHolder( pxMutexHolder )
+#endif
+
+#ifndef traceRETURN_vTaskSetBlockingMutexHolder
+    #define traceRETURN_vTaskSetBlockingMutexHolder()
+#endif
+
+#ifndef traceENTER_vTaskPriorityRaiseToCeiling
+    #define traceENTER_vTaskPriorityRaiseToCeiling( uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_vTaskPriorityRaiseToCeiling
+    #define traceRETURN_vTaskPriorityRaiseToCeiling()
+#endif
+
 #ifndef traceENTER_vTaskYieldWithinAPI
     #define traceENTER_vTaskYieldWithinAPI()
 #endif
@@ -2320,6 +2554,14 @@
     #define traceRETURN_pvTaskIncrementMutexHeldCount( pxTCB )
 #endif
 
+#ifndef traceENTER_xTaskIsRunning
+    #define traceENTER_xTaskIsRunning( xTask )
+#endif
+
+#ifndef traceRETURN_xTaskIsRunning
+    #define traceRETURN_xTaskIsRunning( xReturn )
+#endif
+
 #ifndef traceENTER_ulTaskGenericNotifyTake
     #define traceENTER_ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait )
 #endif
@@ -2376,6 +2618,70 @@
     #define traceRETURN_ulTaskGenericNotifyValueClear( ulReturn )
 #endif
 
+#ifndef traceENTER_xTaskNotifyGroupCreate
+    #define traceENTER_xTaskNotifyGroupCreate( uxIndexToNotify, uxMaxMembers )
+#endif
+
+#ifndef traceRETURN_xTaskNotifyGroupCreate
+    #define traceRETURN_xTaskNotifyGroupCreate( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskNotifyGroupCreateStatic
+    #define traceENTER_xTaskNotifyGroupCreateStatic( uxIndexToNotify, uxMaxMembers, pxMemberBuffer, pxNotifyGroupBuffer )
+#endif
+
+#ifndef traceRETURN_xTaskNotifyGroupCreateStatic
+    #define traceRETURN_xTaskNotifyGroupCreateStatic( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskNotifyGroupDelete
+    #define traceENTER_vTaskNotifyGroupDelete( xNotifyGroup )
+#endif
+
+#ifndef traceRETURN_vTaskNotifyGroupDelete
+    #define traceRETURN_vTaskNotifyGroupDelete()
+#endif
+
+#ifndef traceENTER_xTaskNotifyGroupAddMember
+    #define traceENTER_xTaskNotifyGroupAddMember( xNotifyGroup, xTask )
+#endif
+
+#ifndef traceRETURN_xTaskNotifyGroupAddMember
+    #define traceRETURN_xTaskNotifyGroupAddMember( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskNotifyGroupRemoveMember
+    #define traceENTER_xTaskNotifyGroupRemoveMember( xNotifyGroup, xTask )
+#endif
+
+#ifndef traceRETURN_xTaskNotifyGroupRemoveMember
+    #define traceRETURN_xTaskNotifyGroupRemoveMember( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskNotifyGroupNotify
+    #define traceENTER_xTaskNotifyGroupNotify( xNotifyGroup, ulValue, eAction )
+#endif
+
+#ifndef traceRETURN_xTaskNotifyGroupNotify
+    #define traceRETURN_xTaskNotifyGroupNotify( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskNotifyGroupSetBitsFromISR
+    #define traceENTER_xTaskNotifyGroupSetBitsFromISR( xNotifyGroup, ulBitsToSet, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xTaskNotifyGroupSetBitsFromISR
+    #define traceRETURN_xTaskNotifyGroupSetBitsFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskNotifyGroupGiveFromISR
+    #define traceENTER_xTaskNotifyGroupGiveFromISR( xNotifyGroup, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xTaskNotifyGroupGiveFromISR
+    #define traceRETURN_xTaskNotifyGroupGiveFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_ulTaskGetRunTimeCounter
     #define traceENTER_ulTaskGetRunTimeCounter( xTask )
 #endif
@@ -2392,6 +2698,22 @@
     #define traceRETURN_ulTaskGetRunTimePercent( ulReturn )
 #endif
 
+#ifndef traceENTER_ulTaskGetCoreRunTimeCounter
+    #define traceENTER_ulTaskGetCoreRunTimeCounter( xCoreID )
+#endif
+
+#ifndef traceRETURN_ulTaskGetCoreRunTimeCounter
+    #define traceRETURN_ulTaskGetCoreRunTimeCounter( ulCoreRunTime )
+#endif
+
+#ifndef traceENTER_ulTaskGetCoreIdleRunTimeCounter
+    #define traceENTER_ulTaskGetCoreIdleRunTimeCounter( xCoreID )
+#endif
+
+#ifndef traceRETURN_ulTaskGetCoreIdleRunTimeCounter
+    #define traceRETURN_ulTaskGetCoreIdleRunTimeCounter( ulCoreIdleTime )
+#endif
+
 #ifndef traceENTER_ulTaskGetIdleRunTimeCounter
     #define traceENTER_ulTaskGetIdleRunTimeCounter()
 #endif
@@ -2690,6 +3012,14 @@
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+#ifndef configGENERATE_CONTEXT_SWITCH_STATS
+    #define configGENERATE_CONTEXT_SWITCH_STATS    0
+#endif
+
+#if ( ( configGENERATE_CONTEXT_SWITCH_STATS == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+    #error configUSE_TRACE_FACILITY must be set to 1 to report the context switch statistics gathered when configGENERATE_CONTEXT_SWITCH_STATS is 1
+#endif
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
     #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
@@ -2734,6 +3064,20 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+/* Set configUSE_PRIORITY_QUEUE_SETS to 1 to include xQueueCreatePrioritySet(),
+ * which creates queue sets that record which members hold data in a bitmap and
+ * select the highest priority member that does. */
+#ifndef configUSE_PRIORITY_QUEUE_SETS
+    #define configUSE_PRIORITY_QUEUE_SETS    0
+#endif
+
+/* Set configUSE_QUEUE_OVERWRITE_OLDEST to 1 to include xQueueOverwriteOldest()
+ * and xQueueOverwriteOldestFromISR(), which drop the oldest item from a full
+ * queue to make room for the item being sent, and uxQueueGetOverrunCount(). */
+#ifndef configUSE_QUEUE_OVERWRITE_OLDEST
+    #define configUSE_QUEUE_OVERWRITE_OLDEST    0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -2750,6 +3094,24 @@
     #define configUSE_TIME_SLICING    1
 #endif
 
+#ifndef configUSE_PER_TASK_TIME_SLICE
+    #define configUSE_PER_TASK_TIME_SLICE    0
+#endif
+
+#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+    #ifndef configTASK_DEFAULT_TIME_SLICE_TICKS
+        #define configTASK_DEFAULT_TIME_SLICE_TICKS    1
+    #endif
+
+    #if ( ( configUSE_PREEMPTION == 0 ) || ( configUSE_TIME_SLICING == 0 ) )
+        #error configUSE_PREEMPTION and configUSE_TIME_SLICING must both be set to 1 to use per task time slices
+    #endif
+
+    #if ( configTASK_DEFAULT_TIME_SLICE_TICKS < 1 )
+        #error configTASK_DEFAULT_TIME_SLICE_TICKS must be at least 1
+    #endif
+#endif
+
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
     #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
 #endif
@@ -2802,6 +3164,25 @@
     #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
 #endif
 
+#ifndef configUSE_TASK_NOTIFY_GROUPS
+    #define configUSE_TASK_NOTIFY_GROUPS    0
+#endif
+
+#if ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use task notification groups
+#endif
+
+/* The number of members of a task notification group notified within one
+ * critical section.  Higher values make notifying a large group cheaper, lower
+ * values shorten the time interrupts are disabled for. */
+#ifndef configTASK_NOTIFY_GROUP_BATCH_SIZE
+    #define configTASK_NOTIFY_GROUP_BATCH_SIZE    8
+#endif
+
+#if ( configTASK_NOTIFY_GROUP_BATCH_SIZE < 1 )
+    #error configTASK_NOTIFY_GROUP_BATCH_SIZE must be at least 1
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
     #define configUSE_POSIX_ERRNO    0
 #endif
@@ -2859,6 +3240,19 @@
     #define configRUN_TIME_COUNTER_TYPE    uint32_t
 #endif
 
+#ifndef configUSE_EXTENDED_RUN_TIME_COUNTER
+    #define configUSE_EXTENDED_RUN_TIME_COUNTER    0
+#endif
+
+#if ( configUSE_EXTENDED_RUN_TIME_COUNTER == 1 )
+    #ifndef configRUN_TIME_PORT_COUNTER_TYPE
+
+/* The type of the value returned by portGET_RUN_TIME_COUNTER_VALUE().  The
+ * kernel extends it to the width of configRUN_TIME_COUNTER_TYPE. */
+        #define configRUN_TIME_PORT_COUNTER_TYPE    uint32_t
+    #endif
+#endif
+
 #ifndef configMESSAGE_BUFFER_LENGTH_TYPE
 
 /* Defaults to size_t for backward compatibility, but can be overridden
@@ -2876,6 +3270,22 @@
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use reader-writer locks
+#endif
+
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use priority ceiling mutexes
+#endif
+
+#if ( ( configUSE_PRIORITY_QUEUE_SETS == 1 ) && ( configUSE_QUEUE_SETS != 1 ) )
+    #error configUSE_QUEUE_SETS must be set to 1 to use priority queue sets
+#endif
+
+#if ( configMAX_PRIORITY_INHERITANCE_DEPTH < 1 )
+    #error configMAX_PRIORITY_INHERITANCE_DEPTH must be at least 1
+#endif
+
 #if ( ( configRUN_MULTIPLE_PRIORITIES == 0 ) && ( configUSE_TASK_PREEMPTION_DISABLE != 0 ) )
     #error configRUN_MULTIPLE_PRIORITIES must be set to 1 to use task preemption disable
 #endif
@@ -3181,6 +3591,9 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
         BaseType_t xDummy25;
     #endif
+    #if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+        TickType_t xDummy27[ 2 ];
+    #endif
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         void * pxDummy8;
     #endif
@@ -3193,6 +3606,9 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_MUTEXES == 1 )
         UBaseType_t uxDummy12[ 2 ];
     #endif
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+        void * pxDummy31;
+    #endif
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         void * pxDummy14;
     #endif
@@ -3202,6 +3618,13 @@ typedef struct xSTATIC_TCB
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         configRUN_TIME_COUNTER_TYPE ulDummy16;
     #endif
+    #if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+        UBaseType_t uxDummy28[ 3 ];
+        #if ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxDummy29;
+            BaseType_t xDummy30;
+        #endif
+    #endif
     #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         configTLS_BLOCK_TYPE xDummy17;
     #endif
@@ -3209,6 +3632,9 @@ typedef struct xSTATIC_TCB
         uint32_t ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
         uint8_t ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
     #endif
+    #if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+        UBaseType_t uxDummy32;
+    #endif
     #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
         uint8_t uxDummy20;
     #endif
@@ -3261,8 +3687,25 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+        UBaseType_t uxDummy10[ 3 ];
+    #endif
+
+    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+        UBaseType_t uxDummy11;
+    #endif
+
+    #if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+        uint8_t ucDummy12;
+    #endif
+
+    #if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+        UBaseType_t uxDummy13;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
+typedef StaticQueue_t StaticRWLock_t;
 
 /*
  * In line with software engineering best practice, especially when supplying a
@@ -3292,6 +3735,25 @@ typedef struct xSTATIC_EVENT_GROUP
     #endif
 } StaticEventGroup_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the task notification group structure used
+ * internally by FreeRTOS is not accessible to application code.  The
+ * StaticTaskNotifyGroup_t structure below is provided so the application
+ * writer can statically allocate the memory required to create a task
+ * notification group.  Its size and alignment requirements are guaranteed to
+ * match those of the genuine structure.
+ */
+typedef struct xSTATIC_TASK_NOTIFY_GROUP
+{
+    UBaseType_t uxDummy1[ 3 ];
+    void * pvDummy2[ 2 ];
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy3;
+    #endif
+} StaticTaskNotifyGroup_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -0,0 +1,120 @@
+#ifndef FREERTOS_QUEUE_HPP
+#define FREERTOS_QUEUE_HPP
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include <type_traits>                  // for std::is_trivially_copyable
+
+/* Queues whose item type is known at compile time. The queue is created with an item size of sizeof( T ), so
+ * a variable of the wrong size cannot be sent to it or received from it, and items of 4 or 8 bytes take the
+ * fixed size copies in queue.c (see prvCopyItem()) rather than a memcpy() of a run time size.
+ *
+ * freertos::Queue< T > allocates the queue from the FreeRTOS heap, freertos::StaticQueue< T, Length > holds the
+ * queue and its storage in the object. Both delete the queue when they are destroyed and cannot be copied.
+ * Handle() returns the QueueHandle_t for use with the rest of the queue API, for example xQueueAddToSet().
+ *
+ * The member functions call the C API function of the same name and return what it returns. */
+namespace freertos
+{
+    template< typename T >
+    class QueueBase
+    {
+        static_assert( std::is_trivially_copyable< T >::value, "queue items are copied byte for byte" );
+
+    public:
+        QueueBase( const QueueBase & ) = delete;
+        QueueBase & operator=( const QueueBase & ) = delete;
+
+        QueueHandle_t Handle() const { return handle; }
+
+        /* False if the queue could not be created. */
+        explicit operator bool() const { return handle != NULL; }
+
+        BaseType_t Send( const T & item, TickType_t ticksToWait ) { return xQueueSendToBack( handle, &item, ticksToWait ); }
+        BaseType_t SendToFront( const T & item, TickType_t ticksToWait ) { return xQueueSendToFront( handle, &item, ticksToWait ); }
+        BaseType_t Overwrite( const T & item ) { return xQueueOverwrite( handle, &item ); }
+#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+        BaseType_t OverwriteOldest( const T & item ) { return xQueueOverwriteOldest( handle, &item ); }
+        UBaseType_t OverrunCount() const { return uxQueueGetOverrunCount( handle ); }
+#endif
+        BaseType_t Receive( T & item, TickType_t ticksToWait ) { return xQueueReceive( handle, &item, ticksToWait ); }
+        BaseType_t Peek( T & item, TickType_t ticksToWait ) { return xQueuePeek( handle, &item, ticksToWait ); }
+
+        BaseType_t SendFromISR( const T & item, BaseType_t * higherPriorityTaskWoken )
+        {
+            return xQueueSendToBackFromISR( handle, &item, higherPriorityTaskWoken );
+        }
+
+        BaseType_t SendToFrontFromISR( const T & item, BaseType_t * higherPriorityTaskWoken )
+        {
+            return xQueueSendToFrontFromISR( handle, &item, higherPriorityTaskWoken );
+        }
+
+        BaseType_t OverwriteFromISR( const T & item, BaseType_t * higherPriorityTaskWoken )
+        {
+            return xQueueOverwriteFromISR( handle, &item, higherPriorityTaskWoken );
+        }
+
+#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+        BaseType_t OverwriteOldestFromISR( const T & item, BaseType_t * higherPriorityTaskWoken )
+        {
+            return xQueueOverwriteOldestFromISR( handle, &item, higherPriorityTaskWoken );
+        }
+#endif
+
+        BaseType_t ReceiveFromISR( T & item, BaseType_t * higherPriorityTaskWoken )
+        {
+            return xQueueReceiveFromISR( handle, &item, higherPriorityTaskWoken );
+        }
+
+        BaseType_t PeekFromISR( T & item ) { return xQueuePeekFromISR( handle, &item ); }
+
+        UBaseType_t MessagesWaiting() const { return uxQueueMessagesWaiting( handle ); }
+        UBaseType_t MessagesWaitingFromISR() const { return uxQueueMessagesWaitingFromISR( handle ); }
+        UBaseType_t SpacesAvailable() const { return uxQueueSpacesAvailable( handle ); }
+        BaseType_t Reset() { return xQueueReset( handle ); }
+
+    protected:
+        explicit QueueBase( QueueHandle_t queueHandle ) : handle( queueHandle ) {}
+
+        ~QueueBase()
+        {
+            if( handle != NULL )
+            {
+                vQueueDelete( handle );
+            }
+        }
+
+        QueueHandle_t handle;
+    };
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    template< typename T >
+    class Queue : public QueueBase< T >
+    {
+    public:
+        explicit Queue( UBaseType_t length ) : QueueBase< T >( xQueueCreate( length, sizeof( T ) ) ) {}
+    };
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    template< typename T, UBaseType_t Length >
+    class StaticQueue : public QueueBase< T >
+    {
+        static_assert( Length > 0U, "a queue holds at least one item" );
+
+    public:
+        StaticQueue() : QueueBase< T >( NULL )
+        {
+            this->handle = xQueueCreateStatic( Length, sizeof( T ), storage, &queueBuffer );
+        }
+
+    private:
+        /* Items are copied with memcpy(), so the storage area needs no alignment. */
+        uint8_t storage[ Length * sizeof( T ) ];
+        StaticQueue_t queueBuffer;
+    };
+#endif
+}
+
+#endif /* FREERTOS_QUEUE_HPP */
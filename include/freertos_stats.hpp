@@ -4,7 +4,22 @@
 #include "uart_interface.hpp"   // for Dc_printf
 
 void PrintFreeRtosHeapStats();
+
+/* Live heap allocations summarised per owner task and per call site, largest first. Only available when
+ * configHEAP_TRACK_ALLOCATIONS is 1 (heap_4 and heap_5). */
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+void PrintHeapAllocationStats();
+#endif
 void PrintTaskStats();
+
+/* Task load sampler: SampleTaskLoad() records the load of every task and core since its previous call
+ * into a fixed history, StartTaskLoadSampler() calls it every STATS_SAMPLE_PERIOD_MS from a software
+ * timer, and PrintTaskLoadStats() reports the load over the last 1s, 10s and 60s with min/max. */
+void SampleTaskLoad();
+#if ( configUSE_TIMERS == 1 )
+bool StartTaskLoadSampler();
+#endif
+void PrintTaskLoadStats();
 void PrintQueueStats();
 void PrintMemPoolStats();
 void PrintMainHeapStackUsage();
\ No newline at end of file
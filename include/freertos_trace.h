@@ -0,0 +1,514 @@
+/*
+ * Binary trace recorder.
+ *
+ * When configUSE_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h this header is
+ * included by FreeRTOS.h and maps the kernel trace macros (task switches,
+ * ready/blocking transitions, queue, notification, event group, timer and heap
+ * events plus the traceENTER_/traceRETURN_ hooks of the blocking and ISR APIs)
+ * onto vTraceRecorderWrite().  Each event is a fixed 16 byte record holding a
+ * timestamp, the core it was recorded on, an event ID, the object handle and
+ * one argument.  Every core writes only into its own ring, so recording never
+ * takes a cross-core lock - only local interrupts are masked for the few stores
+ * that make up an event.  The rings overwrite their oldest events once full.
+ *
+ * The whole recorder lives in the single object xTraceRecorder, which can be
+ * saved with a debugger or streamed out with vTraceRecorderDump(), and turned
+ * into a timeline on the host with tools/freertos_trace_decode.py.
+ *
+ * Any trace macro already defined in FreeRTOSConfig.h takes precedence over
+ * the recorder's definition of it.
+ */
+
+#ifndef FREERTOS_TRACE_H
+#define FREERTOS_TRACE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include freertos_trace.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Number of events held by the ring of each core.  Must be a power of 2. */
+#ifndef configTRACE_RECORDER_EVENTS_PER_CORE
+    #define configTRACE_RECORDER_EVENTS_PER_CORE    512
+#endif
+
+#if ( ( configTRACE_RECORDER_EVENTS_PER_CORE & ( configTRACE_RECORDER_EVENTS_PER_CORE - 1 ) ) != 0 )
+    #error configTRACE_RECORDER_EVENTS_PER_CORE must be a power of 2
+#endif
+
+/* Number of task and queue names remembered so the decoder can label the
+ * handles found in the events. */
+#ifndef configTRACE_RECORDER_MAX_OBJECT_NAMES
+    #define configTRACE_RECORDER_MAX_OBJECT_NAMES    32
+#endif
+
+/* Returns the 32-bit timestamp stored in each event.  Defaults to the run time
+ * stats counter, so it should be fast and of a higher resolution than the tick. */
+#ifndef configTRACE_RECORDER_TIMESTAMP
+    #ifdef portGET_RUN_TIME_COUNTER_VALUE
+        #define configTRACE_RECORDER_TIMESTAMP()    ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+    #else
+        #error configTRACE_RECORDER_TIMESTAMP() must be defined in FreeRTOSConfig.h when configUSE_TRACE_RECORDER is 1 and the port does not provide portGET_RUN_TIME_COUNTER_VALUE()
+    #endif
+#endif
+
+/* Frequency of configTRACE_RECORDER_TIMESTAMP() in Hz, stored in the recorder
+ * header so the decoder can print times in microseconds.  0 means unknown, in
+ * which case the decoder prints raw timestamp units. */
+#ifndef configTRACE_RECORDER_TIMESTAMP_HZ
+    #define configTRACE_RECORDER_TIMESTAMP_HZ    0
+#endif
+
+#define traceRECORDER_MAGIC                            ( 0x52545246UL ) /* "FRTR" when stored little endian. */
+#define traceRECORDER_VERSION                          ( 1U )
+#define traceRECORDER_NAME_LENGTH                      ( 16U )
+
+/* Event IDs.  Keep in sync with tools/freertos_trace_decode.py. */
+#define traceRECORDER_EVENT_TASK_SWITCHED_IN           ( 0x01U ) /* Task, priority. */
+#define traceRECORDER_EVENT_TASK_SWITCHED_OUT          ( 0x02U ) /* Task, priority. */
+#define traceRECORDER_EVENT_TASK_READY                 ( 0x03U ) /* Task, priority. */
+#define traceRECORDER_EVENT_TASK_CREATE                ( 0x04U ) /* Task, priority. */
+#define traceRECORDER_EVENT_TASK_DELETE                ( 0x05U ) /* Task. */
+#define traceRECORDER_EVENT_TASK_SUSPEND               ( 0x06U ) /* Task. */
+#define traceRECORDER_EVENT_TASK_RESUME                ( 0x07U ) /* Task. */
+#define traceRECORDER_EVENT_TASK_RESUME_FROM_ISR       ( 0x08U ) /* Task. */
+#define traceRECORDER_EVENT_TASK_PRIORITY_SET          ( 0x09U ) /* Task, new priority. */
+#define traceRECORDER_EVENT_TASK_PRIORITY_INHERIT      ( 0x0AU ) /* Mutex holder, inherited priority. */
+#define traceRECORDER_EVENT_TASK_PRIORITY_DISINHERIT   ( 0x0BU ) /* Mutex holder, restored priority. */
+#define traceRECORDER_EVENT_TASK_DELAY_UNTIL           ( 0x0CU ) /* -, wake time. */
+#define traceRECORDER_EVENT_QUEUE_CREATE               ( 0x10U ) /* Queue, length. */
+#define traceRECORDER_EVENT_QUEUE_DELETE               ( 0x11U ) /* Queue. */
+#define traceRECORDER_EVENT_QUEUE_SEND                 ( 0x12U ) /* Queue, items before the send. */
+#define traceRECORDER_EVENT_QUEUE_SEND_FAILED          ( 0x13U ) /* Queue, items. */
+#define traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR        ( 0x14U ) /* Queue, items before the send. */
+#define traceRECORDER_EVENT_QUEUE_RECEIVE              ( 0x15U ) /* Queue, items before the receive. */
+#define traceRECORDER_EVENT_QUEUE_RECEIVE_FAILED       ( 0x16U ) /* Queue, items. */
+#define traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR     ( 0x17U ) /* Queue, items before the receive. */
+#define traceRECORDER_EVENT_QUEUE_PEEK                 ( 0x18U ) /* Queue, items. */
+#define traceRECORDER_EVENT_BLOCKING_ON_QUEUE_SEND     ( 0x19U ) /* Queue. */
+#define traceRECORDER_EVENT_BLOCKING_ON_QUEUE_RECEIVE  ( 0x1AU ) /* Queue. */
+#define traceRECORDER_EVENT_BLOCKING_ON_QUEUE_PEEK     ( 0x1BU ) /* Queue. */
+#define traceRECORDER_EVENT_TASK_NOTIFY_TAKE_BLOCK     ( 0x20U ) /* -, notification index. */
+#define traceRECORDER_EVENT_TASK_NOTIFY_WAIT_BLOCK     ( 0x21U ) /* -, notification index. */
+#define traceRECORDER_EVENT_EVENT_GROUP_SET_BITS       ( 0x28U ) /* Event group, bits. */
+#define traceRECORDER_EVENT_EVENT_GROUP_WAIT_BLOCK     ( 0x29U ) /* Event group, bits. */
+#define traceRECORDER_EVENT_BLOCKING_ON_STREAM_SEND    ( 0x2CU ) /* Stream buffer. */
+#define traceRECORDER_EVENT_BLOCKING_ON_STREAM_RECEIVE ( 0x2DU ) /* Stream buffer. */
+#define traceRECORDER_EVENT_TIMER_EXPIRED              ( 0x30U ) /* Timer. */
+#define traceRECORDER_EVENT_MALLOC                     ( 0x34U ) /* Address, size. */
+#define traceRECORDER_EVENT_FREE                       ( 0x35U ) /* Address, size. */
+#define traceRECORDER_EVENT_ISR_ENTER                  ( 0x38U )
+#define traceRECORDER_EVENT_ISR_EXIT                   ( 0x39U )
+#define traceRECORDER_EVENT_ISR_EXIT_TO_SCHEDULER      ( 0x3AU )
+
+/* API events are recorded in pairs.  The enter event holds the object and the
+ * block time (or the value sent), the return event holds the return value. */
+#define traceRECORDER_EVENT_API_RETURN_FLAG            ( 0x80U )
+#define traceRECORDER_EVENT_vTaskDelay                 ( 0x40U )
+#define traceRECORDER_EVENT_xTaskDelayUntil            ( 0x41U )
+#define traceRECORDER_EVENT_xQueueGenericSend          ( 0x42U )
+#define traceRECORDER_EVENT_xQueueReceive              ( 0x43U )
+#define traceRECORDER_EVENT_xQueueSemaphoreTake        ( 0x44U )
+#define traceRECORDER_EVENT_xQueuePeek                 ( 0x45U )
+#define traceRECORDER_EVENT_xQueueGenericSendFromISR   ( 0x46U )
+#define traceRECORDER_EVENT_xQueueGiveFromISR          ( 0x47U )
+#define traceRECORDER_EVENT_xQueueReceiveFromISR       ( 0x48U )
+#define traceRECORDER_EVENT_xTaskGenericNotify         ( 0x49U )
+#define traceRECORDER_EVENT_xTaskGenericNotifyFromISR  ( 0x4AU )
+#define traceRECORDER_EVENT_vTaskGenericNotifyGiveFromISR    ( 0x4BU )
+#define traceRECORDER_EVENT_xTaskGenericNotifyWait     ( 0x4CU )
+#define traceRECORDER_EVENT_ulTaskGenericNotifyTake    ( 0x4DU )
+#define traceRECORDER_EVENT_xEventGroupWaitBits        ( 0x4EU )
+#define traceRECORDER_EVENT_xStreamBufferSend          ( 0x4FU )
+#define traceRECORDER_EVENT_xStreamBufferReceive       ( 0x50U )
+
+/* One recorded event.  16 bytes with no padding.  Handles are truncated to
+ * their low 32 bits on 64-bit hosts. */
+typedef struct xTRACE_EVENT
+{
+    uint32_t ulTimestamp;
+    uint16_t usEventID;
+    uint8_t ucCoreID;
+    uint8_t ucReserved;
+    uint32_t ulHandle;
+    uint32_t ulArgument;
+} TraceEvent_t;
+
+typedef struct xTRACE_OBJECT_NAME
+{
+    uint32_t ulHandle;
+    char cName[ traceRECORDER_NAME_LENGTH ];
+} TraceObjectName_t;
+
+typedef struct xTRACE_CORE_RING
+{
+    volatile uint32_t ulHead; /* Total number of events written to the ring.  The oldest valid event is at ulHead - configTRACE_RECORDER_EVENTS_PER_CORE once it has wrapped. */
+    TraceEvent_t xEvents[ configTRACE_RECORDER_EVENTS_PER_CORE ];
+} TraceCoreRing_t;
+
+/* The layout of this structure is the dump format read by the decoder, so it
+ * only contains 32-bit aligned fields. */
+typedef struct xTRACE_RECORDER
+{
+    uint32_t ulMagic;
+    uint16_t usVersion;
+    uint16_t usEventSize;
+    uint32_t ulEventsPerCore;
+    uint32_t ulNumberOfCores;
+    uint32_t ulTimestampHz;
+    uint32_t ulMaxObjectNames;
+    volatile uint32_t ulEnabled;
+    TraceObjectName_t xObjectNames[ configTRACE_RECORDER_MAX_OBJECT_NAMES ];
+    TraceCoreRing_t xCores[ configNUMBER_OF_CORES ];
+} TraceRecorder_t;
+
+/* Called by vTraceRecorderDump() to write out the recorder contents. */
+typedef void (* TraceRecorderWriteFunction_t)( const void * pvData,
+                                               size_t xLength,
+                                               void * pvContext );
+
+extern TraceRecorder_t xTraceRecorder;
+
+/*
+ * Records one event into the ring of the calling core.  Safe to call from
+ * tasks, ISRs and from inside critical sections.
+ */
+void vTraceRecorderWrite( uint16_t usEventID,
+                          const void * pvHandle,
+                          uint32_t ulArgument );
+
+/*
+ * Associates pcName with pvHandle in the recorder's name table.  The oldest
+ * entry is replaced once the table is full.
+ */
+void vTraceRecorderSetObjectName( const void * pvHandle,
+                                  const char * pcName );
+
+/*
+ * Starts or stops recording.  Recording is enabled from boot.
+ */
+void vTraceRecorderStart( void );
+void vTraceRecorderStop( void );
+
+/*
+ * Discards all recorded events.  Object names are kept.
+ */
+void vTraceRecorderClear( void );
+
+/*
+ * Stops recording, passes the whole recorder to pxWriteFunction (for example to
+ * write it to a UART or a file) and then restores the previous recording state.
+ * The output can be fed directly to tools/freertos_trace_decode.py.
+ */
+void vTraceRecorderDump( TraceRecorderWriteFunction_t pxWriteFunction,
+                         void * pvContext );
+
+/*-----------------------------------------------------------*/
+
+#define traceRECORDER_HANDLE( x )         ( ( const void * ) ( x ) )
+#define traceRECORDER_VALUE( x )          ( ( uint32_t ) ( x ) )
+#define traceRECORDER_ENTER( xAPI, xHandle, xValue ) \
+    vTraceRecorderWrite( traceRECORDER_EVENT_ ## xAPI, traceRECORDER_HANDLE( xHandle ), traceRECORDER_VALUE( xValue ) )
+#define traceRECORDER_RETURN( xAPI, xValue ) \
+    vTraceRecorderWrite( ( uint16_t ) ( traceRECORDER_EVENT_ ## xAPI | traceRECORDER_EVENT_API_RETURN_FLAG ), NULL, traceRECORDER_VALUE( xValue ) )
+
+#ifndef traceTASK_SWITCHED_IN
+    #define traceTASK_SWITCHED_IN()    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_SWITCHED_IN, traceRECORDER_HANDLE( pxCurrentTCB ), traceRECORDER_VALUE( pxCurrentTCB->uxPriority ) )
+#endif
+
+#ifndef traceTASK_SWITCHED_OUT
+    #define traceTASK_SWITCHED_OUT()    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_SWITCHED_OUT, traceRECORDER_HANDLE( pxCurrentTCB ), traceRECORDER_VALUE( pxCurrentTCB->uxPriority ) )
+#endif
+
+#ifndef traceMOVED_TASK_TO_READY_STATE
+    #define traceMOVED_TASK_TO_READY_STATE( pxTCB )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_READY, traceRECORDER_HANDLE( pxTCB ), traceRECORDER_VALUE( ( pxTCB )->uxPriority ) )
+#endif
+
+#ifndef traceTASK_CREATE
+    #define traceTASK_CREATE( pxNewTCB )                                                                                                       \
+    do {                                                                                                                                        \
+        vTraceRecorderSetObjectName( ( pxNewTCB ), ( pxNewTCB )->pcTaskName );                                                                  \
+        vTraceRecorderWrite( traceRECORDER_EVENT_TASK_CREATE, traceRECORDER_HANDLE( pxNewTCB ), traceRECORDER_VALUE( ( pxNewTCB )->uxPriority ) ); \
+    } while( 0 )
+#endif
+
+#ifndef traceTASK_DELETE
+    #define traceTASK_DELETE( pxTaskToDelete )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_DELETE, traceRECORDER_HANDLE( pxTaskToDelete ), 0U )
+#endif
+
+#ifndef traceTASK_SUSPEND
+    #define traceTASK_SUSPEND( pxTaskToSuspend )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_SUSPEND, traceRECORDER_HANDLE( pxTaskToSuspend ), 0U )
+#endif
+
+#ifndef traceTASK_RESUME
+    #define traceTASK_RESUME( pxTaskToResume )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_RESUME, traceRECORDER_HANDLE( pxTaskToResume ), 0U )
+#endif
+
+#ifndef traceTASK_RESUME_FROM_ISR
+    #define traceTASK_RESUME_FROM_ISR( pxTaskToResume )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_RESUME_FROM_ISR, traceRECORDER_HANDLE( pxTaskToResume ), 0U )
+#endif
+
+#ifndef traceTASK_PRIORITY_SET
+    #define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_PRIORITY_SET, traceRECORDER_HANDLE( pxTask ), traceRECORDER_VALUE( uxNewPriority ) )
+#endif
+
+#ifndef traceTASK_PRIORITY_INHERIT
+    #define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_PRIORITY_INHERIT, traceRECORDER_HANDLE( pxTCBOfMutexHolder ), traceRECORDER_VALUE( uxInheritedPriority ) )
+#endif
+
+#ifndef traceTASK_PRIORITY_DISINHERIT
+    #define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_PRIORITY_DISINHERIT, traceRECORDER_HANDLE( pxTCBOfMutexHolder ), traceRECORDER_VALUE( uxOriginalPriority ) )
+#endif
+
+#ifndef traceTASK_DELAY_UNTIL
+    #define traceTASK_DELAY_UNTIL( x )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_DELAY_UNTIL, NULL, traceRECORDER_VALUE( x ) )
+#endif
+
+#ifndef traceQUEUE_CREATE
+    #define traceQUEUE_CREATE( pxNewQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_QUEUE_CREATE, traceRECORDER_HANDLE( pxNewQueue ), traceRECORDER_VALUE( ( pxNewQueue )->uxLength ) )
+#endif
+
+#ifndef traceQUEUE_DELETE
+    #define traceQUEUE_DELETE( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_QUEUE_DELETE, traceRECORDER_HANDLE( pxQueue ), 0U )
+#endif
+
+#ifndef traceQUEUE_REGISTRY_ADD
+    #define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )    vTraceRecorderSetObjectName( ( xQueue ), ( pcQueueName ) )
+#endif
+
+#ifndef traceQUEUE_SEND
+    #define traceQUEUE_SEND( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_QUEUE_SEND, traceRECORDER_HANDLE( pxQueue ), traceRECORDER_VALUE( ( pxQueue )->uxMessagesWaiting ) )
+#endif
+
+#ifndef traceQUEUE_SEND_FAILED
+    #define traceQUEUE_SEND_FAILED( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_QUEUE_SEND_FAILED, traceRECORDER_HANDLE( pxQueue ), traceRECORDER_VALUE( ( pxQueue )->uxMessagesWaiting ) )
+#endif
+
+#ifndef traceQUEUE_SEND_FROM_ISR
+    #define traceQUEUE_SEND_FROM_ISR( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR, traceRECORDER_HANDLE( pxQueue ), traceRECORDER_VALUE( ( pxQueue )->uxMessagesWaiting ) )
+#endif
+
+#ifndef traceQUEUE_RECEIVE
+    #define traceQUEUE_RECEIVE( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_QUEUE_RECEIVE, traceRECORDER_HANDLE( pxQueue ), traceRECORDER_VALUE( ( pxQueue )->uxMessagesWaiting ) )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FAILED
+    #define traceQUEUE_RECEIVE_FAILED( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_QUEUE_RECEIVE_FAILED, traceRECORDER_HANDLE( pxQueue ), traceRECORDER_VALUE( ( pxQueue )->uxMessagesWaiting ) )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FROM_ISR
+    #define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR, traceRECORDER_HANDLE( pxQueue ), traceRECORDER_VALUE( ( pxQueue )->uxMessagesWaiting ) )
+#endif
+
+#ifndef traceQUEUE_PEEK
+    #define traceQUEUE_PEEK( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_QUEUE_PEEK, traceRECORDER_HANDLE( pxQueue ), traceRECORDER_VALUE( ( pxQueue )->uxMessagesWaiting ) )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_SEND
+    #define traceBLOCKING_ON_QUEUE_SEND( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_BLOCKING_ON_QUEUE_SEND, traceRECORDER_HANDLE( pxQueue ), 0U )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_RECEIVE
+    #define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_BLOCKING_ON_QUEUE_RECEIVE, traceRECORDER_HANDLE( pxQueue ), 0U )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_PEEK
+    #define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )    vTraceRecorderWrite( traceRECORDER_EVENT_BLOCKING_ON_QUEUE_PEEK, traceRECORDER_HANDLE( pxQueue ), 0U )
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+    #define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_NOTIFY_TAKE_BLOCK, NULL, traceRECORDER_VALUE( uxIndexToWait ) )
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT_BLOCK
+    #define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )    vTraceRecorderWrite( traceRECORDER_EVENT_TASK_NOTIFY_WAIT_BLOCK, NULL, traceRECORDER_VALUE( uxIndexToWait ) )
+#endif
+
+#ifndef traceEVENT_GROUP_SET_BITS
+    #define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )    vTraceRecorderWrite( traceRECORDER_EVENT_EVENT_GROUP_SET_BITS, traceRECORDER_HANDLE( xEventGroup ), traceRECORDER_VALUE( uxBitsToSet ) )
+#endif
+
+#ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+    #define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )    vTraceRecorderWrite( traceRECORDER_EVENT_EVENT_GROUP_WAIT_BLOCK, traceRECORDER_HANDLE( xEventGroup ), traceRECORDER_VALUE( uxBitsToWaitFor ) )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+    #define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )    vTraceRecorderWrite( traceRECORDER_EVENT_BLOCKING_ON_STREAM_SEND, traceRECORDER_HANDLE( xStreamBuffer ), 0U )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+    #define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )    vTraceRecorderWrite( traceRECORDER_EVENT_BLOCKING_ON_STREAM_RECEIVE, traceRECORDER_HANDLE( xStreamBuffer ), 0U )
+#endif
+
+#ifndef traceTIMER_EXPIRED
+    #define traceTIMER_EXPIRED( pxTimer )    vTraceRecorderWrite( traceRECORDER_EVENT_TIMER_EXPIRED, traceRECORDER_HANDLE( pxTimer ), 0U )
+#endif
+
+#ifndef traceMALLOC
+    #define traceMALLOC( pvAddress, uiSize )    vTraceRecorderWrite( traceRECORDER_EVENT_MALLOC, traceRECORDER_HANDLE( pvAddress ), traceRECORDER_VALUE( uiSize ) )
+#endif
+
+#ifndef traceFREE
+    #define traceFREE( pvAddress, uiSize )    vTraceRecorderWrite( traceRECORDER_EVENT_FREE, traceRECORDER_HANDLE( pvAddress ), traceRECORDER_VALUE( uiSize ) )
+#endif
+
+#ifndef traceISR_ENTER
+    #define traceISR_ENTER()    vTraceRecorderWrite( traceRECORDER_EVENT_ISR_ENTER, NULL, 0U )
+#endif
+
+#ifndef traceISR_EXIT
+    #define traceISR_EXIT()    vTraceRecorderWrite( traceRECORDER_EVENT_ISR_EXIT, NULL, 0U )
+#endif
+
+#ifndef traceISR_EXIT_TO_SCHEDULER
+    #define traceISR_EXIT_TO_SCHEDULER()    vTraceRecorderWrite( traceRECORDER_EVENT_ISR_EXIT_TO_SCHEDULER, NULL, 0U )
+#endif
+
+#ifndef traceENTER_vTaskDelay
+    #define traceENTER_vTaskDelay( xTicksToDelay )    traceRECORDER_ENTER( vTaskDelay, NULL, xTicksToDelay )
+#endif
+
+#ifndef traceRETURN_vTaskDelay
+    #define traceRETURN_vTaskDelay()    traceRECORDER_RETURN( vTaskDelay, 0U )
+#endif
+
+#ifndef traceENTER_xTaskDelayUntil
+    #define traceENTER_xTaskDelayUntil( pxPreviousWakeTime, xTimeIncrement )    traceRECORDER_ENTER( xTaskDelayUntil, NULL, xTimeIncrement )
+#endif
+
+#ifndef traceRETURN_xTaskDelayUntil
+    #define traceRETURN_xTaskDelayUntil( xShouldDelay )    traceRECORDER_RETURN( xTaskDelayUntil, xShouldDelay )
+#endif
+
+#ifndef traceENTER_xQueueGenericSend
+    #define traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition )    traceRECORDER_ENTER( xQueueGenericSend, xQueue, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueGenericSend
+    #define traceRETURN_xQueueGenericSend( xReturn )    traceRECORDER_RETURN( xQueueGenericSend, xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceive
+    #define traceENTER_xQueueReceive( xQueue, pvBuffer, xTicksToWait )    traceRECORDER_ENTER( xQueueReceive, xQueue, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReceive
+    #define traceRETURN_xQueueReceive( xReturn )    traceRECORDER_RETURN( xQueueReceive, xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSemaphoreTake
+    #define traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait )    traceRECORDER_ENTER( xQueueSemaphoreTake, xQueue, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueSemaphoreTake
+    #define traceRETURN_xQueueSemaphoreTake( xReturn )    traceRECORDER_RETURN( xQueueSemaphoreTake, xReturn )
+#endif
+
+#ifndef traceENTER_xQueuePeek
+    #define traceENTER_xQueuePeek( xQueue, pvBuffer, xTicksToWait )    traceRECORDER_ENTER( xQueuePeek, xQueue, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueuePeek
+    #define traceRETURN_xQueuePeek( xReturn )    traceRECORDER_RETURN( xQueuePeek, xReturn )
+#endif
+
+#ifndef traceENTER_xQueueGenericSendFromISR
+    #define traceENTER_xQueueGenericSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken, xCopyPosition )    traceRECORDER_ENTER( xQueueGenericSendFromISR, xQueue, xCopyPosition )
+#endif
+
+#ifndef traceRETURN_xQueueGenericSendFromISR
+    #define traceRETURN_xQueueGenericSendFromISR( xReturn )    traceRECORDER_RETURN( xQueueGenericSendFromISR, xReturn )
+#endif
+
+#ifndef traceENTER_xQueueGiveFromISR
+    #define traceENTER_xQueueGiveFromISR( xQueue, pxHigherPriorityTaskWoken )    traceRECORDER_ENTER( xQueueGiveFromISR, xQueue, 0U )
+#endif
+
+#ifndef traceRETURN_xQueueGiveFromISR
+    #define traceRETURN_xQueueGiveFromISR( xReturn )    traceRECORDER_RETURN( xQueueGiveFromISR, xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveFromISR
+    #define traceENTER_xQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken )    traceRECORDER_ENTER( xQueueReceiveFromISR, xQueue, 0U )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveFromISR
+    #define traceRETURN_xQueueReceiveFromISR( xReturn )    traceRECORDER_RETURN( xQueueReceiveFromISR, xReturn )
+#endif
+
+#ifndef traceENTER_xTaskGenericNotify
+    #define traceENTER_xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue )    traceRECORDER_ENTER( xTaskGenericNotify, xTaskToNotify, ulValue )
+#endif
+
+#ifndef traceRETURN_xTaskGenericNotify
+    #define traceRETURN_xTaskGenericNotify( xReturn )    traceRECORDER_RETURN( xTaskGenericNotify, xReturn )
+#endif
+
+#ifndef traceENTER_xTaskGenericNotifyFromISR
+    #define traceENTER_xTaskGenericNotifyFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken )    traceRECORDER_ENTER( xTaskGenericNotifyFromISR, xTaskToNotify, ulValue )
+#endif
+
+#ifndef traceRETURN_xTaskGenericNotifyFromISR
+    #define traceRETURN_xTaskGenericNotifyFromISR( xReturn )    traceRECORDER_RETURN( xTaskGenericNotifyFromISR, xReturn )
+#endif
+
+#ifndef traceENTER_vTaskGenericNotifyGiveFromISR
+    #define traceENTER_vTaskGenericNotifyGiveFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken )    traceRECORDER_ENTER( vTaskGenericNotifyGiveFromISR, xTaskToNotify, uxIndexToNotify )
+#endif
+
+#ifndef traceRETURN_vTaskGenericNotifyGiveFromISR
+    #define traceRETURN_vTaskGenericNotifyGiveFromISR()    traceRECORDER_RETURN( vTaskGenericNotifyGiveFromISR, 0U )
+#endif
+
+#ifndef traceENTER_xTaskGenericNotifyWait
+    #define traceENTER_xTaskGenericNotifyWait( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait )    traceRECORDER_ENTER( xTaskGenericNotifyWait, NULL, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xTaskGenericNotifyWait
+    #define traceRETURN_xTaskGenericNotifyWait( xReturn )    traceRECORDER_RETURN( xTaskGenericNotifyWait, xReturn )
+#endif
+
+#ifndef traceENTER_ulTaskGenericNotifyTake
+    #define traceENTER_ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait )    traceRECORDER_ENTER( ulTaskGenericNotifyTake, NULL, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_ulTaskGenericNotifyTake
+    #define traceRETURN_ulTaskGenericNotifyTake( ulReturn )    traceRECORDER_RETURN( ulTaskGenericNotifyTake, ulReturn )
+#endif
+
+#ifndef traceENTER_xEventGroupWaitBits
+    #define traceENTER_xEventGroupWaitBits( xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, xTicksToWait )    traceRECORDER_ENTER( xEventGroupWaitBits, xEventGroup, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xEventGroupWaitBits
+    #define traceRETURN_xEventGroupWaitBits( uxReturn )    traceRECORDER_RETURN( xEventGroupWaitBits, uxReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferSend
+    #define traceENTER_xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait )    traceRECORDER_ENTER( xStreamBufferSend, xStreamBuffer, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSend
+    #define traceRETURN_xStreamBufferSend( xReturn )    traceRECORDER_RETURN( xStreamBufferSend, xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferReceive
+    #define traceENTER_xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait )    traceRECORDER_ENTER( xStreamBufferReceive, xStreamBuffer, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceive
+    #define traceRETURN_xStreamBufferReceive( xReceivedLength )    traceRECORDER_RETURN( xStreamBufferReceive, xReceivedLength )
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_TRACE_H */
@@ -150,8 +150,18 @@ typedef struct HeapRegion
 {
     uint8_t * pucStartAddress;
     size_t xSizeInBytes;
+    #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+        UBaseType_t uxMemoryClass; /* The memory class of the region, from 0 to configHEAP_NUMBER_OF_MEMORY_CLASSES - 1. */
+    #endif
 } HeapRegion_t;
 
+#if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+
+/* Masks of memory classes passed to pvPortMallocFromClass(). */
+    #define portHEAP_MEMORY_CLASS_BIT( uxMemoryClass )    ( ( UBaseType_t ) 1U << ( uxMemoryClass ) )
+    #define portHEAP_ALL_MEMORY_CLASSES                   ( ~( UBaseType_t ) 0U )
+#endif
+
 /* Used to pass information about the heap out of vPortGetHeapStats(). */
 typedef struct xHeapStats
 {
@@ -162,8 +172,26 @@ typedef struct xHeapStats
     size_t xMinimumEverFreeBytesRemaining;  /* The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
     size_t xNumberOfSuccessfulAllocations;  /* The number of calls to pvPortMalloc() that have returned a valid memory block. */
     size_t xNumberOfSuccessfulFrees;        /* The number of calls to vPortFree() that has successfully freed a block of memory. */
+    size_t xNumberOfInPlaceReallocations;   /* The number of calls to pvPortRealloc() that resized a block without moving it. */
+    size_t xNumberOfMovedReallocations;     /* The number of calls to pvPortRealloc() that moved a block to a new address to resize it. */
 } HeapStats_t;
 
+/* Used to pass information about an allocated block out of
+ * uxPortWalkHeapAllocations(). */
+typedef struct xHeapAllocation
+{
+    void * pvAddress;                    /* The address returned by pvPortMalloc(). */
+    size_t xBlockSize;                   /* The size of the block, including its header and any alignment padding. */
+    struct tskTaskControlBlock * xOwner; /* The task that allocated the block, or NULL if the block was allocated before the scheduler was started.  The task may since have been deleted. */
+    void * pvCaller;                     /* The return address of the pvPortMalloc() or pvPortCalloc() call that allocated the block. */
+    TickType_t xTimestamp;               /* The tick count when the block was allocated. */
+} HeapAllocation_t;
+
+/* Called by uxPortWalkHeapAllocations() for each allocated block.  Return
+ * pdFALSE to end the walk early. */
+typedef BaseType_t ( * HeapAllocationWalkFunction_t )( const HeapAllocation_t * pxAllocation,
+                                                       void * pvContext );
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -183,6 +211,43 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t * pxHeapStats );
 
+/*
+ * Allocates a block from a heap_5 region of memory class uxMemoryClass.  If no
+ * region of that class has a large enough free block then the block is
+ * allocated from a region of any of the classes in the uxFallbackClasses mask
+ * (built with portHEAP_MEMORY_CLASS_BIT()) instead - pass 0 to fail rather than
+ * fall back, or portHEAP_ALL_MEMORY_CLASSES to fall back to any region.  Only
+ * available when configHEAP_NUMBER_OF_MEMORY_CLASSES is greater than 1.
+ *
+ * pvPortMalloc() allocates from regions of any class.  pvPortRealloc() keeps a
+ * block in its memory class when the block has to move, if there is room.
+ *
+ * vPortGetHeapStatsForClass() returns the heap statistics of the regions of
+ * one memory class.  Allocations, frees and reallocations are counted in the
+ * class of the block allocated, freed or reallocated.
+ */
+#if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+    void * pvPortMallocFromClass( size_t xWantedSize,
+                                  UBaseType_t uxMemoryClass,
+                                  UBaseType_t uxFallbackClasses ) PRIVILEGED_FUNCTION;
+    void vPortGetHeapStatsForClass( UBaseType_t uxMemoryClass,
+                                    HeapStats_t * pxHeapStats );
+#endif
+
+/*
+ * Calls pxWalkFunction for each block that is currently allocated, most
+ * recently allocated first, and returns the number of blocks walked.  Only
+ * available in heap_4.c and heap_5.c when configHEAP_TRACK_ALLOCATIONS is 1.
+ *
+ * The walk is made with the scheduler suspended, so pxWalkFunction must not
+ * block, or allocate or free heap memory.  pxWalkFunction can be NULL to just
+ * count the allocated blocks.
+ */
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+    UBaseType_t uxPortWalkHeapAllocations( HeapAllocationWalkFunction_t pxWalkFunction,
+                                           void * pvContext ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -195,6 +260,33 @@ size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 void xPortResetHeapMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Resizes a block allocated by pvPortMalloc(), keeping its contents up to the
+ * smaller of the old and new sizes.  Only provided by heap_4.c and heap_5.c.
+ *
+ * The block is resized where it is when it shrinks, or when it grows and the
+ * block after it is free and large enough - otherwise a new block is allocated,
+ * the contents copied and the old block freed.  Returns the address of the
+ * resized block, or NULL, leaving the original block allocated, if there is not
+ * enough memory.  pv NULL allocates a new block, and xWantedSize 0 frees pv and
+ * returns NULL.
+ */
+void * pvPortRealloc( void * pv,
+                      size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocates a block whose address is a multiple of xAlignment, which must be a
+ * power of two - for example for cache line or DMA aligned buffers.  Only
+ * provided by heap_4.c and heap_5.c.
+ *
+ * The block is carved from a free block at the first aligned address, and the
+ * bytes skipped to reach it are left in the list of free blocks rather than
+ * wasted.  Free the block with vPortFreeAligned() (or vPortFree()).
+ */
+void * pvPortMallocAligned( size_t xWantedSize,
+                            size_t xAlignment ) PRIVILEGED_FUNCTION;
+void vPortFreeAligned( void * pv ) PRIVILEGED_FUNCTION;
+
 #if ( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
     void * pvPortMallocStack( size_t xSize ) PRIVILEGED_FUNCTION;
     void vPortFreeStack( void * pv ) PRIVILEGED_FUNCTION;
@@ -68,6 +68,7 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
 #define queueOVERWRITE                        ( ( BaseType_t ) 2 )
+#define queueOVERWRITE_OLDEST                 ( ( BaseType_t ) 3 )
 
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE                  ( ( uint8_t ) 0U )
@@ -76,6 +77,7 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE      ( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX       ( ( uint8_t ) 4U )
 #define queueQUEUE_TYPE_SET                   ( ( uint8_t ) 5U )
+#define queueQUEUE_TYPE_RW_LOCK               ( ( uint8_t ) 6U )
 
 typedef struct xQUEUE_STATUS
 {
@@ -608,6 +610,52 @@ typedef struct xQUEUE_STATUS
 #define xQueueOverwrite( xQueue, pvItemToQueue ) \
     xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE )
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueOverwriteOldest(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue
+ *                       );
+ * @endcode
+ *
+ * Only for use with queues that can hold more than one item - use
+ * xQueueOverwrite() with queues that have a length of one.
+ * configUSE_QUEUE_OVERWRITE_OLDEST must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * Posts an item to the back of a queue.  If the queue is already full the
+ * oldest item in the queue is discarded to make room, in the same critical
+ * section, and the queue's overrun count is incremented - see
+ * uxQueueGetOverrunCount().  The queue then holds the most recent items sent
+ * to it, which suits producers of periodic samples where only the freshest
+ * ones matter.
+ *
+ * This function must not be called from an interrupt service routine.
+ * See xQueueOverwriteOldestFromISR() for an alternative which may be used in
+ * an ISR.
+ *
+ * @param xQueue The handle of the queue to which the data is being sent.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.  The size of the items the queue will hold was defined when the
+ * queue was created, so this many bytes will be copied from pvItemToQueue
+ * into the queue storage area.
+ *
+ * @return xQueueOverwriteOldest() is a macro that calls xQueueGenericSend(),
+ * and therefore has the same return values as xQueueSendToBack().  However,
+ * pdPASS is the only value that can be returned because
+ * xQueueOverwriteOldest() will write to the queue even when the queue is
+ * already full.
+ *
+ * \defgroup xQueueOverwriteOldest xQueueOverwriteOldest
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+    #define xQueueOverwriteOldest( xQueue, pvItemToQueue ) \
+        xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE_OLDEST )
+#endif
+
 
 /**
  * queue. h
@@ -962,6 +1010,28 @@ UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue ) PRIVILEGED_FUNC
 UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
 UBaseType_t uxQueueSpacesAvailableFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueGetOverrunCount( const QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Return the number of items xQueueOverwriteOldest() and
+ * xQueueOverwriteOldestFromISR() have discarded from a queue since the queue
+ * was created.  The count wraps on overflow, so subtract an earlier reading to
+ * obtain the number of items lost in between.  Can be called from an ISR.
+ *
+ * @param xQueue A handle to the queue being queried.
+ *
+ * @return The number of items discarded from the queue.
+ *
+ * \defgroup uxQueueGetOverrunCount uxQueueGetOverrunCount
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+    UBaseType_t uxQueueGetOverrunCount( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
 /**
  * queue. h
  * @code{c}
@@ -1212,6 +1282,36 @@ void vQueueDelete( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 #define xQueueOverwriteFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
     xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueOVERWRITE )
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueOverwriteOldestFromISR(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue,
+ *                            BaseType_t *pxHigherPriorityTaskWoken
+ *                       );
+ * @endcode
+ *
+ * A version of xQueueOverwriteOldest() that can be used in an interrupt service
+ * routine (ISR).
+ *
+ * @param pxHigherPriorityTaskWoken xQueueOverwriteOldestFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending to the queue caused a task
+ * to unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If xQueueOverwriteOldestFromISR() sets this value to pdTRUE
+ * then a context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS, as xQueueOverwriteOldestFromISR() writes to the queue even
+ * when the queue is already full.
+ *
+ * \defgroup xQueueOverwriteOldestFromISR xQueueOverwriteOldestFromISR
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+    #define xQueueOverwriteOldestFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
+        xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueOVERWRITE_OLDEST )
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -1514,6 +1614,17 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
                                            StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType,
+                                                const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType,
+                                                      const UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_COUNTING_SEMAPHORES == 1 )
     QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                                  const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
@@ -1528,11 +1639,49 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use xSemaphoreGiveN(), xSemaphoreTakeN(),
+ * xSemaphoreGiveNFromISR() and xSemaphoreTakeNFromISR() instead of calling
+ * these functions directly.
+ */
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+    BaseType_t xQueueSemaphoreGiveN( QueueHandle_t xQueue,
+                                     const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+    BaseType_t xQueueSemaphoreTakeN( QueueHandle_t xQueue,
+                                     const UBaseType_t uxCount,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    BaseType_t xQueueSemaphoreGiveNFromISR( QueueHandle_t xQueue,
+                                            const UBaseType_t uxCount,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+    BaseType_t xQueueSemaphoreTakeNFromISR( QueueHandle_t xQueue,
+                                            const UBaseType_t uxCount,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
     TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * For internal use only.  Use vSemaphoreGetMutexSpinStats() instead of calling
+ * this function directly.
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+
+/* Counts of how the takes of a mutex that found it held were completed, see
+ * configMUTEX_SPIN_ITERATIONS. */
+    typedef struct xMUTEX_SPIN_STATS
+    {
+        UBaseType_t uxSpins;            /* The number of takes that polled the mutex while its holder was running. */
+        UBaseType_t uxSpinAcquisitions; /* The number of those takes that saw the mutex given while polling. */
+        UBaseType_t uxBlocks;           /* The number of times a task entered the Blocked state to wait for the mutex. */
+    } MutexSpinStats_t;
+
+    void vQueueGetMutexSpinStats( QueueHandle_t xMutex,
+                                  MutexSpinStats_t * pxSpinStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Use xSemaphoreTakeRecursive() or
  * xSemaphoreGiveRecursive() instead of calling these functions directly.
@@ -1541,6 +1690,29 @@ BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex,
                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use the macros in rwlock.h instead of calling these
+ * functions directly.
+ */
+#if ( configUSE_RW_LOCKS == 1 )
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        QueueHandle_t xQueueCreateRWLock( void ) PRIVILEGED_FUNCTION;
+    #endif
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        QueueHandle_t xQueueCreateRWLockStatic( StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+    #endif
+
+    BaseType_t xQueueTakeRWLock( QueueHandle_t xRWLock,
+                                 const BaseType_t xWrite,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    BaseType_t xQueueGiveRWLock( QueueHandle_t xRWLock,
+                                 const BaseType_t xWrite ) PRIVILEGED_FUNCTION;
+    BaseType_t xQueueTakeRWLockReadFromISR( QueueHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+    BaseType_t xQueueGiveRWLockReadFromISR( QueueHandle_t xRWLock,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_RW_LOCKS */
+
 /*
  * Reset a queue back to its original empty state.  The return value is now
  * obsolete and is always set to pdPASS.
@@ -1759,6 +1931,50 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
                                             StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+/* The maximum number of priorities a priority queue set can have - one per bit
+ * of the ready bitmap. */
+#define queuePRIORITY_SET_MAX_PRIORITIES    ( ( UBaseType_t ) ( sizeof( UBaseType_t ) * 8U ) )
+
+/*
+ * Creates a priority queue set.  configUSE_PRIORITY_QUEUE_SETS must be set to 1
+ * in FreeRTOSConfig.h for xQueueCreatePrioritySet() and
+ * xQueueCreatePrioritySetStatic() to be available.
+ *
+ * A queue set created by xQueueCreateSet() holds the handle of a member each
+ * time an item is sent to that member, so it must be long enough to hold every
+ * item every member can hold, and xQueueSelectFromSet() returns the members in
+ * the order the items were sent.  A priority queue set instead holds one bit
+ * and one handle per member.  Each member is added with its own priority using
+ * xQueueAddToPrioritySet(), a send to the member only sets its bit, and
+ * xQueueSelectFromSet() returns the highest priority member that holds data
+ * (or, for a semaphore, is available).
+ *
+ * xQueueSelectFromSet() does not remove anything from a priority queue set, so
+ * unlike a queue set created by xQueueCreateSet() its members can be read
+ * without first being selected, and can be added or removed while they hold
+ * data.  A member that is read by another task after being selected may be
+ * empty by the time it is read, so read with a block time of 0.
+ *
+ * The static version stores uxNumberOfPriorities member handles in
+ * pucQueueStorage, which must be at least
+ * uxNumberOfPriorities * sizeof( QueueSetMemberHandle_t ) bytes.
+ *
+ * @param uxNumberOfPriorities The number of members the set can hold, each
+ * with a priority from 0 to uxNumberOfPriorities - 1.  Must not be more than
+ * queuePRIORITY_SET_MAX_PRIORITIES.
+ *
+ * @return The handle of the queue set, or NULL if it could not be created.
+ */
+#if ( ( configUSE_PRIORITY_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueSetHandle_t xQueueCreatePrioritySet( const UBaseType_t uxNumberOfPriorities ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_PRIORITY_QUEUE_SETS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueSetHandle_t xQueueCreatePrioritySetStatic( const UBaseType_t uxNumberOfPriorities,
+                                                    uint8_t * pucQueueStorage,
+                                                    StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Adds a queue or semaphore to a queue set that was previously created by a
  * call to xQueueCreateSet() or xQueueCreateSetStatic().
@@ -1786,9 +2002,36 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
                                QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * Adds a queue or semaphore to a priority queue set that was previously created
+ * by a call to xQueueCreatePrioritySet() or xQueueCreatePrioritySetStatic().
+ * Members of a priority queue set are removed with xQueueRemoveFromSet().
+ *
+ * @param xQueueOrSemaphore The handle of the queue or semaphore being added to
+ * the priority queue set (cast to an QueueSetMemberHandle_t type).  It may
+ * already hold data.
+ *
+ * @param xQueueSet The handle of the priority queue set to which the queue or
+ * semaphore is being added.
+ *
+ * @param uxPriority The priority of the member within the set.  When more than
+ * one member holds data xQueueSelectFromSet() returns the member with the
+ * highest priority.  Must be less than the number of priorities the set was
+ * created with, and not already used by another member of the set.
+ *
+ * @return pdPASS if the queue or semaphore was added to the set.  pdFAIL if it
+ * is already a member of a queue set or uxPriority is already in use.
+ */
+#if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+    BaseType_t xQueueAddToPrioritySet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                                       QueueSetHandle_t xQueueSet,
+                                       UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Removes a queue or semaphore from a queue set.  A queue or semaphore can only
- * be removed from a set if the queue or semaphore is empty.
+ * be removed from a set if the queue or semaphore is empty, unless the set is a
+ * priority queue set.
  *
  * See FreeRTOS/Source/Demo/Common/Minimal/QueueSet.c for an example using this
  * function.
@@ -1840,7 +2083,9 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * a QueueSetMemberHandle_t type) contained in the queue set that contains data,
  * or the handle of a semaphore (cast to a QueueSetMemberHandle_t type) contained
  * in the queue set that is available, or NULL if no such queue or semaphore
- * exists before before the specified block time expires.
+ * exists before before the specified block time expires.  If xQueueSet is a
+ * priority queue set the member returned is the highest priority member that
+ * contains data or is available.
  */
 #if ( configUSE_QUEUE_SETS == 1 )
     QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
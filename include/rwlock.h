@@ -0,0 +1,236 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef RW_LOCK_H
+#define RW_LOCK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include rwlock.h"
+#endif
+
+#include "queue.h"
+
+#if ( configUSE_RW_LOCKS != 1 )
+    #error configUSE_RW_LOCKS must be set to 1 in FreeRTOSConfig.h to use reader-writer locks
+#endif
+
+/*
+ * A reader-writer lock can be held by any number of readers at once, or by a
+ * single writer.
+ *
+ * - Writers are not starved by readers.  Once a writer is waiting for the
+ *   lock, tasks that then want to read wait behind it.
+ * - Readers are not starved by writers.  When a writer gives the lock, it
+ *   passes it to every reader that was waiting, ahead of the next writer.
+ * - A task that blocks on a lock held by a writer raises the priority of the
+ *   writer to its own, as with a mutex.  Readers do not inherit priority, as
+ *   the lock does not record which tasks are reading.
+ *
+ * Reader-writer locks are implemented with the queue mechanism, and each one
+ * uses the same amount of RAM as a mutex.
+ */
+typedef QueueHandle_t RWLockHandle_t;
+
+/**
+ * rwlock.h
+ * @code{c}
+ * RWLockHandle_t xRWLockCreate( void );
+ * @endcode
+ *
+ * Creates a reader-writer lock, and returns a handle by which the lock can be
+ * referenced.  The memory the lock needs is allocated from the FreeRTOS heap.
+ *
+ * @return If the lock was created successfully then a handle to the lock is
+ * returned.  If there was not enough heap to allocate the lock then NULL is
+ * returned.
+ *
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLocks
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    #define xRWLockCreate()    xQueueCreateRWLock()
+#endif
+
+/**
+ * rwlock.h
+ * @code{c}
+ * RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxRWLockBuffer );
+ * @endcode
+ *
+ * As xRWLockCreate(), but with the memory the lock needs provided by the
+ * application in pxRWLockBuffer, which must persist for the lifetime of the
+ * lock.
+ *
+ * \defgroup xRWLockCreateStatic xRWLockCreateStatic
+ * \ingroup RWLocks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    #define xRWLockCreateStatic( pxRWLockBuffer )    xQueueCreateRWLockStatic( ( pxRWLockBuffer ) )
+#endif
+
+/**
+ * rwlock.h
+ * @code{c}
+ * void vRWLockDelete( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Delete a reader-writer lock.  Do not delete a lock that is held or has
+ * tasks blocked on it.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLocks
+ */
+#define vRWLockDelete( xRWLock )    vQueueDelete( ( QueueHandle_t ) ( xRWLock ) )
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xBlockTime );
+ * @endcode
+ *
+ * Take the lock for reading.  Waits while a writer holds the lock or is
+ * waiting for it.  A task must not take a lock for reading that it already
+ * holds for writing.
+ *
+ * @param xRWLock A handle to the lock.
+ *
+ * @param xBlockTime The time in ticks to wait for the lock.
+ *
+ * @return pdTRUE if the lock was taken, pdFALSE if xBlockTime expired first.
+ *
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLocks
+ */
+#define xRWLockTakeRead( xRWLock, xBlockTime )    xQueueTakeRWLock( ( xRWLock ), pdFALSE, ( xBlockTime ) )
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Give back a lock taken with xRWLockTakeRead() or xRWLockTakeReadFromISR().
+ * The last reader to give the lock back wakes the writer waiting for it, if
+ * any.
+ *
+ * @return pdTRUE if the lock was given, pdFALSE if no reader held it.
+ *
+ * \defgroup xRWLockGiveRead xRWLockGiveRead
+ * \ingroup RWLocks
+ */
+#define xRWLockGiveRead( xRWLock )    xQueueGiveRWLock( ( xRWLock ), pdFALSE )
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xBlockTime );
+ * @endcode
+ *
+ * Take the lock for writing.  Waits while the lock is held by another writer
+ * or by any reader.
+ *
+ * @param xRWLock A handle to the lock.
+ *
+ * @param xBlockTime The time in ticks to wait for the lock.
+ *
+ * @return pdTRUE if the lock was taken, pdFALSE if xBlockTime expired first.
+ *
+ * \defgroup xRWLockTakeWrite xRWLockTakeWrite
+ * \ingroup RWLocks
+ */
+#define xRWLockTakeWrite( xRWLock, xBlockTime )    xQueueTakeRWLock( ( xRWLock ), pdTRUE, ( xBlockTime ) )
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Give back a lock taken with xRWLockTakeWrite().  Only the task that took
+ * the lock can give it.  Any priority the task inherited while it held the
+ * lock is given up.
+ *
+ * @return pdTRUE if the lock was given, pdFALSE if the calling task did not
+ * hold it for writing.
+ *
+ * \defgroup xRWLockGiveWrite xRWLockGiveWrite
+ * \ingroup RWLocks
+ */
+#define xRWLockGiveWrite( xRWLock )    xQueueGiveRWLock( ( xRWLock ), pdTRUE )
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockTakeReadFromISR( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * A version of xRWLockTakeRead() that can be called from an ISR.  It never
+ * waits - it fails if a writer holds the lock or is waiting for it.  The lock
+ * must be given back with xRWLockGiveReadFromISR(), normally before the ISR
+ * returns.
+ *
+ * @return pdTRUE if the lock was taken, otherwise pdFALSE.
+ *
+ * \defgroup xRWLockTakeReadFromISR xRWLockTakeReadFromISR
+ * \ingroup RWLocks
+ */
+#define xRWLockTakeReadFromISR( xRWLock )    xQueueTakeRWLockReadFromISR( ( xRWLock ) )
+
+/**
+ * rwlock.h
+ * @code{c}
+ * BaseType_t xRWLockGiveReadFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xRWLockGiveRead() that can be called from an ISR.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if giving the lock unblocked
+ * a writer with a priority above that of the interrupted task, in which case
+ * a context switch should be requested before the ISR exits.  May be NULL.
+ *
+ * @return pdTRUE if the lock was given, pdFALSE if no reader held it.
+ *
+ * \defgroup xRWLockGiveReadFromISR xRWLockGiveReadFromISR
+ * \ingroup RWLocks
+ */
+#define xRWLockGiveReadFromISR( xRWLock, pxHigherPriorityTaskWoken )    xQueueGiveRWLockReadFromISR( ( xRWLock ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * rwlock.h
+ * @code{c}
+ * UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * @return The number of readers that hold the lock.
+ *
+ * \defgroup uxRWLockGetReaderCount uxRWLockGetReaderCount
+ * \ingroup RWLocks
+ */
+#define uxRWLockGetReaderCount( xRWLock )    uxQueueMessagesWaiting( ( QueueHandle_t ) ( xRWLock ) )
+
+#endif /* RW_LOCK_H */
@@ -674,6 +674,174 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreTakeFromISR( xSemaphore, pxHigherPriorityTaskWoken )    xQueueReceiveFromISR( ( QueueHandle_t ) ( xSemaphore ), NULL, ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreGiveN( SemaphoreHandle_t xSemaphore, UBaseType_t uxCount );
+ * @endcode
+ *
+ * <i>Macro</i> to give a counting semaphore uxCount times in one call.  The
+ * semaphore must have previously been created with a call to
+ * xSemaphoreCreateBinary() or xSemaphoreCreateCounting(), and
+ * configUSE_COUNTING_SEMAPHORES must be set to 1 in FreeRTOSConfig.h.
+ *
+ * The count is raised by uxCount and the tasks the new count covers are
+ * unblocked, all in one critical section, so this is cheaper than calling
+ * xSemaphoreGive() uxCount times.  Nothing is given if the count would exceed
+ * the semaphore's maximum count.
+ *
+ * Mutex type semaphores must not be used with this macro.
+ *
+ * @param xSemaphore A handle to the semaphore being given.
+ *
+ * @param uxCount The amount to raise the count by.  Must be at least 1.
+ *
+ * @return pdTRUE if the semaphore was given.  pdFALSE if the semaphore's
+ * count was within uxCount of its maximum count.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xDescriptorsDone;
+ *
+ * void vDrainTask( void * pvParameters )
+ * {
+ *  for( ;; )
+ *  {
+ *      // Wait for a full batch of eight descriptors to complete.
+ *      if( xSemaphoreTakeN( xDescriptorsDone, 8, portMAX_DELAY ) == pdTRUE )
+ *      {
+ *          // Process the batch here.
+ *      }
+ *  }
+ * }
+ *
+ * void vRefillTask( void * pvParameters )
+ * {
+ * UBaseType_t uxRefilled;
+ *
+ *  for( ;; )
+ *  {
+ *      uxRefilled = uxRefillDescriptors();
+ *
+ *      if( uxRefilled > 0 )
+ *      {
+ *          xSemaphoreGiveN( xDescriptorsDone, uxRefilled );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSemaphoreGiveN xSemaphoreGiveN
+ * \ingroup Semaphores
+ */
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+    #define xSemaphoreGiveN( xSemaphore, uxCount )    xQueueSemaphoreGiveN( ( QueueHandle_t ) ( xSemaphore ), ( uxCount ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreTakeN( SemaphoreHandle_t xSemaphore, UBaseType_t uxCount, TickType_t xBlockTime );
+ * @endcode
+ *
+ * <i>Macro</i> to take uxCount from the count of a semaphore at once.  The
+ * semaphore must have previously been created with a call to
+ * xSemaphoreCreateBinary() or xSemaphoreCreateCounting(), and
+ * configUSE_COUNTING_SEMAPHORES must be set to 1 in FreeRTOSConfig.h.
+ *
+ * Either the whole of uxCount is taken or nothing is.  A task that has to
+ * wait does so behind the tasks already waiting on the semaphore, and the
+ * count it waits for is taken on its behalf, in the order the tasks started
+ * waiting, by the give that makes it available.  A task blocked in
+ * xSemaphoreTake() waits ahead of those blocked in xSemaphoreTakeN().  A task
+ * that calls xSemaphoreTake() or xSemaphoreTakeN() while the count is
+ * available takes it without regard to the tasks waiting.
+ *
+ * Mutex type semaphores must not be used with this macro.
+ *
+ * @param xSemaphore A handle to the semaphore being taken.
+ *
+ * @param uxCount The amount to lower the count by.  Must be at least 1 and no
+ * more than the semaphore's maximum count.
+ *
+ * @param xBlockTime The time in ticks to wait for the count to reach
+ * uxCount.  The macro portTICK_PERIOD_MS can be used to convert this to a
+ * real time.  A block time of zero can be used to poll the semaphore.
+ *
+ * @return pdTRUE if uxCount was taken.  pdFALSE if xBlockTime expired before
+ * the count reached uxCount.
+ *
+ * \defgroup xSemaphoreTakeN xSemaphoreTakeN
+ * \ingroup Semaphores
+ */
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+    #define xSemaphoreTakeN( xSemaphore, uxCount, xBlockTime )    xQueueSemaphoreTakeN( ( QueueHandle_t ) ( xSemaphore ), ( uxCount ), ( xBlockTime ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreGiveNFromISR( SemaphoreHandle_t xSemaphore, UBaseType_t uxCount, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xSemaphoreGiveN() that can be called from an ISR, for example
+ * by an interrupt that completes a batch of DMA descriptors at once.
+ *
+ * @param xSemaphore A handle to the semaphore being given.
+ *
+ * @param uxCount The amount to raise the count by.  Must be at least 1.
+ *
+ * @param pxHigherPriorityTaskWoken xSemaphoreGiveNFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if giving the semaphore caused a task
+ * to unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If xSemaphoreGiveNFromISR() sets this value to pdTRUE then a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return pdTRUE if the semaphore was given.  pdFALSE if the semaphore's
+ * count was within uxCount of its maximum count.
+ *
+ * Example usage:
+ * @code{c}
+ * void vDMACompleteISR( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ * UBaseType_t uxCompleted;
+ *
+ *  uxCompleted = uxCountCompletedDescriptors();
+ *
+ *  // One call for all of the descriptors completed by this interrupt.
+ *  xSemaphoreGiveNFromISR( xDescriptorsDone, uxCompleted, &xHigherPriorityTaskWoken );
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xSemaphoreGiveNFromISR xSemaphoreGiveNFromISR
+ * \ingroup Semaphores
+ */
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+    #define xSemaphoreGiveNFromISR( xSemaphore, uxCount, pxHigherPriorityTaskWoken )    xQueueSemaphoreGiveNFromISR( ( QueueHandle_t ) ( xSemaphore ), ( uxCount ), ( pxHigherPriorityTaskWoken ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreTakeNFromISR( SemaphoreHandle_t xSemaphore, UBaseType_t uxCount, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xSemaphoreTakeN() that can be called from an ISR.  It does not
+ * block, so it fails if the count is below uxCount.
+ *
+ * @param xSemaphore A handle to the semaphore being taken.
+ *
+ * @param uxCount The amount to lower the count by.  Must be at least 1.
+ *
+ * @param pxHigherPriorityTaskWoken As for xSemaphoreTakeFromISR().
+ *
+ * @return pdTRUE if uxCount was taken, otherwise pdFALSE.
+ */
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+    #define xSemaphoreTakeNFromISR( xSemaphore, uxCount, pxHigherPriorityTaskWoken )    xQueueSemaphoreTakeNFromISR( ( QueueHandle_t ) ( xSemaphore ), ( uxCount ), ( pxHigherPriorityTaskWoken ) )
+#endif
+
 /**
  * semphr. h
  * @code{c}
@@ -798,6 +966,57 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority );
+ * @endcode
+ *
+ * Creates a mutex that uses the immediate priority ceiling protocol in place
+ * of priority inheritance.  configUSE_PRIORITY_CEILING_MUTEXES must be set to
+ * 1 in FreeRTOSConfig.h for this macro to be available.
+ *
+ * A task that takes the mutex has its priority raised to uxCeilingPriority
+ * straight away, whether or not another task wants the mutex, and keeps the
+ * raised priority until it no longer holds any mutexes.  Taking and giving the
+ * mutex then costs the same whether or not the mutex is contended, and as no
+ * task that can take the mutex can preempt its holder, a task is blocked by at
+ * most one critical section of a lower priority task.
+ *
+ * uxCeilingPriority must be at least the priority of every task that takes
+ * the mutex.  Otherwise the mutex is used in the same way as one created with
+ * xSemaphoreCreateMutex().
+ *
+ * @param uxCeilingPriority The priority at which the mutex holder runs.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * semaphore is returned.  If there was not enough heap to allocate the mutex
+ * data structures then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority )    xQueueCreateMutexWithCeiling( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority, StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * As xSemaphoreCreateMutexWithCeiling(), but with the memory the mutex needs
+ * provided by the application in pxMutexBuffer, as for
+ * xSemaphoreCreateMutexStatic().
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeilingStatic xSemaphoreCreateMutexWithCeilingStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateMutexWithCeilingStatic( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
@@ -1162,6 +1381,28 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreGetMutexHolderFromISR( xSemaphore )    xQueueGetMutexHolderFromISR( ( xSemaphore ) )
 #endif
 
+/**
+ * semphr.h
+ * @code{c}
+ * void vSemaphoreGetMutexSpinStats( SemaphoreHandle_t xMutex, MutexSpinStats_t *pxSpinStats );
+ * @endcode
+ *
+ * Only available in SMP builds with configMUTEX_SPIN_ITERATIONS set above 0.
+ *
+ * Fills in *pxSpinStats with the number of times a task polled xMutex while
+ * its holder was running on another core, how many of those polls saw the
+ * mutex given before the poll limit was reached, and the number of times a
+ * task blocked on xMutex.  Many spins but few spin acquisitions suggests
+ * configMUTEX_SPIN_ITERATIONS is too low for the time the mutex is held for.
+ *
+ * @param xMutex A handle to a mutex or recursive mutex.
+ *
+ * @param pxSpinStats The structure the counts are written to.
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+    #define vSemaphoreGetMutexSpinStats( xMutex, pxSpinStats )    vQueueGetMutexSpinStats( ( QueueHandle_t ) ( xMutex ), ( pxSpinStats ) )
+#endif
+
 /**
  * semphr.h
  * @code{c}
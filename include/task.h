@@ -95,6 +95,19 @@ struct tskTaskControlBlock; /* The old naming convention is used to prevent brea
 typedef struct tskTaskControlBlock         * TaskHandle_t;
 typedef const struct tskTaskControlBlock   * ConstTaskHandle_t;
 
+/**
+ * task. h
+ *
+ * Type by which task notification groups are referenced.  For example, a call
+ * to xTaskNotifyGroupCreate() returns a TaskNotifyGroupHandle_t variable that
+ * can then be used as a parameter to xTaskNotifyGroupAddMember().
+ *
+ * \defgroup TaskNotifyGroupHandle_t TaskNotifyGroupHandle_t
+ * \ingroup TaskNotifications
+ */
+struct tskNotifyGroup;
+typedef struct tskNotifyGroup * TaskNotifyGroupHandle_t;
+
 /*
  * Defines the prototype to which the application task hook function must
  * conform.
@@ -178,6 +191,14 @@ typedef struct xTASK_STATUS
     #if ( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
         UBaseType_t uxCoreAffinityMask;           /* The core affinity mask for the task */
     #endif
+    #if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+        UBaseType_t uxSwitchInCount;              /* The number of times the task has been switched in. */
+        UBaseType_t uxPreemptedCount;             /* The number of times the task was switched out while it was still able to run, either because it was preempted or because it yielded. */
+        UBaseType_t uxBlockedCount;               /* The number of times the task was switched out because it blocked, suspended or deleted itself. */
+        #if ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxMigrationCount;         /* The number of times the task was switched in on a different core to the one it last ran on. */
+        #endif
+    #endif
 } TaskStatus_t;
 
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
@@ -1483,6 +1504,60 @@ BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume ) PRIVILEGED_FUNCTION;
     void vTaskPreemptionEnable( const TaskHandle_t xTask );
 #endif
 
+#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+
+/**
+ * @brief Sets the length of a task's time slice.
+ *
+ * When configUSE_PREEMPTION and configUSE_TIME_SLICING are both 1 the
+ * scheduler shares processing time between Ready state tasks of equal
+ * priority.  By default a task is switched out after running for a single
+ * tick.  This function lets a task run for xTimeSliceTicks ticks before it
+ * is switched out in favour of an equal priority task, which reduces the
+ * number of context switches between CPU bound tasks without changing their
+ * priorities.  Tasks of higher priority still preempt the task immediately.
+ * A task that blocks or is suspended starts a whole time slice when it next
+ * runs, while a task that is preempted or calls taskYIELD() part way through
+ * its time slice runs for the rest of it when it next runs.
+ * configUSE_PER_TASK_TIME_SLICE must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask The handle of the task to set the time slice for. Passing NULL
+ * sets the time slice of the calling task.
+ *
+ * @param xTimeSliceTicks The length of the time slice in ticks.  Must be at
+ * least 1.
+ *
+ * Example usage:
+ *
+ * void vAFunction( void )
+ * {
+ * TaskHandle_t xBatchHandle;
+ *
+ *      // Create a CPU bound task at the same priority as an I/O task.
+ *      xTaskCreate( vBatchTask, "BATCH", STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &( xBatchHandle ) );
+ *
+ *      // Let the batch task run for 10 ticks at a time.
+ *      vTaskSetTimeSlice( xBatchHandle, 10 );
+ * }
+ */
+    void vTaskSetTimeSlice( TaskHandle_t xTask,
+                            TickType_t xTimeSliceTicks );
+
+/**
+ * @brief Gets the length of a task's time slice.
+ *
+ * configUSE_PER_TASK_TIME_SLICE must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask The handle of the task to query. Passing NULL queries the
+ * calling task.
+ *
+ * @return The length of the task's time slice in ticks.
+ */
+    TickType_t xTaskGetTimeSlice( ConstTaskHandle_t xTask );
+#endif
+
 /*-----------------------------------------------------------
 * SCHEDULER CONTROL
 *----------------------------------------------------------*/
@@ -2514,6 +2589,44 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetCoreRunTimeCounter( BaseType_t xCoreID );
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetCoreIdleRunTimeCounter( BaseType_t xCoreID );
+ * @endcode
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for these functions to be
+ * available.
+ *
+ * ulTaskGetCoreRunTimeCounter() returns the total execution time accounted to
+ * all the tasks that have run on the core xCoreID, which is the time the core
+ * has been running since the scheduler was started.
+ * ulTaskGetCoreIdleRunTimeCounter() returns the part of that time during which
+ * the core was running an Idle task.  In SMP builds an Idle task can run on any
+ * core, so the per core values are the only way to obtain the load of an
+ * individual core.
+ *
+ * The load of a core over an interval can be calculated by sampling both
+ * values at the start and end of the interval:
+ *
+ * load = 1 - ( idle_end - idle_start ) / ( total_end - total_start )
+ *
+ * @param xCoreID The core to query.  Must be 0 in single core builds.
+ *
+ * @return The total run time, or the run time spent in an Idle task, of the
+ * given core.  The unit of time is dependent on the frequency configured using
+ * the portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() and
+ * portGET_RUN_TIME_COUNTER_VALUE() macros.
+ *
+ * \defgroup ulTaskGetCoreRunTimeCounter ulTaskGetCoreRunTimeCounter
+ * \ingroup TaskUtils
+ */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetCoreRunTimeCounter( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+    configRUN_TIME_COUNTER_TYPE ulTaskGetCoreIdleRunTimeCounter( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3328,6 +3441,173 @@ uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
 #define ulTaskNotifyValueClearIndexed( xTask, uxIndexToClear, ulBitsToClear ) \
     ulTaskGenericNotifyValueClear( ( xTask ), ( uxIndexToClear ), ( ulBitsToClear ) )
 
+/**
+ * task. h
+ * @code{c}
+ * TaskNotifyGroupHandle_t xTaskNotifyGroupCreate( UBaseType_t uxIndexToNotify,
+ *                                                 UBaseType_t uxMaxMembers );
+ *
+ * TaskNotifyGroupHandle_t xTaskNotifyGroupCreateStatic( UBaseType_t uxIndexToNotify,
+ *                                                       UBaseType_t uxMaxMembers,
+ *                                                       TaskHandle_t * pxMemberBuffer,
+ *                                                       StaticTaskNotifyGroup_t * pxNotifyGroupBuffer );
+ * @endcode
+ *
+ * configUSE_TASK_NOTIFY_GROUPS must be set to 1 in FreeRTOSConfig.h for the
+ * task notification group functions to be available.
+ *
+ * Creates a task notification group, a set of up to uxMaxMembers tasks that
+ * can all be sent the same notification with one call to
+ * xTaskNotifyGroupNotify(), xTaskNotifyGroupSetBits() or xTaskNotifyGroupGive().
+ * Every member is sent the notification at array index uxIndexToNotify.
+ *
+ * xTaskNotifyGroupCreate() allocates the group from the FreeRTOS heap.
+ * xTaskNotifyGroupCreateStatic() uses the memory passed in - pxMemberBuffer
+ * must point to an array of at least uxMaxMembers TaskHandle_t variables, and
+ * both buffers must remain valid until the group is deleted.
+ *
+ * vTaskDelete() removes the task being deleted from every group it is a
+ * member of.
+ *
+ * @param uxIndexToNotify The index within each member's array of notification
+ * values that the group notifies.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
+ * @param uxMaxMembers The maximum number of tasks the group can hold.
+ *
+ * @return The handle of the group, or NULL if the group could not be created.
+ *
+ * \defgroup xTaskNotifyGroupCreate xTaskNotifyGroupCreate
+ * \ingroup TaskNotifications
+ */
+#if ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    TaskNotifyGroupHandle_t xTaskNotifyGroupCreate( UBaseType_t uxIndexToNotify,
+                                                    UBaseType_t uxMaxMembers ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    TaskNotifyGroupHandle_t xTaskNotifyGroupCreateStatic( UBaseType_t uxIndexToNotify,
+                                                          UBaseType_t uxMaxMembers,
+                                                          TaskHandle_t * pxMemberBuffer,
+                                                          StaticTaskNotifyGroup_t * pxNotifyGroupBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskNotifyGroupDelete( TaskNotifyGroupHandle_t xNotifyGroup );
+ * @endcode
+ *
+ * Deletes a task notification group.  The member tasks are not affected, other
+ * than no longer being members of the group.
+ *
+ * \defgroup vTaskNotifyGroupDelete vTaskNotifyGroupDelete
+ * \ingroup TaskNotifications
+ */
+#if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+    void vTaskNotifyGroupDelete( TaskNotifyGroupHandle_t xNotifyGroup ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskNotifyGroupAddMember( TaskNotifyGroupHandle_t xNotifyGroup, TaskHandle_t xTask );
+ * BaseType_t xTaskNotifyGroupRemoveMember( TaskNotifyGroupHandle_t xNotifyGroup, TaskHandle_t xTask );
+ * @endcode
+ *
+ * Adds xTask to, or removes xTask from, a task notification group.  Set xTask
+ * to NULL to add or remove the calling task.  These functions must not be
+ * called from an interrupt.
+ *
+ * @return xTaskNotifyGroupAddMember() returns pdPASS if xTask is a member of
+ * the group when the function returns, or pdFAIL if the group was already full.
+ * xTaskNotifyGroupRemoveMember() returns pdPASS if xTask was removed, or pdFAIL
+ * if xTask was not a member of the group.
+ *
+ * \defgroup xTaskNotifyGroupAddMember xTaskNotifyGroupAddMember
+ * \ingroup TaskNotifications
+ */
+#if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+    BaseType_t xTaskNotifyGroupAddMember( TaskNotifyGroupHandle_t xNotifyGroup,
+                                          TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskNotifyGroupRemoveMember( TaskNotifyGroupHandle_t xNotifyGroup,
+                                             TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskNotifyGroupNotify( TaskNotifyGroupHandle_t xNotifyGroup, uint32_t ulValue, eNotifyAction eAction );
+ * BaseType_t xTaskNotifyGroupSetBits( TaskNotifyGroupHandle_t xNotifyGroup, uint32_t ulBitsToSet );
+ * BaseType_t xTaskNotifyGroupGive( TaskNotifyGroupHandle_t xNotifyGroup );
+ * @endcode
+ *
+ * Sends every member of a task notification group the notification ulValue
+ * and eAction would send a single task in a call to xTaskNotifyIndexed().
+ * xTaskNotifyGroupSetBits() is equivalent to calling xTaskNotifyGroupNotify()
+ * with eAction set to eSetBits, and xTaskNotifyGroupGive() to calling it with
+ * eAction set to eIncrement.
+ *
+ * The members are notified in priority order, highest priority first, and
+ * none of them runs until all of them have been notified.  The interrupts are
+ * only disabled for configTASK_NOTIFY_GROUP_BATCH_SIZE members at a time, so
+ * the interrupt latency does not grow with the size of the group.
+ *
+ * These functions must not be called from an interrupt - use
+ * xTaskNotifyGroupSetBitsFromISR() or xTaskNotifyGroupGiveFromISR() instead.
+ *
+ * @return pdFAIL if eAction is eSetValueWithoutOverwrite and at least one
+ * member already had a notification pending, in which case those members keep
+ * their notification value.  Otherwise pdPASS.
+ *
+ * \defgroup xTaskNotifyGroupNotify xTaskNotifyGroupNotify
+ * \ingroup TaskNotifications
+ */
+#if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+    BaseType_t xTaskNotifyGroupNotify( TaskNotifyGroupHandle_t xNotifyGroup,
+                                       uint32_t ulValue,
+                                       eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+    #define xTaskNotifyGroupSetBits( xNotifyGroup, ulBitsToSet ) \
+        xTaskNotifyGroupNotify( ( xNotifyGroup ), ( ulBitsToSet ), eSetBits )
+    #define xTaskNotifyGroupGive( xNotifyGroup ) \
+        xTaskNotifyGroupNotify( ( xNotifyGroup ), ( 0UL ), eIncrement )
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskNotifyGroupSetBitsFromISR( TaskNotifyGroupHandle_t xNotifyGroup, uint32_t ulBitsToSet, BaseType_t * pxHigherPriorityTaskWoken );
+ * BaseType_t xTaskNotifyGroupGiveFromISR( TaskNotifyGroupHandle_t xNotifyGroup, BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Versions of xTaskNotifyGroupSetBits() and xTaskNotifyGroupGive() that can be
+ * called from an interrupt.
+ *
+ * Notifying every member of a group is not a deterministic operation, so, as
+ * with xEventGroupSetBitsFromISR(), the interrupt sends a message to the RTOS
+ * daemon (timer service) task, which notifies the members on its behalf.
+ * INCLUDE_xTimerPendFunctionCall and configUSE_TIMERS must be set to 1 in
+ * FreeRTOSConfig.h for these functions to be available.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the message
+ * unblocked the daemon task and the daemon task has a priority above that of
+ * the interrupted task, in which case a context switch should be requested
+ * before the interrupt exits.
+ *
+ * @return pdPASS if the message was sent to the daemon task, otherwise pdFAIL
+ * (the timer command queue was full).
+ *
+ * \defgroup xTaskNotifyGroupSetBitsFromISR xTaskNotifyGroupSetBitsFromISR
+ * \ingroup TaskNotifications
+ */
+#if ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+    BaseType_t xTaskNotifyGroupSetBitsFromISR( TaskNotifyGroupHandle_t xNotifyGroup,
+                                               uint32_t ulBitsToSet,
+                                               BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskNotifyGroupGiveFromISR( TaskNotifyGroupHandle_t xNotifyGroup,
+                                            BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task.h
  * @code{c}
@@ -3645,6 +3925,25 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                           UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Records that the calling task is about to block on
+ * a mutex.  pxMutexHolder points to the mutex's record of its holder, so tasks
+ * that block on a mutex the calling task holds can pass their priority on to
+ * the task holding this mutex.
+ */
+#if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+    void vTaskSetBlockingMutexHolder( TaskHandle_t * const pxMutexHolder ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Raises the priority of the calling task, which has
+ * just taken a priority ceiling mutex, to the ceiling of that mutex should the
+ * task have a priority less than the ceiling.
+ */
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+    void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Get the uxTaskNumber assigned to the task referenced by the xTask parameter.
  */
@@ -3711,6 +4010,15 @@ void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNC
     void vTaskYieldWithinAPI( void );
 #endif
 
+/*
+ * For internal use only.  Returns pdTRUE if xTask is running on one of the
+ * cores, pdFALSE if it is not or xTask is NULL.  The task's state is read
+ * without a critical section, so the result is only a hint.
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) )
+    BaseType_t xTaskIsRunning( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * This function is only intended for use when implementing a port of the scheduler
  * and is only available when portCRITICAL_NESTING_IN_TCB is set to 1 or configNUMBER_OF_CORES
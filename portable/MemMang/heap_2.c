@@ -112,6 +112,9 @@ PRIVILEGED_DATA static BlockLink_t xStart, xEnd;
 /* Keeps track of the number of free bytes remaining, but says nothing about
  * fragmentation. */
 PRIVILEGED_DATA static size_t xFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
 
 /* Indicates whether the heap has been initialised or not. */
 PRIVILEGED_DATA static BaseType_t xHeapHasBeenInitialised = pdFALSE;
@@ -262,12 +265,22 @@ void * pvPortMalloc( size_t xWantedSize )
 
                     xFreeBytesRemaining -= pxBlock->xBlockSize;
 
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
                     xAllocatedBlockSize = pxBlock->xBlockSize;
 
                     /* The block is being returned - it is allocated and owned
                      * by the application and has no "next" block. */
                     heapALLOCATE_BLOCK( pxBlock );
                     pxBlock->pxNextFreeBlock = NULL;
+                    xNumberOfSuccessfulAllocations++;
                 }
             }
         }
@@ -329,6 +342,7 @@ void vPortFree( void * pv )
                     prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE( pv, pxLink->xBlockSize );
+                    xNumberOfSuccessfulFrees++;
                 }
                 ( void ) xTaskResumeAll();
             }
@@ -368,6 +382,64 @@ void * pvPortCalloc( size_t xNum,
 }
 /*-----------------------------------------------------------*/
 
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* The heap is initialised automatically when the first allocation is
+         * made, before which the whole heap is a single free block. */
+        if( xHeapHasBeenInitialised == pdFALSE )
+        {
+            xBlocks = 1;
+            xMaxSize = configADJUSTED_HEAP_SIZE;
+            xMinSize = configADJUSTED_HEAP_SIZE;
+        }
+        else
+        {
+            pxBlock = xStart.pxNextFreeBlock;
+
+            while( pxBlock != &xEnd )
+            {
+                /* The list is ordered by size, so the first block is the
+                 * smallest and the last block is the largest. */
+                xBlocks++;
+
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+
+                if( pxBlock->xBlockSize < xMinSize )
+                {
+                    xMinSize = pxBlock->xBlockSize;
+                }
+
+                pxBlock = pxBlock->pxNextFreeBlock;
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xNumberOfInPlaceReallocations = ( size_t ) 0U;
+        pxHeapStats->xNumberOfMovedReallocations = ( size_t ) 0U;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
 static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
 {
     BlockLink_t * pxFirstFreeBlock;
@@ -401,6 +473,9 @@ static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
 void vPortHeapResetState( void )
 {
     xFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+    xMinimumEverFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+    xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+    xNumberOfSuccessfulFrees = ( size_t ) 0U;
 
     xHeapHasBeenInitialised = pdFALSE;
 }
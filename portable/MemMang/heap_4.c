@@ -55,6 +55,26 @@
     #define configHEAP_CLEAR_MEMORY_ON_FREE    0
 #endif
 
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 0 ) && ( configUSE_RECURSIVE_MUTEXES == 0 ) && ( configNUMBER_OF_CORES == 1 ) )
+        #error configHEAP_TRACK_ALLOCATIONS requires INCLUDE_xTaskGetCurrentTaskHandle to be set to 1
+    #endif
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 ) )
+        #error configHEAP_TRACK_ALLOCATIONS requires INCLUDE_xTaskGetSchedulerState to be set to 1
+    #endif
+
+/* The address recorded as the call site of an allocation - by default the
+ * return address of the pvPortMalloc() or pvPortCalloc() call. */
+    #ifndef configHEAP_CALLER_ADDRESS
+        #if defined( __GNUC__ )
+            #define configHEAP_CALLER_ADDRESS()    __builtin_return_address( 0 )
+        #else
+            #define configHEAP_CALLER_ADDRESS()    NULL
+        #endif
+    #endif
+#endif /* configHEAP_TRACK_ALLOCATIONS */
+
 /* Block sizes must not get too small. */
 #define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
 
@@ -102,6 +122,13 @@ typedef struct A_BLOCK_LINK
 {
     struct A_BLOCK_LINK * pxNextFreeBlock; /**< The next free block in the list. */
     size_t xBlockSize;                     /**< The size of the free block. */
+    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+        struct A_BLOCK_LINK * pxNextAllocatedBlock;     /**< The next block in the list of allocated blocks. */
+        struct A_BLOCK_LINK * pxPreviousAllocatedBlock; /**< The previous block in the list of allocated blocks. */
+        TaskHandle_t xOwner;                            /**< The task that allocated the block. */
+        void * pvCaller;                                /**< The call site of the allocation. */
+        TickType_t xTimestamp;                          /**< The tick count when the block was allocated. */
+    #endif
 } BlockLink_t;
 
 /* Setting configENABLE_HEAP_PROTECTOR to 1 enables heap block pointers
@@ -146,6 +173,20 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
 
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+
+/*
+ * Records the owner, call site and time of an allocation in the header of the
+ * block, and adds the block to the list of allocated blocks.  Removes the
+ * block from that list when it is freed.  Called with the scheduler
+ * suspended.
+ */
+    static void prvTrackAllocation( BlockLink_t * pxBlock,
+                                    void * pvCaller ) PRIVILEGED_FUNCTION;
+    static void prvUntrackAllocation( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+#endif /* configHEAP_TRACK_ALLOCATIONS */
+
 /*
  * Called automatically to setup the required heap structures the first time
  * pvPortMalloc() is called.
@@ -168,6 +209,15 @@ PRIVILEGED_DATA static size_t xFreeBytesRemaining = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfInPlaceReallocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfMovedReallocations = ( size_t ) 0U;
+
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+
+/* The allocated blocks, most recently allocated first. */
+    PRIVILEGED_DATA static BlockLink_t * pxAllocatedBlocks = NULL;
+
+#endif /* configHEAP_TRACK_ALLOCATIONS */
 
 /*-----------------------------------------------------------*/
 
@@ -311,6 +361,12 @@ void * pvPortMalloc( size_t xWantedSize )
                     heapALLOCATE_BLOCK( pxBlock );
                     pxBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( NULL );
                     xNumberOfSuccessfulAllocations++;
+
+                    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+                    {
+                        prvTrackAllocation( pxBlock, configHEAP_CALLER_ADDRESS() );
+                    }
+                    #endif
                 }
                 else
                 {
@@ -393,6 +449,13 @@ void vPortFree( void * pv )
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE( pv, pxLink->xBlockSize );
+
+                    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+                    {
+                        prvUntrackAllocation( pxLink );
+                    }
+                    #endif
+
                     prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
                     xNumberOfSuccessfulFrees++;
                 }
@@ -447,6 +510,14 @@ void * pvPortCalloc( size_t xNum,
         if( pv != NULL )
         {
             ( void ) memset( pv, 0, xNum * xSize );
+
+            #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+            {
+                /* Attribute the block to the caller of pvPortCalloc() rather
+                 * than to pvPortCalloc() itself. */
+                ( ( BlockLink_t * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize ) )->pvCaller = configHEAP_CALLER_ADDRESS();
+            }
+            #endif
         }
     }
 
@@ -454,6 +525,443 @@ void * pvPortCalloc( size_t xNum,
 }
 /*-----------------------------------------------------------*/
 
+void * pvPortRealloc( void * pv,
+                      size_t xWantedSize )
+{
+    BlockLink_t * pxLink;
+    BlockLink_t * pxIterator;
+    BlockLink_t * pxNextBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xNewBlockSize = xWantedSize;
+    size_t xOldBlockSize;
+    size_t xBlockSize;
+    size_t xAdditionalRequiredSize;
+    BaseType_t xResizedInPlace = pdFALSE;
+
+    if( pv == NULL )
+    {
+        pvReturn = pvPortMalloc( xWantedSize );
+    }
+    else if( xWantedSize == 0 )
+    {
+        vPortFree( pv );
+    }
+    else
+    {
+        /* The memory being resized will have an BlockLink_t structure
+         * immediately before it. */
+        pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+        heapVALIDATE_BLOCK_POINTER( pxLink );
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == heapPROTECT_BLOCK_POINTER( NULL ) );
+
+        xOldBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+
+        /* The size of the block needed, calculated as by pvPortMalloc(). */
+        if( heapADD_WILL_OVERFLOW( xNewBlockSize, xHeapStructSize ) == 0 )
+        {
+            xNewBlockSize += xHeapStructSize;
+
+            if( ( xNewBlockSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xNewBlockSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xNewBlockSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xNewBlockSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xNewBlockSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xNewBlockSize = 0;
+        }
+
+        if( ( xNewBlockSize > 0 ) && ( heapBLOCK_SIZE_IS_VALID( xNewBlockSize ) != 0 ) )
+        {
+            vTaskSuspendAll();
+            {
+                xBlockSize = xOldBlockSize;
+
+                if( xNewBlockSize <= xBlockSize )
+                {
+                    /* Shrinking - the block stays where it is, and the end of
+                     * it is freed if it is large enough to be a block of its
+                     * own. */
+                    xResizedInPlace = pdTRUE;
+                }
+                else
+                {
+                    /* Growing - the block can only stay where it is if the
+                     * block immediately after it is free and large enough to
+                     * make up the difference.  The free list is in address
+                     * order, so find where that block would be in the list. */
+                    pxNextBlock = ( BlockLink_t * ) ( ( ( uint8_t * ) pxLink ) + xBlockSize );
+
+                    for( pxIterator = &xStart; heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) < pxNextBlock; pxIterator = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
+                    {
+                        /* Nothing to do here, just iterate to the right position. */
+                    }
+
+                    if( ( heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) == pxNextBlock ) &&
+                        ( pxNextBlock != pxEnd ) &&
+                        ( ( xNewBlockSize - xBlockSize ) <= pxNextBlock->xBlockSize ) )
+                    {
+                        heapVALIDATE_BLOCK_POINTER( pxNextBlock );
+
+                        /* Take the next block out of the list of free blocks
+                         * and add it to this one.  The free bytes are updated
+                         * below, once whatever this block does not need has
+                         * been returned. */
+                        pxIterator->pxNextFreeBlock = pxNextBlock->pxNextFreeBlock;
+                        xBlockSize += pxNextBlock->xBlockSize;
+                        xResizedInPlace = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xResizedInPlace != pdFALSE )
+                {
+                    /* Return whatever is beyond the new size to the list of
+                     * free blocks, where it is merged with the block after it
+                     * if that block is free. */
+                    if( ( xBlockSize - xNewBlockSize ) > heapMINIMUM_BLOCK_SIZE )
+                    {
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxLink ) + xNewBlockSize );
+                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                        pxNewBlockLink->xBlockSize = xBlockSize - xNewBlockSize;
+                        xBlockSize = xNewBlockSize;
+
+                        #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                        {
+                            ( void ) memset( ( ( uint8_t * ) pxNewBlockLink ) + xHeapStructSize, 0, pxNewBlockLink->xBlockSize - xHeapStructSize );
+                        }
+                        #endif
+
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Only the bytes the block has gained or lost change the
+                     * free bytes. */
+                    if( xBlockSize > xOldBlockSize )
+                    {
+                        xFreeBytesRemaining -= xBlockSize - xOldBlockSize;
+
+                        if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                        {
+                            xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        xFreeBytesRemaining += xOldBlockSize - xBlockSize;
+                    }
+
+                    pxLink->xBlockSize = xBlockSize;
+                    heapALLOCATE_BLOCK( pxLink );
+                    xNumberOfInPlaceReallocations++;
+                    pvReturn = pv;
+
+                    /* Traced as a free of the old block and an allocation of
+                     * the new one at the same address. */
+                    traceFREE( pv, xOldBlockSize );
+                    traceMALLOC( pvReturn, xBlockSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xResizedInPlace == pdFALSE )
+        {
+            /* The block has to move.  If there is not enough memory then
+             * NULL is returned and the original block is left allocated, as
+             * with the C library realloc(). */
+            pvReturn = pvPortMalloc( xWantedSize );
+
+            if( pvReturn != NULL )
+            {
+                ( void ) memcpy( pvReturn, pv, ( xWantedSize < ( xOldBlockSize - xHeapStructSize ) ) ? xWantedSize : ( xOldBlockSize - xHeapStructSize ) );
+                vPortFree( pv );
+
+                vTaskSuspendAll();
+                {
+                    xNumberOfMovedReallocations++;
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+    {
+        /* Attribute a new or moved block to the caller of pvPortRealloc(). */
+        if( ( pvReturn != NULL ) && ( pvReturn != pv ) )
+        {
+            ( ( BlockLink_t * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) )->pvCaller = configHEAP_CALLER_ADDRESS();
+        }
+    }
+    #endif
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocAligned( size_t xWantedSize,
+                            size_t xAlignment )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxAlignedBlock = NULL;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    size_t xPadding = 0;
+    size_t xAllocatedBlockSize = 0;
+
+    /* The alignment must be a power of two. */
+    configASSERT( ( xAlignment != 0 ) && ( ( xAlignment & ( xAlignment - 1 ) ) == 0 ) );
+
+    if( ( xAlignment == 0 ) || ( ( xAlignment & ( xAlignment - 1 ) ) != 0 ) )
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+    else if( xAlignment <= portBYTE_ALIGNMENT )
+    {
+        /* Every block already has at least this alignment. */
+        pvReturn = pvPortMalloc( xWantedSize );
+
+        #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+        {
+            if( pvReturn != NULL )
+            {
+                ( ( BlockLink_t * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) )->pvCaller = configHEAP_CALLER_ADDRESS();
+            }
+        }
+        #endif
+    }
+    else
+    {
+        /* The size of the block needed, calculated as by pvPortMalloc(). */
+        if( ( xWantedSize > 0 ) && ( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 ) )
+        {
+            xWantedSize += xHeapStructSize;
+
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+
+        vTaskSuspendAll();
+        {
+            /* If this is the first call to malloc then the heap will require
+             * initialisation to setup the list of free blocks. */
+            if( pxEnd == NULL )
+            {
+                prvHeapInit();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xWantedSize > 0 ) && ( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            {
+                /* Traverse the list from the start (lowest address) block until
+                 * one is found that can hold a block of the wanted size whose
+                 * memory starts on the wanted alignment. */
+                pxPreviousBlock = &xStart;
+                pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+
+                while( pxBlock != pxEnd )
+                {
+                    heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+                    /* The bytes skipped to align the memory that follows the
+                     * block's BlockLink_t structure.  They are left in the
+                     * list of free blocks, so must be enough to form a block of
+                     * their own. */
+                    xPadding = ( xAlignment - ( ( ( size_t ) pxBlock + xHeapStructSize ) & ( xAlignment - 1 ) ) ) & ( xAlignment - 1 );
+
+                    while( ( xPadding != 0 ) && ( xPadding < heapMINIMUM_BLOCK_SIZE ) )
+                    {
+                        xPadding += xAlignment;
+                    }
+
+                    if( ( xPadding < pxBlock->xBlockSize ) && ( ( pxBlock->xBlockSize - xPadding ) >= xWantedSize ) )
+                    {
+                        break;
+                    }
+
+                    pxPreviousBlock = pxBlock;
+                    pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+                }
+
+                /* If the end marker was reached then a block of adequate size
+                 * was not found. */
+                if( pxBlock != pxEnd )
+                {
+                    if( xPadding == 0 )
+                    {
+                        /* Already aligned - take the whole block out of the
+                         * list of free blocks, as pvPortMalloc() does. */
+                        pxAlignedBlock = pxBlock;
+                        pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+                    }
+                    else
+                    {
+                        /* Split the padding off the front of the block.  The
+                         * padding stays in the list of free blocks in place of
+                         * the original block. */
+                        pxAlignedBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xPadding );
+                        pxAlignedBlock->xBlockSize = pxBlock->xBlockSize - xPadding;
+                        pxBlock->xBlockSize = xPadding;
+                        pxPreviousBlock = pxBlock;
+                    }
+
+                    /* If the block is larger than required it can be split into
+                     * two, as in pvPortMalloc(). */
+                    if( ( pxAlignedBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+                    {
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxAlignedBlock ) + xWantedSize );
+                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                        pxNewBlockLink->xBlockSize = pxAlignedBlock->xBlockSize - xWantedSize;
+                        pxAlignedBlock->xBlockSize = xWantedSize;
+
+                        pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+                        pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xFreeBytesRemaining -= pxAlignedBlock->xBlockSize;
+
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xAllocatedBlockSize = pxAlignedBlock->xBlockSize;
+
+                    heapALLOCATE_BLOCK( pxAlignedBlock );
+                    pxAlignedBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( NULL );
+                    xNumberOfSuccessfulAllocations++;
+
+                    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+                    {
+                        prvTrackAllocation( pxAlignedBlock, configHEAP_CALLER_ADDRESS() );
+                    }
+                    #endif
+
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxAlignedBlock ) + xHeapStructSize );
+                    heapVALIDATE_BLOCK_POINTER( pvReturn );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceMALLOC( pvReturn, xAllocatedBlockSize );
+
+            /* Prevent compiler warnings when trace macros are not used. */
+            ( void ) xAllocatedBlockSize;
+        }
+        ( void ) xTaskResumeAll();
+
+        #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                vApplicationMallocFailedHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+    }
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( xAlignment - 1 ) ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFreeAligned( void * pv )
+{
+    /* pvPortMallocAligned() returns an ordinary block, with its BlockLink_t
+     * structure immediately before the returned address. */
+    vPortFree( pv );
+}
+/*-----------------------------------------------------------*/
+
 static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
 {
     BlockLink_t * pxFirstFreeBlock;
@@ -616,12 +1124,116 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
         pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
         pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
         pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xNumberOfInPlaceReallocations = xNumberOfInPlaceReallocations;
+        pxHeapStats->xNumberOfMovedReallocations = xNumberOfMovedReallocations;
         pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
     }
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
 
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+
+    static void prvTrackAllocation( BlockLink_t * pxBlock,
+                                    void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        /* Blocks allocated before the scheduler is started have no owner -
+         * the current task is then just the last task created. */
+        if( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED )
+        {
+            pxBlock->xOwner = NULL;
+        }
+        else
+        {
+            pxBlock->xOwner = xTaskGetCurrentTaskHandle();
+        }
+
+        pxBlock->pvCaller = pvCaller;
+        pxBlock->xTimestamp = xTaskGetTickCount();
+
+        pxBlock->pxPreviousAllocatedBlock = heapPROTECT_BLOCK_POINTER( NULL );
+        pxBlock->pxNextAllocatedBlock = heapPROTECT_BLOCK_POINTER( pxAllocatedBlocks );
+
+        if( pxAllocatedBlocks != NULL )
+        {
+            pxAllocatedBlocks->pxPreviousAllocatedBlock = heapPROTECT_BLOCK_POINTER( pxBlock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxAllocatedBlocks = pxBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUntrackAllocation( BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxNext = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextAllocatedBlock );
+        BlockLink_t * pxPrevious = heapPROTECT_BLOCK_POINTER( pxBlock->pxPreviousAllocatedBlock );
+
+        if( pxNext != NULL )
+        {
+            heapVALIDATE_BLOCK_POINTER( pxNext );
+            pxNext->pxPreviousAllocatedBlock = pxBlock->pxPreviousAllocatedBlock;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxPrevious != NULL )
+        {
+            heapVALIDATE_BLOCK_POINTER( pxPrevious );
+            pxPrevious->pxNextAllocatedBlock = pxBlock->pxNextAllocatedBlock;
+        }
+        else
+        {
+            configASSERT( pxAllocatedBlocks == pxBlock );
+            pxAllocatedBlocks = pxNext;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortWalkHeapAllocations( HeapAllocationWalkFunction_t pxWalkFunction,
+                                           void * pvContext )
+    {
+        HeapAllocation_t xAllocation;
+        BlockLink_t * pxBlock;
+        UBaseType_t uxBlocks = 0;
+
+        vTaskSuspendAll();
+        {
+            for( pxBlock = pxAllocatedBlocks; pxBlock != NULL; pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextAllocatedBlock ) )
+            {
+                heapVALIDATE_BLOCK_POINTER( pxBlock );
+                configASSERT( heapBLOCK_IS_ALLOCATED( pxBlock ) != 0 );
+
+                uxBlocks++;
+
+                if( pxWalkFunction != NULL )
+                {
+                    xAllocation.pvAddress = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    xAllocation.xBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                    xAllocation.xOwner = pxBlock->xOwner;
+                    xAllocation.pvCaller = pxBlock->pvCaller;
+                    xAllocation.xTimestamp = pxBlock->xTimestamp;
+
+                    if( pxWalkFunction( &xAllocation, pvContext ) == pdFALSE )
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxBlocks;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_TRACK_ALLOCATIONS */
+
 /*
  * Reset the state in this file. This state is normally initialized at start up.
  * This function must be called by the application before restarting the
@@ -635,5 +1247,13 @@ void vPortHeapResetState( void )
     xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
     xNumberOfSuccessfulAllocations = ( size_t ) 0U;
     xNumberOfSuccessfulFrees = ( size_t ) 0U;
+    xNumberOfInPlaceReallocations = ( size_t ) 0U;
+    xNumberOfMovedReallocations = ( size_t ) 0U;
+
+    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+    {
+        pxAllocatedBlocks = NULL;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
@@ -67,6 +67,13 @@
  *
  * Note 0x80000000 is the lower address so appears in the array first.
  *
+ * When configHEAP_NUMBER_OF_MEMORY_CLASSES is greater than 1 each HeapRegion_t
+ * also has a uxMemoryClass member that tags the region with a memory class -
+ * for example 0 for fast internal RAM and 1 for slow external RAM.
+ * pvPortMallocFromClass() then allocates from the regions of a given class,
+ * falling back to other classes as requested, and vPortGetHeapStatsForClass()
+ * returns the statistics of the regions of one class.
+ *
  */
 #include <stdlib.h>
 #include <string.h>
@@ -89,6 +96,43 @@
     #define configHEAP_CLEAR_MEMORY_ON_FREE    0
 #endif
 
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 0 ) && ( configUSE_RECURSIVE_MUTEXES == 0 ) && ( configNUMBER_OF_CORES == 1 ) )
+        #error configHEAP_TRACK_ALLOCATIONS requires INCLUDE_xTaskGetCurrentTaskHandle to be set to 1
+    #endif
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 ) )
+        #error configHEAP_TRACK_ALLOCATIONS requires INCLUDE_xTaskGetSchedulerState to be set to 1
+    #endif
+
+/* The address recorded as the call site of an allocation - by default the
+ * return address of the pvPortMalloc() or pvPortCalloc() call. */
+    #ifndef configHEAP_CALLER_ADDRESS
+        #if defined( __GNUC__ )
+            #define configHEAP_CALLER_ADDRESS()    __builtin_return_address( 0 )
+        #else
+            #define configHEAP_CALLER_ADDRESS()    NULL
+        #endif
+    #endif
+#endif /* configHEAP_TRACK_ALLOCATIONS */
+
+#if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+
+/* The maximum number of regions that can be passed to
+ * vPortDefineHeapRegions() when the regions are tagged with memory classes. */
+    #ifndef configHEAP_MAX_REGIONS
+        #define configHEAP_MAX_REGIONS    8
+    #endif
+
+/* Is a block in one of the memory classes in a mask of classes. */
+    #define heapBLOCK_IS_IN_MEMORY_CLASSES( pxBlock, uxMemoryClasses )    ( ( ( uxMemoryClasses ) & portHEAP_MEMORY_CLASS_BIT( prvGetMemoryClass( pxBlock ) ) ) != 0 )
+#else
+    #define heapBLOCK_IS_IN_MEMORY_CLASSES( pxBlock, uxMemoryClasses )    ( pdTRUE )
+#endif /* configHEAP_NUMBER_OF_MEMORY_CLASSES */
+
+/* A mask of every memory class. */
+#define heapALL_MEMORY_CLASSES    ( ~( UBaseType_t ) 0U )
+
 /* Block sizes must not get too small. */
 #define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
 
@@ -159,8 +203,37 @@ typedef struct A_BLOCK_LINK
 {
     struct A_BLOCK_LINK * pxNextFreeBlock; /**< The next free block in the list. */
     size_t xBlockSize;                     /**< The size of the free block. */
+    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+        struct A_BLOCK_LINK * pxNextAllocatedBlock;     /**< The next block in the list of allocated blocks. */
+        struct A_BLOCK_LINK * pxPreviousAllocatedBlock; /**< The previous block in the list of allocated blocks. */
+        TaskHandle_t xOwner;                            /**< The task that allocated the block. */
+        void * pvCaller;                                /**< The call site of the allocation. */
+        TickType_t xTimestamp;                          /**< The tick count when the block was allocated. */
+    #endif
 } BlockLink_t;
 
+#if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+
+/* The end of each region and the memory class it was tagged with. */
+    typedef struct HeapMemoryRegion
+    {
+        uint8_t * pucEndAddress;
+        UBaseType_t uxMemoryClass;
+    } HeapMemoryRegion_t;
+
+/* The counters kept for each memory class - as kept for the whole heap. */
+    typedef struct HeapMemoryClass
+    {
+        size_t xFreeBytesRemaining;
+        size_t xMinimumEverFreeBytesRemaining;
+        size_t xNumberOfSuccessfulAllocations;
+        size_t xNumberOfSuccessfulFrees;
+        size_t xNumberOfInPlaceReallocations;
+        size_t xNumberOfMovedReallocations;
+    } HeapMemoryClass_t;
+
+#endif /* configHEAP_NUMBER_OF_MEMORY_CLASSES */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -170,6 +243,41 @@ typedef struct A_BLOCK_LINK
  * adjacent to each other.
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocates a block from a region of one of the memory classes in
+ * uxMemoryClasses or, if none of them has a large enough free block, from a
+ * region of one of the classes in uxFallbackClasses.
+ */
+static void * prvHeapAllocate( size_t xWantedSize,
+                               UBaseType_t uxMemoryClasses,
+                               UBaseType_t uxFallbackClasses ) PRIVILEGED_FUNCTION;
+
+#if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+
+/*
+ * Returns the memory class of the region that holds pv.  Removes xBytes from
+ * the free bytes of the memory class of the region that holds pxBlock.
+ */
+    static UBaseType_t prvGetMemoryClass( const void * pv ) PRIVILEGED_FUNCTION;
+    static void prvTakeMemoryClassBytes( const BlockLink_t * pxBlock,
+                                         size_t xBytes ) PRIVILEGED_FUNCTION;
+
+#endif /* configHEAP_NUMBER_OF_MEMORY_CLASSES */
+
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+
+/*
+ * Records the owner, call site and time of an allocation in the header of the
+ * block, and adds the block to the list of allocated blocks.  Removes the
+ * block from that list when it is freed.  Called with the scheduler
+ * suspended.
+ */
+    static void prvTrackAllocation( BlockLink_t * pxBlock,
+                                    void * pvCaller ) PRIVILEGED_FUNCTION;
+    static void prvUntrackAllocation( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+#endif /* configHEAP_TRACK_ALLOCATIONS */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
 #if ( configENABLE_HEAP_PROTECTOR == 1 )
@@ -198,6 +306,24 @@ PRIVILEGED_DATA static size_t xFreeBytesRemaining = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfInPlaceReallocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfMovedReallocations = ( size_t ) 0U;
+
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+
+/* The allocated blocks, most recently allocated first. */
+    PRIVILEGED_DATA static BlockLink_t * pxAllocatedBlocks = NULL;
+
+#endif /* configHEAP_TRACK_ALLOCATIONS */
+
+#if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+
+/* The regions in address order, and the counters of each memory class. */
+    PRIVILEGED_DATA static HeapMemoryRegion_t xHeapMemoryRegions[ configHEAP_MAX_REGIONS ];
+    PRIVILEGED_DATA static BaseType_t xNumberOfHeapMemoryRegions = 0;
+    PRIVILEGED_DATA static HeapMemoryClass_t xHeapMemoryClasses[ configHEAP_NUMBER_OF_MEMORY_CLASSES ];
+
+#endif /* configHEAP_NUMBER_OF_MEMORY_CLASSES */
 
 #if ( configENABLE_HEAP_PROTECTOR == 1 )
 
@@ -213,6 +339,56 @@ PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
+{
+    void * pvReturn;
+
+    pvReturn = prvHeapAllocate( xWantedSize, heapALL_MEMORY_CLASSES, 0 );
+
+    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+    {
+        /* Attribute the block to the caller of pvPortMalloc(). */
+        if( pvReturn != NULL )
+        {
+            ( ( BlockLink_t * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) )->pvCaller = configHEAP_CALLER_ADDRESS();
+        }
+    }
+    #endif
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+
+    void * pvPortMallocFromClass( size_t xWantedSize,
+                                  UBaseType_t uxMemoryClass,
+                                  UBaseType_t uxFallbackClasses )
+    {
+        void * pvReturn;
+
+        configASSERT( uxMemoryClass < ( UBaseType_t ) configHEAP_NUMBER_OF_MEMORY_CLASSES );
+
+        pvReturn = prvHeapAllocate( xWantedSize, portHEAP_MEMORY_CLASS_BIT( uxMemoryClass ), uxFallbackClasses );
+
+        #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+        {
+            /* Attribute the block to the caller of pvPortMallocFromClass(). */
+            if( pvReturn != NULL )
+            {
+                ( ( BlockLink_t * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) )->pvCaller = configHEAP_CALLER_ADDRESS();
+            }
+        }
+        #endif
+
+        return pvReturn;
+    }
+
+#endif /* configHEAP_NUMBER_OF_MEMORY_CLASSES */
+/*-----------------------------------------------------------*/
+
+static void * prvHeapAllocate( size_t xWantedSize,
+                               UBaseType_t uxMemoryClasses,
+                               UBaseType_t uxFallbackClasses ) /* PRIVILEGED_FUNCTION */
 {
     BlockLink_t * pxBlock;
     BlockLink_t * pxPreviousBlock;
@@ -225,6 +401,14 @@ void * pvPortMalloc( size_t xWantedSize )
      * pvPortMalloc(). */
     configASSERT( pxEnd );
 
+    #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES == 1 )
+    {
+        /* There is only one memory class. */
+        ( void ) uxMemoryClasses;
+        ( void ) uxFallbackClasses;
+    }
+    #endif
+
     if( xWantedSize > 0 )
     {
         /* The wanted size must be increased so it can contain a BlockLink_t
@@ -280,13 +464,39 @@ void * pvPortMalloc( size_t xWantedSize )
                 pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
                 heapVALIDATE_BLOCK_POINTER( pxBlock );
 
-                while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
+                while( ( ( pxBlock->xBlockSize < xWantedSize ) || ( heapBLOCK_IS_IN_MEMORY_CLASSES( pxBlock, uxMemoryClasses ) == pdFALSE ) ) &&
+                       ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
                 {
                     pxPreviousBlock = pxBlock;
                     pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
                     heapVALIDATE_BLOCK_POINTER( pxBlock );
                 }
 
+                #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+                {
+                    /* None of the wanted classes had a large enough block, so
+                     * search again in the fallback classes. */
+                    if( ( pxBlock == pxEnd ) && ( uxFallbackClasses != 0 ) )
+                    {
+                        pxPreviousBlock = &xStart;
+                        pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+                        heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+                        while( ( ( pxBlock->xBlockSize < xWantedSize ) || ( heapBLOCK_IS_IN_MEMORY_CLASSES( pxBlock, uxFallbackClasses ) == pdFALSE ) ) &&
+                               ( pxBlock->pxNextFreeBlock != heapPROTECT_BLOCK_POINTER( NULL ) ) )
+                        {
+                            pxPreviousBlock = pxBlock;
+                            pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+                            heapVALIDATE_BLOCK_POINTER( pxBlock );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configHEAP_NUMBER_OF_MEMORY_CLASSES */
+
                 /* If the end marker was reached then a block of adequate size
                  * was not found. */
                 if( pxBlock != pxEnd )
@@ -338,6 +548,13 @@ void * pvPortMalloc( size_t xWantedSize )
                         mtCOVERAGE_TEST_MARKER();
                     }
 
+                    #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+                    {
+                        prvTakeMemoryClassBytes( pxBlock, pxBlock->xBlockSize );
+                        xHeapMemoryClasses[ prvGetMemoryClass( pxBlock ) ].xNumberOfSuccessfulAllocations++;
+                    }
+                    #endif
+
                     xAllocatedBlockSize = pxBlock->xBlockSize;
 
                     /* The block is being returned - it is allocated and owned
@@ -345,6 +562,12 @@ void * pvPortMalloc( size_t xWantedSize )
                     heapALLOCATE_BLOCK( pxBlock );
                     pxBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( NULL );
                     xNumberOfSuccessfulAllocations++;
+
+                    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+                    {
+                        prvTrackAllocation( pxBlock, configHEAP_CALLER_ADDRESS() );
+                    }
+                    #endif
                 }
                 else
                 {
@@ -427,6 +650,20 @@ void vPortFree( void * pv )
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE( pv, pxLink->xBlockSize );
+
+                    #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+                    {
+                        xHeapMemoryClasses[ prvGetMemoryClass( pxLink ) ].xFreeBytesRemaining += pxLink->xBlockSize;
+                        xHeapMemoryClasses[ prvGetMemoryClass( pxLink ) ].xNumberOfSuccessfulFrees++;
+                    }
+                    #endif
+
+                    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+                    {
+                        prvUntrackAllocation( pxLink );
+                    }
+                    #endif
+
                     prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
                     xNumberOfSuccessfulFrees++;
                 }
@@ -460,6 +697,17 @@ size_t xPortGetMinimumEverFreeHeapSize( void )
 void xPortResetHeapMinimumEverFreeHeapSize( void )
 {
     xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+
+    #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+    {
+        UBaseType_t uxMemoryClass;
+
+        for( uxMemoryClass = 0; uxMemoryClass < ( UBaseType_t ) configHEAP_NUMBER_OF_MEMORY_CLASSES; uxMemoryClass++ )
+        {
+            xHeapMemoryClasses[ uxMemoryClass ].xMinimumEverFreeBytesRemaining = xHeapMemoryClasses[ uxMemoryClass ].xFreeBytesRemaining;
+        }
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -475,6 +723,14 @@ void * pvPortCalloc( size_t xNum,
         if( pv != NULL )
         {
             ( void ) memset( pv, 0, xNum * xSize );
+
+            #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+            {
+                /* Attribute the block to the caller of pvPortCalloc() rather
+                 * than to pvPortCalloc() itself. */
+                ( ( BlockLink_t * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize ) )->pvCaller = configHEAP_CALLER_ADDRESS();
+            }
+            #endif
         }
     }
 
@@ -482,6 +738,477 @@ void * pvPortCalloc( size_t xNum,
 }
 /*-----------------------------------------------------------*/
 
+void * pvPortRealloc( void * pv,
+                      size_t xWantedSize )
+{
+    BlockLink_t * pxLink;
+    BlockLink_t * pxIterator;
+    BlockLink_t * pxNextBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xNewBlockSize = xWantedSize;
+    size_t xOldBlockSize;
+    size_t xBlockSize;
+    size_t xAdditionalRequiredSize;
+    BaseType_t xResizedInPlace = pdFALSE;
+
+    if( pv == NULL )
+    {
+        pvReturn = pvPortMalloc( xWantedSize );
+    }
+    else if( xWantedSize == 0 )
+    {
+        vPortFree( pv );
+    }
+    else
+    {
+        /* The memory being resized will have an BlockLink_t structure
+         * immediately before it. */
+        pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+        heapVALIDATE_BLOCK_POINTER( pxLink );
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == heapPROTECT_BLOCK_POINTER( NULL ) );
+
+        xOldBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+
+        /* The size of the block needed, calculated as by pvPortMalloc(). */
+        if( heapADD_WILL_OVERFLOW( xNewBlockSize, xHeapStructSize ) == 0 )
+        {
+            xNewBlockSize += xHeapStructSize;
+
+            if( ( xNewBlockSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xNewBlockSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xNewBlockSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xNewBlockSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xNewBlockSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xNewBlockSize = 0;
+        }
+
+        if( ( xNewBlockSize > 0 ) && ( heapBLOCK_SIZE_IS_VALID( xNewBlockSize ) != 0 ) )
+        {
+            vTaskSuspendAll();
+            {
+                xBlockSize = xOldBlockSize;
+
+                if( xNewBlockSize <= xBlockSize )
+                {
+                    /* Shrinking - the block stays where it is, and the end of
+                     * it is freed if it is large enough to be a block of its
+                     * own. */
+                    xResizedInPlace = pdTRUE;
+                }
+                else
+                {
+                    /* Growing - the block can only stay where it is if the
+                     * block immediately after it is free and large enough to
+                     * make up the difference.  The free list is in address
+                     * order, so find where that block would be in the list. */
+                    pxNextBlock = ( BlockLink_t * ) ( ( ( uint8_t * ) pxLink ) + xBlockSize );
+
+                    for( pxIterator = &xStart; heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) < pxNextBlock; pxIterator = heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) )
+                    {
+                        /* Nothing to do here, just iterate to the right position. */
+                    }
+
+                    if( ( heapPROTECT_BLOCK_POINTER( pxIterator->pxNextFreeBlock ) == pxNextBlock ) &&
+                        ( pxNextBlock != pxEnd ) &&
+                        ( ( xNewBlockSize - xBlockSize ) <= pxNextBlock->xBlockSize ) )
+                    {
+                        heapVALIDATE_BLOCK_POINTER( pxNextBlock );
+
+                        /* Take the next block out of the list of free blocks
+                         * and add it to this one.  The free bytes are updated
+                         * below, once whatever this block does not need has
+                         * been returned. */
+                        pxIterator->pxNextFreeBlock = pxNextBlock->pxNextFreeBlock;
+                        xBlockSize += pxNextBlock->xBlockSize;
+                        xResizedInPlace = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xResizedInPlace != pdFALSE )
+                {
+                    /* Return whatever is beyond the new size to the list of
+                     * free blocks, where it is merged with the block after it
+                     * if that block is free. */
+                    if( ( xBlockSize - xNewBlockSize ) > heapMINIMUM_BLOCK_SIZE )
+                    {
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxLink ) + xNewBlockSize );
+                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                        pxNewBlockLink->xBlockSize = xBlockSize - xNewBlockSize;
+                        xBlockSize = xNewBlockSize;
+
+                        #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                        {
+                            ( void ) memset( ( ( uint8_t * ) pxNewBlockLink ) + xHeapStructSize, 0, pxNewBlockLink->xBlockSize - xHeapStructSize );
+                        }
+                        #endif
+
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Only the bytes the block has gained or lost change the
+                     * free bytes. */
+                    if( xBlockSize > xOldBlockSize )
+                    {
+                        xFreeBytesRemaining -= xBlockSize - xOldBlockSize;
+
+                        #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+                        {
+                            prvTakeMemoryClassBytes( pxLink, xBlockSize - xOldBlockSize );
+                        }
+                        #endif
+
+                        if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                        {
+                            xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        xFreeBytesRemaining += xOldBlockSize - xBlockSize;
+
+                        #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+                        {
+                            xHeapMemoryClasses[ prvGetMemoryClass( pxLink ) ].xFreeBytesRemaining += xOldBlockSize - xBlockSize;
+                        }
+                        #endif
+                    }
+
+                    pxLink->xBlockSize = xBlockSize;
+                    heapALLOCATE_BLOCK( pxLink );
+                    xNumberOfInPlaceReallocations++;
+
+                    #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+                    {
+                        xHeapMemoryClasses[ prvGetMemoryClass( pxLink ) ].xNumberOfInPlaceReallocations++;
+                    }
+                    #endif
+
+                    pvReturn = pv;
+
+                    /* Traced as a free of the old block and an allocation of
+                     * the new one at the same address. */
+                    traceFREE( pv, xOldBlockSize );
+                    traceMALLOC( pvReturn, xBlockSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xResizedInPlace == pdFALSE )
+        {
+            /* The block has to move.  If there is not enough memory then
+             * NULL is returned and the original block is left allocated, as
+             * with the C library realloc(). */
+            #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+            {
+                /* Keep the block in its memory class if there is room. */
+                pvReturn = prvHeapAllocate( xWantedSize, portHEAP_MEMORY_CLASS_BIT( prvGetMemoryClass( pxLink ) ), heapALL_MEMORY_CLASSES );
+            }
+            #else
+            {
+                pvReturn = prvHeapAllocate( xWantedSize, heapALL_MEMORY_CLASSES, 0 );
+            }
+            #endif
+
+            if( pvReturn != NULL )
+            {
+                ( void ) memcpy( pvReturn, pv, ( xWantedSize < ( xOldBlockSize - xHeapStructSize ) ) ? xWantedSize : ( xOldBlockSize - xHeapStructSize ) );
+                vPortFree( pv );
+
+                vTaskSuspendAll();
+                {
+                    xNumberOfMovedReallocations++;
+
+                    #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+                    {
+                        xHeapMemoryClasses[ prvGetMemoryClass( pvReturn ) ].xNumberOfMovedReallocations++;
+                    }
+                    #endif
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+    {
+        /* Attribute a new or moved block to the caller of pvPortRealloc(). */
+        if( ( pvReturn != NULL ) && ( pvReturn != pv ) )
+        {
+            ( ( BlockLink_t * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) )->pvCaller = configHEAP_CALLER_ADDRESS();
+        }
+    }
+    #endif
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocAligned( size_t xWantedSize,
+                            size_t xAlignment )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxAlignedBlock = NULL;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    size_t xPadding = 0;
+    size_t xAllocatedBlockSize = 0;
+
+    /* The alignment must be a power of two. */
+    configASSERT( ( xAlignment != 0 ) && ( ( xAlignment & ( xAlignment - 1 ) ) == 0 ) );
+
+    if( ( xAlignment == 0 ) || ( ( xAlignment & ( xAlignment - 1 ) ) != 0 ) )
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+    else if( xAlignment <= portBYTE_ALIGNMENT )
+    {
+        /* Every block already has at least this alignment. */
+        pvReturn = pvPortMalloc( xWantedSize );
+
+        #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+        {
+            if( pvReturn != NULL )
+            {
+                ( ( BlockLink_t * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) )->pvCaller = configHEAP_CALLER_ADDRESS();
+            }
+        }
+        #endif
+    }
+    else
+    {
+        /* The size of the block needed, calculated as by pvPortMalloc(). */
+        if( ( xWantedSize > 0 ) && ( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 ) )
+        {
+            xWantedSize += xHeapStructSize;
+
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+
+        vTaskSuspendAll();
+        {
+            /* The heap must be initialised before the first call to
+             * pvPortMallocAligned(). */
+            configASSERT( pxEnd );
+
+            if( ( xWantedSize > 0 ) && ( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            {
+                /* Traverse the list from the start (lowest address) block until
+                 * one is found that can hold a block of the wanted size whose
+                 * memory starts on the wanted alignment. */
+                pxPreviousBlock = &xStart;
+                pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+
+                while( pxBlock != pxEnd )
+                {
+                    heapVALIDATE_BLOCK_POINTER( pxBlock );
+
+                    /* The bytes skipped to align the memory that follows the
+                     * block's BlockLink_t structure.  They are left in the
+                     * list of free blocks, so must be enough to form a block of
+                     * their own. */
+                    xPadding = ( xAlignment - ( ( ( size_t ) pxBlock + xHeapStructSize ) & ( xAlignment - 1 ) ) ) & ( xAlignment - 1 );
+
+                    while( ( xPadding != 0 ) && ( xPadding < heapMINIMUM_BLOCK_SIZE ) )
+                    {
+                        xPadding += xAlignment;
+                    }
+
+                    if( ( xPadding < pxBlock->xBlockSize ) && ( ( pxBlock->xBlockSize - xPadding ) >= xWantedSize ) )
+                    {
+                        break;
+                    }
+
+                    pxPreviousBlock = pxBlock;
+                    pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+                }
+
+                /* If the end marker was reached then a block of adequate size
+                 * was not found. */
+                if( pxBlock != pxEnd )
+                {
+                    if( xPadding == 0 )
+                    {
+                        /* Already aligned - take the whole block out of the
+                         * list of free blocks, as pvPortMalloc() does. */
+                        pxAlignedBlock = pxBlock;
+                        pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+                    }
+                    else
+                    {
+                        /* Split the padding off the front of the block.  The
+                         * padding stays in the list of free blocks in place of
+                         * the original block. */
+                        pxAlignedBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xPadding );
+                        pxAlignedBlock->xBlockSize = pxBlock->xBlockSize - xPadding;
+                        pxBlock->xBlockSize = xPadding;
+                        pxPreviousBlock = pxBlock;
+                    }
+
+                    /* If the block is larger than required it can be split into
+                     * two, as in pvPortMalloc(). */
+                    if( ( pxAlignedBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+                    {
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxAlignedBlock ) + xWantedSize );
+                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                        pxNewBlockLink->xBlockSize = pxAlignedBlock->xBlockSize - xWantedSize;
+                        pxAlignedBlock->xBlockSize = xWantedSize;
+
+                        pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+                        pxPreviousBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xFreeBytesRemaining -= pxAlignedBlock->xBlockSize;
+
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+                    {
+                        prvTakeMemoryClassBytes( pxAlignedBlock, pxAlignedBlock->xBlockSize );
+                        xHeapMemoryClasses[ prvGetMemoryClass( pxAlignedBlock ) ].xNumberOfSuccessfulAllocations++;
+                    }
+                    #endif
+
+                    xAllocatedBlockSize = pxAlignedBlock->xBlockSize;
+
+                    heapALLOCATE_BLOCK( pxAlignedBlock );
+                    pxAlignedBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER( NULL );
+                    xNumberOfSuccessfulAllocations++;
+
+                    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+                    {
+                        prvTrackAllocation( pxAlignedBlock, configHEAP_CALLER_ADDRESS() );
+                    }
+                    #endif
+
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxAlignedBlock ) + xHeapStructSize );
+                    heapVALIDATE_BLOCK_POINTER( pvReturn );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceMALLOC( pvReturn, xAllocatedBlockSize );
+
+            /* Prevent compiler warnings when trace macros are not used. */
+            ( void ) xAllocatedBlockSize;
+        }
+        ( void ) xTaskResumeAll();
+
+        #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                vApplicationMallocFailedHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+    }
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( xAlignment - 1 ) ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFreeAligned( void * pv )
+{
+    /* pvPortMallocAligned() returns an ordinary block, with its BlockLink_t
+     * structure immediately before the returned address. */
+    vPortFree( pv );
+}
+/*-----------------------------------------------------------*/
+
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
 {
     BlockLink_t * pxIterator;
@@ -646,6 +1373,22 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVI
 
         xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
 
+        #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+        {
+            configASSERT( xDefinedRegions < ( BaseType_t ) configHEAP_MAX_REGIONS );
+            configASSERT( pxHeapRegion->uxMemoryClass < ( UBaseType_t ) configHEAP_NUMBER_OF_MEMORY_CLASSES );
+            configASSERT( pxHeapRegion->uxMemoryClass < ( sizeof( UBaseType_t ) * heapBITS_PER_BYTE ) );
+
+            /* The blocks of the region are all below its end marker. */
+            xHeapMemoryRegions[ xDefinedRegions ].pucEndAddress = ( uint8_t * ) pxEnd;
+            xHeapMemoryRegions[ xDefinedRegions ].uxMemoryClass = pxHeapRegion->uxMemoryClass;
+            xNumberOfHeapMemoryRegions = xDefinedRegions + 1;
+
+            xHeapMemoryClasses[ pxHeapRegion->uxMemoryClass ].xFreeBytesRemaining += pxFirstFreeBlockInRegion->xBlockSize;
+            xHeapMemoryClasses[ pxHeapRegion->uxMemoryClass ].xMinimumEverFreeBytesRemaining += pxFirstFreeBlockInRegion->xBlockSize;
+        }
+        #endif
+
         #if ( configENABLE_HEAP_PROTECTOR == 1 )
         {
             if( ( pucHeapHighAddress == NULL ) ||
@@ -721,12 +1464,212 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
         pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
         pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
         pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xNumberOfInPlaceReallocations = xNumberOfInPlaceReallocations;
+        pxHeapStats->xNumberOfMovedReallocations = xNumberOfMovedReallocations;
         pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
     }
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
 
+#if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+
+    void vPortGetHeapStatsForClass( UBaseType_t uxMemoryClass,
+                                    HeapStats_t * pxHeapStats )
+    {
+        BlockLink_t * pxBlock;
+        size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+        configASSERT( uxMemoryClass < ( UBaseType_t ) configHEAP_NUMBER_OF_MEMORY_CLASSES );
+
+        vTaskSuspendAll();
+        {
+            pxBlock = heapPROTECT_BLOCK_POINTER( xStart.pxNextFreeBlock );
+
+            if( pxBlock != NULL )
+            {
+                while( pxBlock != pxEnd )
+                {
+                    /* The zero sized blocks that link the regions are not
+                     * counted. */
+                    if( ( pxBlock->xBlockSize != 0 ) && ( prvGetMemoryClass( pxBlock ) == uxMemoryClass ) )
+                    {
+                        xBlocks++;
+
+                        if( pxBlock->xBlockSize > xMaxSize )
+                        {
+                            xMaxSize = pxBlock->xBlockSize;
+                        }
+
+                        if( pxBlock->xBlockSize < xMinSize )
+                        {
+                            xMinSize = pxBlock->xBlockSize;
+                        }
+                    }
+
+                    pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextFreeBlock );
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+        pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+        taskENTER_CRITICAL();
+        {
+            pxHeapStats->xAvailableHeapSpaceInBytes = xHeapMemoryClasses[ uxMemoryClass ].xFreeBytesRemaining;
+            pxHeapStats->xNumberOfSuccessfulAllocations = xHeapMemoryClasses[ uxMemoryClass ].xNumberOfSuccessfulAllocations;
+            pxHeapStats->xNumberOfSuccessfulFrees = xHeapMemoryClasses[ uxMemoryClass ].xNumberOfSuccessfulFrees;
+            pxHeapStats->xNumberOfInPlaceReallocations = xHeapMemoryClasses[ uxMemoryClass ].xNumberOfInPlaceReallocations;
+            pxHeapStats->xNumberOfMovedReallocations = xHeapMemoryClasses[ uxMemoryClass ].xNumberOfMovedReallocations;
+            pxHeapStats->xMinimumEverFreeBytesRemaining = xHeapMemoryClasses[ uxMemoryClass ].xMinimumEverFreeBytesRemaining;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetMemoryClass( const void * pv ) /* PRIVILEGED_FUNCTION */
+    {
+        BaseType_t xRegion;
+
+        /* The regions are in address order, so pv is in the first region
+         * that ends above it. */
+        for( xRegion = 0; xRegion < ( xNumberOfHeapMemoryRegions - 1 ); xRegion++ )
+        {
+            if( ( const uint8_t * ) pv < xHeapMemoryRegions[ xRegion ].pucEndAddress )
+            {
+                break;
+            }
+        }
+
+        return xHeapMemoryRegions[ xRegion ].uxMemoryClass;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTakeMemoryClassBytes( const BlockLink_t * pxBlock,
+                                         size_t xBytes ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapMemoryClass_t * pxMemoryClass = &( xHeapMemoryClasses[ prvGetMemoryClass( pxBlock ) ] );
+
+        pxMemoryClass->xFreeBytesRemaining -= xBytes;
+
+        if( pxMemoryClass->xFreeBytesRemaining < pxMemoryClass->xMinimumEverFreeBytesRemaining )
+        {
+            pxMemoryClass->xMinimumEverFreeBytesRemaining = pxMemoryClass->xFreeBytesRemaining;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_NUMBER_OF_MEMORY_CLASSES */
+
+#if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+
+    static void prvTrackAllocation( BlockLink_t * pxBlock,
+                                    void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        /* Blocks allocated before the scheduler is started have no owner -
+         * the current task is then just the last task created. */
+        if( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED )
+        {
+            pxBlock->xOwner = NULL;
+        }
+        else
+        {
+            pxBlock->xOwner = xTaskGetCurrentTaskHandle();
+        }
+
+        pxBlock->pvCaller = pvCaller;
+        pxBlock->xTimestamp = xTaskGetTickCount();
+
+        pxBlock->pxPreviousAllocatedBlock = heapPROTECT_BLOCK_POINTER( NULL );
+        pxBlock->pxNextAllocatedBlock = heapPROTECT_BLOCK_POINTER( pxAllocatedBlocks );
+
+        if( pxAllocatedBlocks != NULL )
+        {
+            pxAllocatedBlocks->pxPreviousAllocatedBlock = heapPROTECT_BLOCK_POINTER( pxBlock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxAllocatedBlocks = pxBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUntrackAllocation( BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxNext = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextAllocatedBlock );
+        BlockLink_t * pxPrevious = heapPROTECT_BLOCK_POINTER( pxBlock->pxPreviousAllocatedBlock );
+
+        if( pxNext != NULL )
+        {
+            heapVALIDATE_BLOCK_POINTER( pxNext );
+            pxNext->pxPreviousAllocatedBlock = pxBlock->pxPreviousAllocatedBlock;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxPrevious != NULL )
+        {
+            heapVALIDATE_BLOCK_POINTER( pxPrevious );
+            pxPrevious->pxNextAllocatedBlock = pxBlock->pxNextAllocatedBlock;
+        }
+        else
+        {
+            configASSERT( pxAllocatedBlocks == pxBlock );
+            pxAllocatedBlocks = pxNext;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortWalkHeapAllocations( HeapAllocationWalkFunction_t pxWalkFunction,
+                                           void * pvContext )
+    {
+        HeapAllocation_t xAllocation;
+        BlockLink_t * pxBlock;
+        UBaseType_t uxBlocks = 0;
+
+        vTaskSuspendAll();
+        {
+            for( pxBlock = pxAllocatedBlocks; pxBlock != NULL; pxBlock = heapPROTECT_BLOCK_POINTER( pxBlock->pxNextAllocatedBlock ) )
+            {
+                heapVALIDATE_BLOCK_POINTER( pxBlock );
+                configASSERT( heapBLOCK_IS_ALLOCATED( pxBlock ) != 0 );
+
+                uxBlocks++;
+
+                if( pxWalkFunction != NULL )
+                {
+                    xAllocation.pvAddress = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    xAllocation.xBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                    xAllocation.xOwner = pxBlock->xOwner;
+                    xAllocation.pvCaller = pxBlock->pvCaller;
+                    xAllocation.xTimestamp = pxBlock->xTimestamp;
+
+                    if( pxWalkFunction( &xAllocation, pvContext ) == pdFALSE )
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxBlocks;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configHEAP_TRACK_ALLOCATIONS */
+
 /*
  * Reset the state in this file. This state is normally initialized at start up.
  * This function must be called by the application before restarting the
@@ -740,6 +1683,17 @@ void vPortHeapResetState( void )
     xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
     xNumberOfSuccessfulAllocations = ( size_t ) 0U;
     xNumberOfSuccessfulFrees = ( size_t ) 0U;
+    xNumberOfInPlaceReallocations = ( size_t ) 0U;
+    xNumberOfMovedReallocations = ( size_t ) 0U;
+
+    #if ( configHEAP_TRACK_ALLOCATIONS == 1 )
+        pxAllocatedBlocks = NULL;
+    #endif
+
+    #if ( configHEAP_NUMBER_OF_MEMORY_CLASSES > 1 )
+        xNumberOfHeapMemoryRegions = 0;
+        ( void ) memset( xHeapMemoryClasses, 0x00, sizeof( xHeapMemoryClasses ) );
+    #endif
 
     #if ( configENABLE_HEAP_PROTECTOR == 1 )
         pucHeapHighAddress = NULL;
@@ -34,12 +34,20 @@
 * running are blocked in sigwait().
 *
 * Task switch is done by resuming the thread for the next task by
-* signaling the condition variable and then waiting on a condition variable
-* with the current thread.
+* signaling its event and then waiting on the event of the current thread.
+* On Linux an event is a futex word (see utils/wait_for_event.c), elsewhere
+* a condition variable.
 *
 * The timer interrupt uses SIGALRM and care is taken to ensure that
 * the signal handler runs only on the thread for the current task.
 *
+* When configNUMBER_OF_CORES is greater than 1 the threads of up to
+* configNUMBER_OF_CORES tasks run at the same time, each emulating a
+* core.  The task and ISR locks are spinlocks, a core is asked to
+* yield with SIGUSR2 and the tick is delivered to core 0 only.
+* vTaskEndScheduler() first stops the other cores (vPortStopOtherCores()),
+* leaving their threads asleep until the process exits.
+*
 * Use of part of the standard C library requires care as some
 * functions can take pthread mutexes internally which can result in
 * deadlocks as the FreeRTOS kernel can switch tasks while they're
@@ -50,17 +58,18 @@
 * semaphore or mutex.
 *
 * Note: When using LLDB (the default debugger on macOS) with this port,
-* suppress SIGUSR1 to prevent debugger interference. This can be
-* done by adding the following line to ~/.lldbinit:
+* suppress SIGUSR1 (and SIGUSR2 if there are multiple cores) to prevent
+* debugger interference. This can be done by adding the following line
+* to ~/.lldbinit:
 * `process handle SIGUSR1 -n true -p false -s false`
 *----------------------------------------------------------*/
 #ifdef __linux__
     #define _GNU_SOURCE
 #endif
-#include "portmacro.h"
 #include <errno.h>
 #include <pthread.h>
 #include <limits.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -77,7 +86,25 @@
 #include "utils/wait_for_event.h"
 /*-----------------------------------------------------------*/
 
-#define SIG_RESUME    SIGUSR1
+#define SIG_RESUME        SIGUSR1
+#define SIG_YIELD_CORE    SIGUSR2
+
+/* When configPOSIX_FAST_FORWARD_IDLE_TIME is 1 (requires configUSE_TICKLESS_IDLE)
+ * the idle task steps the tick count straight to the next task unblock time
+ * instead of waiting for it in real time, so long delays and timeouts complete
+ * as soon as every task is blocked.  Ticks still arrive in real time while any
+ * task other than the idle task is able to run. */
+#ifndef configPOSIX_FAST_FORWARD_IDLE_TIME
+    #define configPOSIX_FAST_FORWARD_IDLE_TIME    0
+#endif
+
+#if ( ( configPOSIX_FAST_FORWARD_IDLE_TIME == 1 ) && ( configUSE_TICKLESS_IDLE == 0 ) )
+    #error configUSE_TICKLESS_IDLE must be set to 1 to use configPOSIX_FAST_FORWARD_IDLE_TIME
+#endif
+
+#if ( ( configPOSIX_FAST_FORWARD_IDLE_TIME == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configPOSIX_FAST_FORWARD_IDLE_TIME is only supported when configNUMBER_OF_CORES is 1
+#endif
 
 typedef struct THREAD
 {
@@ -86,6 +113,9 @@ typedef struct THREAD
     void * pvParams;
     BaseType_t xDying;
     struct event * ev;
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xCoreID; /* Core the task is resumed on, set by the core resuming it. */
+    #endif
 } Thread_t;
 
 /*
@@ -111,7 +141,29 @@ static BaseType_t xSchedulerEnd = pdFALSE;
 static pthread_t hTimerTickThread;
 static bool xTimerTickThreadShouldRun;
 static uint64_t prvStartTimeNs;
+static volatile uint64_t ullPendingTicks;
 static pthread_key_t xThreadKey = 0;
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* A spinlock held by a core rather than by a thread, so it can be taken
+ * again by the core that already holds it. */
+    typedef struct PORT_LOCK
+    {
+        BaseType_t xOwnerCore; /* -1 when the lock is free. */
+        UBaseType_t uxNesting;
+    } PortLock_t;
+
+    static PortLock_t xLocks[ 2 ] = { { -1, 0 }, { -1, 0 } };
+
+/* The core the calling thread's task is running on. */
+    static __thread BaseType_t xThreadCoreID = 0;
+
+/* The core that called vPortStopOtherCores(), -1 until then, and the number
+ * of other cores that have stopped since. */
+    static BaseType_t xStoppingCore = -1;
+    static UBaseType_t uxStoppedCores = 0;
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
@@ -122,6 +174,11 @@ static void prvSwitchThread( Thread_t * xThreadToResume,
 static void prvSuspendSelf( Thread_t * thread );
 static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
+#if ( configNUMBER_OF_CORES > 1 )
+    static void prvYieldCoreHandler( int sig );
+    static BaseType_t prvCoreMustStop( BaseType_t xCoreID );
+    static void prvStopCore( void );
+#endif
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
 static void prvThreadKeyDestructor( void * pvData );
@@ -213,6 +270,7 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 {
     Thread_t * thread;
     pthread_attr_t xThreadAttributes;
+    sigset_t xOriginalSignalMask;
     size_t ulStackSize;
     int iRet;
 
@@ -236,7 +294,11 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 
     thread->ev = event_create();
 
-    vPortEnterCritical();
+    /* The new thread inherits the signal mask, so block all signals while
+     * it is created - it unblocks them when it is first resumed.  The mask
+     * is saved locally rather than with vPortEnterCritical() as tasks may be
+     * created on several cores at once. */
+    ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xOriginalSignalMask );
 
     iRet = pthread_create( &thread->pthread, &xThreadAttributes,
                            prvWaitForStart, thread );
@@ -246,7 +308,7 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
         prvFatalError( "pthread_create", iRet );
     }
 
-    vPortExitCritical();
+    ( void ) pthread_sigmask( SIG_SETMASK, &xOriginalSignalMask, NULL );
 
     return pxTopOfStack;
 }
@@ -254,10 +316,27 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 
 void vPortStartFirstTask( void )
 {
-    Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-    /* Start the first task. */
-    prvResumeThread( pxFirstThread );
+        /* Start the first task. */
+        prvResumeThread( pxFirstThread );
+    }
+    #else
+    {
+        Thread_t * pxFirstThread;
+        BaseType_t xCoreID;
+
+        /* Start the first task on every core. */
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+            pxFirstThread->xCoreID = xCoreID;
+            prvResumeThread( pxFirstThread );
+        }
+    }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 }
 /*-----------------------------------------------------------*/
 
@@ -326,6 +405,14 @@ void vPortEndScheduler( void )
     Thread_t * pxCurrentThread;
     BaseType_t xIsFreeRTOSThread;
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* The other cores were stopped by vTaskEndScheduler() before it
+         * deleted their idle tasks, so only this core is left running. */
+        configASSERT( __atomic_load_n( &uxStoppedCores, __ATOMIC_ACQUIRE ) == ( UBaseType_t ) ( configNUMBER_OF_CORES - 1 ) );
+    }
+    #endif
+
     /* Stop the timer tick thread. */
     xTimerTickThreadShouldRun = false;
     pthread_join( hTimerTickThread, NULL );
@@ -378,11 +465,26 @@ static void prvPortYieldFromISR( void )
     Thread_t * xThreadToSuspend;
     Thread_t * xThreadToResume;
 
-    xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        vTaskSwitchContext();
 
-    vTaskSwitchContext();
+        xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    }
+    #else
+    {
+        const BaseType_t xCoreID = xThreadCoreID;
 
-    xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+
+        vTaskSwitchContext( xCoreID );
+
+        xThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+        xThreadToResume->xCoreID = xCoreID;
+    }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
     prvSwitchThread( xThreadToResume, xThreadToSuspend );
 }
@@ -394,11 +496,25 @@ void vPortYield( void )
      * the thread could get stuck in a suspended state. */
     configASSERT( prvIsFreeRTOSThread() == pdTRUE );
 
-    vPortEnterCritical();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        vPortEnterCritical();
+
+        prvPortYieldFromISR();
+
+        vPortExitCritical();
+    }
+    #else
+    {
+        /* The kernel only yields outside of critical sections, so just mask
+         * the signals - the nesting count in the TCB must stay 0. */
+        UBaseType_t uxSavedInterruptStatus = xPortSetInterruptMask();
 
-    prvPortYieldFromISR();
+        prvPortYieldFromISR();
 
-    vPortExitCritical();
+        vPortClearInterruptMask( uxSavedInterruptStatus );
+    }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 }
 /*-----------------------------------------------------------*/
 
@@ -420,20 +536,174 @@ void vPortEnableInterrupts( void )
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t xPortSetInterruptMask( void )
-{
-    /* Interrupts are always disabled inside ISRs (signals
-     * handlers). */
-    return ( UBaseType_t ) 0;
-}
+#if ( configNUMBER_OF_CORES == 1 )
+
+    UBaseType_t xPortSetInterruptMask( void )
+    {
+        /* Interrupts are always disabled inside ISRs (signals
+         * handlers). */
+        return ( UBaseType_t ) 0;
+    }
 /*-----------------------------------------------------------*/
 
-void vPortClearInterruptMask( UBaseType_t uxMask )
-{
-    ( void ) uxMask;
-}
+    void vPortClearInterruptMask( UBaseType_t uxMask )
+    {
+        ( void ) uxMask;
+    }
 /*-----------------------------------------------------------*/
 
+#else /* if ( configNUMBER_OF_CORES == 1 ) */
+
+/* With multiple cores the kernel also masks interrupts from task code
+ * (portSET_INTERRUPT_MASK()), so the mask really is set and the previous
+ * state - 1 if signals were already blocked - is returned. */
+    UBaseType_t xPortSetInterruptMask( void )
+    {
+        sigset_t xPreviousSignalMask;
+
+        ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignalMask );
+
+        return ( UBaseType_t ) ( sigismember( &xPreviousSignalMask, SIGALRM ) == 1 );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortClearInterruptMask( UBaseType_t uxMask )
+    {
+        if( uxMask == 0U )
+        {
+            ( void ) pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPortGetCoreID( void )
+    {
+        return xThreadCoreID;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortYieldCore( BaseType_t xCoreID )
+    {
+        /* Called with the task and ISR locks held, so the task running on
+         * the core cannot change under our feet.  If its thread is still
+         * handing over the core the signal stays pending until the thread
+         * unblocks signals again. */
+        Thread_t * pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+
+        ( void ) pthread_kill( pxThread->pthread, SIG_YIELD_CORE );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetLock( BaseType_t xLock,
+                       BaseType_t xCoreID )
+    {
+        PortLock_t * pxLock = &( xLocks[ xLock ] );
+        BaseType_t xFree;
+
+        /* Only this core ever writes its own ID to the lock, so if it is
+         * there this core already holds the lock. */
+        if( __atomic_load_n( &( pxLock->xOwnerCore ), __ATOMIC_RELAXED ) != xCoreID )
+        {
+            for( ; ; )
+            {
+                xFree = -1;
+
+                if( __atomic_compare_exchange_n( &( pxLock->xOwnerCore ), &xFree, xCoreID, false,
+                                                 __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+                {
+                    break;
+                }
+
+                /* The core holding both locks may be waiting for this one
+                 * to stop. */
+                if( prvCoreMustStop( xCoreID ) == pdTRUE )
+                {
+                    prvStopCore();
+                }
+
+                /* The holder is a host thread that may not be scheduled by
+                 * the host right now, so give up the CPU rather than spin out
+                 * the rest of the time slice. */
+                ( void ) sched_yield();
+            }
+        }
+
+        pxLock->uxNesting++;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortReleaseLock( BaseType_t xLock,
+                           BaseType_t xCoreID )
+    {
+        PortLock_t * pxLock = &( xLocks[ xLock ] );
+
+        configASSERT( pxLock->xOwnerCore == xCoreID );
+        configASSERT( pxLock->uxNesting > 0U );
+
+        ( void ) xCoreID;
+
+        pxLock->uxNesting--;
+
+        if( pxLock->uxNesting == 0U )
+        {
+            __atomic_store_n( &( pxLock->xOwnerCore ), -1, __ATOMIC_RELEASE );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortStopOtherCores( void )
+    {
+        BaseType_t xCoreID;
+
+        /* With both locks held no other core is inside the kernel, so each
+         * one is either running task code, and stops in the handler of the
+         * yield sent to it below, or spinning on a lock, and stops there. */
+        taskENTER_CRITICAL();
+        {
+            __atomic_store_n( &xStoppingCore, xThreadCoreID, __ATOMIC_RELEASE );
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                if( xCoreID != xThreadCoreID )
+                {
+                    vPortYieldCore( xCoreID );
+                }
+            }
+
+            while( __atomic_load_n( &uxStoppedCores, __ATOMIC_ACQUIRE ) < ( UBaseType_t ) ( configNUMBER_OF_CORES - 1 ) )
+            {
+                ( void ) sched_yield();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCoreMustStop( BaseType_t xCoreID )
+    {
+        BaseType_t xStoppingCoreID = __atomic_load_n( &xStoppingCore, __ATOMIC_ACQUIRE );
+
+        return ( ( xStoppingCoreID != -1 ) && ( xStoppingCoreID != xCoreID ) ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStopCore( void )
+    {
+        ( void ) __atomic_add_fetch( &uxStoppedCores, 1U, __ATOMIC_RELEASE );
+
+        /* Signals are blocked here, so the thread sleeps until the process
+         * exits, or until its task is deleted as pause() is a cancellation
+         * point.  The core's task is never switched out, so the kernel
+         * leaves it alone. */
+        for( ; ; )
+        {
+            ( void ) pause();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
 static uint64_t prvGetTimeNs( void )
 {
     struct timespec t;
@@ -444,27 +714,82 @@ static uint64_t prvGetTimeNs( void )
 }
 /*-----------------------------------------------------------*/
 
-/* commented as part of the code below in vPortSystemTickHandler,
- * to adjust timing according to full demo requirements */
-/* static uint64_t prvTickCount; */
+static void prvSleepUntilNs( uint64_t ullWakeTimeNs )
+{
+    #ifdef __APPLE__
+        /* No clock_nanosleep() on macOS - sleep for whatever is left until
+         * the deadline, which is still free of accumulated drift. */
+        uint64_t ullNowNs = prvGetTimeNs();
+        struct timespec xSleepTime;
+
+        if( ullWakeTimeNs > ullNowNs )
+        {
+            xSleepTime.tv_sec = ( time_t ) ( ( ullWakeTimeNs - ullNowNs ) / 1000000000ULL );
+            xSleepTime.tv_nsec = ( long ) ( ( ullWakeTimeNs - ullNowNs ) % 1000000000ULL );
+            ( void ) nanosleep( &xSleepTime, NULL );
+        }
+    #else
+        struct timespec xWakeTime;
+
+        xWakeTime.tv_sec = ( time_t ) ( ullWakeTimeNs / 1000000000ULL );
+        xWakeTime.tv_nsec = ( long ) ( ullWakeTimeNs % 1000000000ULL );
+
+        while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xWakeTime, NULL ) == EINTR )
+        {
+        }
+    #endif
+}
+/*-----------------------------------------------------------*/
 
 static void * prvTimerTickHandler( void * arg )
 {
+    const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+    uint64_t ullNextTickNs;
+    uint64_t ullNowNs;
+    uint64_t ullElapsedTicks;
+
     ( void ) arg;
 
     prvMarkAsFreeRTOSThread();
 
     prvPortSetCurrentThreadName( "Scheduler timer" );
 
+    /* Ticks are generated against absolute deadlines, so the time taken to
+     * deliver and handle each tick does not accumulate as drift. */
+    ullNextTickNs = prvGetTimeNs() + ullTickPeriodNs;
+
     while( xTimerTickThreadShouldRun )
     {
+        prvSleepUntilNs( ullNextTickNs );
+
+        /* If the host stalled past more than one deadline, hand all the
+         * missed ticks to the tick handler in one batch (it processes them
+         * the way xTaskCatchUpTicks() would) rather than losing them, as
+         * repeated SIGALRMs would be merged into one.  The sleep can return
+         * before the deadline (nanosleep() wakes early on a signal), in which
+         * case no tick has elapsed yet. */
+        ullNowNs = prvGetTimeNs();
+
+        if( ullNowNs < ullNextTickNs )
+        {
+            continue;
+        }
+
+        ullElapsedTicks = 1U + ( ( ullNowNs - ullNextTickNs ) / ullTickPeriodNs );
+        ullNextTickNs += ullElapsedTicks * ullTickPeriodNs;
+
+        ( void ) __atomic_add_fetch( &ullPendingTicks, ullElapsedTicks, __ATOMIC_RELEASE );
+
         /*
          * signal to the active task to cause tick handling or
          * preemption (if enabled)
          */
-        Thread_t * thread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        #if ( configNUMBER_OF_CORES == 1 )
+            Thread_t * thread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        #else
+            Thread_t * thread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( 0 ) );
+        #endif
         pthread_kill( thread->pthread, SIGALRM );
-        usleep( portTICK_RATE_MICROSECONDS );
     }
 
     return NULL;
@@ -478,18 +803,23 @@ static void * prvTimerTickHandler( void * arg )
 void prvSetupTimerInterrupt( void )
 {
     xTimerTickThreadShouldRun = true;
+    ullPendingTicks = 0;
     pthread_create( &hTimerTickThread, NULL, prvTimerTickHandler, NULL );
 
     prvStartTimeNs = prvGetTimeNs();
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 static void vPortSystemTickHandler( int sig )
 {
     if( prvIsFreeRTOSThread() == pdTRUE )
     {
         Thread_t * pxThreadToSuspend;
         Thread_t * pxThreadToResume;
+        uint64_t ullTicks;
+        BaseType_t xSwitchRequired = pdFALSE;
 
         ( void ) sig;
 
@@ -497,7 +827,19 @@ static void vPortSystemTickHandler( int sig )
 
         pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-        if( xTaskIncrementTick() != pdFALSE )
+        /* Process every tick that elapsed since the last time the handler
+         * ran, then switch task at most once. */
+        ullTicks = __atomic_exchange_n( &ullPendingTicks, 0, __ATOMIC_ACQUIRE );
+
+        for( ; ullTicks > 0U; ullTicks-- )
+        {
+            if( xTaskIncrementTick() != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+        }
+
+        if( xSwitchRequired != pdFALSE )
         {
             /* Select Next Task. */
             vTaskSwitchContext();
@@ -516,6 +858,107 @@ static void vPortSystemTickHandler( int sig )
 }
 /*-----------------------------------------------------------*/
 
+#else /* if ( configNUMBER_OF_CORES == 1 ) */
+
+static void vPortSystemTickHandler( int sig )
+{
+    if( prvIsFreeRTOSThread() == pdTRUE )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        uint64_t ullTicks;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        ( void ) sig;
+
+        /* The tick is sent to core 0, but may be taken on another core if
+         * the thread it was sent to moved there in the meantime - the tick
+         * is processed just the same.  Time slicing on the other cores is
+         * requested by xTaskIncrementTick() through vPortYieldCore(). */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            ullTicks = __atomic_exchange_n( &ullPendingTicks, 0, __ATOMIC_ACQUIRE );
+
+            for( ; ullTicks > 0U; ullTicks-- )
+            {
+                if( xTaskIncrementTick() != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xSwitchRequired != pdFALSE )
+        {
+            prvPortYieldFromISR();
+        }
+    }
+    else
+    {
+        fprintf( stderr, "vPortSystemTickHandler called from non-FreeRTOS thread\n" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldCoreHandler( int sig )
+{
+    ( void ) sig;
+
+    /* Once vPortStopOtherCores() has been called the other cores stop
+     * here, and the core ending the scheduler ignores yields still pending
+     * from before as it no longer switches tasks through this handler. */
+    if( prvCoreMustStop( xThreadCoreID ) == pdTRUE )
+    {
+        prvStopCore();
+    }
+    else if( __atomic_load_n( &xStoppingCore, __ATOMIC_ACQUIRE ) == -1 )
+    {
+        /* Signals are blocked in this signal handler, and a thread only
+         * unblocks them while its task is running on xThreadCoreID. */
+        prvPortYieldFromISR();
+    }
+}
+/*-----------------------------------------------------------*/
+
+#endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        #if ( configPOSIX_FAST_FORWARD_IDLE_TIME == 1 )
+        {
+            /* Called by the idle task with the scheduler suspended.  Block the
+             * tick signal so a real tick cannot be pended between the check
+             * and the step - the step is then exact and the result does not
+             * depend on when the tick thread happens to fire. */
+            vPortEnterCritical();
+
+            /* eNoTasksWaitingTimeout means every other task is blocked
+             * indefinitely, so there is no unblock time to skip to. */
+            if( eTaskConfirmSleepModeStatus() == eStandardSleep )
+            {
+                /* Real ticks that are still waiting to be delivered fall
+                 * within the idle period being skipped. */
+                ( void ) __atomic_exchange_n( &ullPendingTicks, 0, __ATOMIC_ACQUIRE );
+
+                vTaskStepTick( xExpectedIdleTime );
+            }
+
+            vPortExitCritical();
+        }
+        #else /* if ( configPOSIX_FAST_FORWARD_IDLE_TIME == 1 ) */
+        {
+            /* The tick thread keeps running in real time, there is nothing
+             * to suppress. */
+            ( void ) xExpectedIdleTime;
+        }
+        #endif /* if ( configPOSIX_FAST_FORWARD_IDLE_TIME == 1 ) */
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 void vPortThreadDying( void * pxTaskToDelete,
                        volatile BaseType_t * pxPendYield )
 {
@@ -550,7 +993,11 @@ static void * prvWaitForStart( void * pvParams )
     prvSuspendSelf( pxThread );
 
     /* Resumed for the first time, unblocks all signals. */
-    uxCriticalNesting = 0;
+    #if ( configNUMBER_OF_CORES == 1 )
+        uxCriticalNesting = 0;
+    #else
+        xThreadCoreID = pxThread->xCoreID;
+    #endif
     vPortEnableInterrupts();
 
     /* Set thread name */
@@ -573,7 +1020,9 @@ static void * prvWaitForStart( void * pvParams )
 static void prvSwitchThread( Thread_t * pxThreadToResume,
                              Thread_t * pxThreadToSuspend )
 {
-    BaseType_t uxSavedCriticalNesting;
+    #if ( configNUMBER_OF_CORES == 1 )
+        BaseType_t uxSavedCriticalNesting;
+    #endif
 
     if( pxThreadToSuspend != pxThreadToResume )
     {
@@ -582,20 +1031,37 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
          *
          * The critical section nesting is per-task, so save it on the
          * stack of the current (suspending thread), restoring it when
-         * we switch back to this task.
+         * we switch back to this task.  With multiple cores the kernel
+         * keeps it in the TCB instead.
          */
-        uxSavedCriticalNesting = uxCriticalNesting;
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxSavedCriticalNesting = uxCriticalNesting;
+        #endif
 
         prvResumeThread( pxThreadToResume );
 
-        if( pxThreadToSuspend->xDying == pdTRUE )
-        {
-            pthread_exit( NULL );
-        }
+        /* With multiple cores another core may pick this task up again, and
+         * it may then be deleted while running there, before this thread has
+         * finished suspending - it must then keep running until it is
+         * switched out.  So the thread of a deleted task only ends when
+         * vPortCancelThread() cancels it. */
+        #if ( configNUMBER_OF_CORES == 1 )
+            if( pxThreadToSuspend->xDying == pdTRUE )
+            {
+                pthread_exit( NULL );
+            }
+        #endif
 
         prvSuspendSelf( pxThreadToSuspend );
 
-        uxCriticalNesting = uxSavedCriticalNesting;
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxCriticalNesting = uxSavedCriticalNesting;
+        #else
+            /* Another core may have picked this task up again before this
+             * thread had finished suspending - the resume is not lost as the
+             * event stays signalled, and the core is whichever resumed it. */
+            xThreadCoreID = pxThreadToSuspend->xCoreID;
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -665,6 +1131,23 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        struct sigaction sigyield;
+
+        sigyield.sa_flags = 0;
+        sigyield.sa_handler = prvYieldCoreHandler;
+        sigfillset( &sigyield.sa_mask );
+
+        iRet = sigaction( SIG_YIELD_CORE, &sigyield, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -102,21 +102,73 @@ extern void vPortYield( void );
 /* Critical section management. */
 extern void vPortDisableInterrupts( void );
 extern void vPortEnableInterrupts( void );
-#define portSET_INTERRUPT_MASK()      ( vPortDisableInterrupts() )
-#define portCLEAR_INTERRUPT_MASK()    ( vPortEnableInterrupts() )
 
 extern UBaseType_t xPortSetInterruptMask( void );
 extern void vPortClearInterruptMask( UBaseType_t xMask );
 
 extern void vPortEnterCritical( void );
 extern void vPortExitCritical( void );
-#define portSET_INTERRUPT_MASK_FROM_ISR()         xPortSetInterruptMask()
-#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    vPortClearInterruptMask( x )
-#define portDISABLE_INTERRUPTS()                  portSET_INTERRUPT_MASK()
-#define portENABLE_INTERRUPTS()                   portCLEAR_INTERRUPT_MASK()
-#define portENTER_CRITICAL()                      vPortEnterCritical()
-#define portEXIT_CRITICAL()                       vPortExitCritical()
 
+#if ( configNUMBER_OF_CORES == 1 )
+    #define portSET_INTERRUPT_MASK()                  ( vPortDisableInterrupts() )
+    #define portCLEAR_INTERRUPT_MASK()                ( vPortEnableInterrupts() )
+    #define portSET_INTERRUPT_MASK_FROM_ISR()         xPortSetInterruptMask()
+    #define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    vPortClearInterruptMask( x )
+    #define portDISABLE_INTERRUPTS()                  portSET_INTERRUPT_MASK()
+    #define portENABLE_INTERRUPTS()                   portCLEAR_INTERRUPT_MASK()
+    #define portENTER_CRITICAL()                      vPortEnterCritical()
+    #define portEXIT_CRITICAL()                       vPortExitCritical()
+#else /* if ( configNUMBER_OF_CORES == 1 ) */
+
+/* The critical nesting count belongs to the task, not to the host thread
+ * that emulates a core, so the kernel keeps it in the TCB. */
+    #define portCRITICAL_NESTING_IN_TCB               1
+
+    #define portSET_INTERRUPT_MASK()                  xPortSetInterruptMask()
+    #define portCLEAR_INTERRUPT_MASK( x )             vPortClearInterruptMask( x )
+    #define portSET_INTERRUPT_MASK_FROM_ISR()         xPortSetInterruptMask()
+    #define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    vPortClearInterruptMask( x )
+    #define portDISABLE_INTERRUPTS()                  vPortDisableInterrupts()
+    #define portENABLE_INTERRUPTS()                   vPortEnableInterrupts()
+    #define portENTER_CRITICAL()                      vTaskEnterCritical()
+    #define portEXIT_CRITICAL()                       vTaskExitCritical()
+    #define portENTER_CRITICAL_FROM_ISR()             vTaskEnterCriticalFromISR()
+    #define portEXIT_CRITICAL_FROM_ISR( x )           vTaskExitCriticalFromISR( x )
+#endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* Multiple cores.  Each core is emulated by the thread of the task it is
+ * running, the task and ISR locks are spinlocks that can be taken
+ * recursively by the core that holds them, and another core is made to
+ * yield by sending a signal to the thread it is running. */
+    extern BaseType_t xPortGetCoreID( void );
+    extern void vPortYieldCore( BaseType_t xCoreID );
+    extern void vPortGetLock( BaseType_t xLock,
+                              BaseType_t xCoreID );
+    extern void vPortReleaseLock( BaseType_t xLock,
+                                  BaseType_t xCoreID );
+    extern void vPortStopOtherCores( void );
+
+    #define portTASK_LOCK                       ( 0 )
+    #define portISR_LOCK                        ( 1 )
+
+    #define portGET_CORE_ID()                   xPortGetCoreID()
+    #define portYIELD_CORE( xCoreID )           vPortYieldCore( xCoreID )
+    #define portGET_TASK_LOCK( xCoreID )        vPortGetLock( portTASK_LOCK, ( xCoreID ) )
+    #define portRELEASE_TASK_LOCK( xCoreID )    vPortReleaseLock( portTASK_LOCK, ( xCoreID ) )
+    #define portGET_ISR_LOCK( xCoreID )         vPortGetLock( portISR_LOCK, ( xCoreID ) )
+    #define portRELEASE_ISR_LOCK( xCoreID )     vPortReleaseLock( portISR_LOCK, ( xCoreID ) )
+    #define portSTOP_OTHER_CORES()              vPortStopOtherCores()
+
+#endif /* if ( configNUMBER_OF_CORES > 1 ) */
+/*-----------------------------------------------------------*/
+
+/* Tickless idle.  See configPOSIX_FAST_FORWARD_IDLE_TIME in port.c. */
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )    vPortSuppressTicksAndSleep( xExpectedIdleTime )
 /*-----------------------------------------------------------*/
 
 extern void vPortThreadDying( void * pxTaskToDelete,
@@ -136,9 +188,14 @@ extern void vPortCancelThread( void * pxTaskToDelete );
  * which also imply a full memory barrier.
  *
  * Thus, only a compiler barrier is needed to prevent the compiler
- * reordering.
+ * reordering - unless there are multiple cores, in which case tasks
+ * really do run in parallel.
  */
-#define portMEMORY_BARRIER()                        __asm volatile ( "" ::: "memory" )
+#if ( configNUMBER_OF_CORES == 1 )
+    #define portMEMORY_BARRIER()                    __asm volatile ( "" ::: "memory" )
+#else
+    #define portMEMORY_BARRIER()                    __atomic_thread_fence( __ATOMIC_SEQ_CST )
+#endif
 
 extern uint32_t ulPortGetRunTime( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
@@ -26,114 +26,269 @@
  *
  */
 
+#ifdef __linux__
+    #define _GNU_SOURCE
+#endif
 #include <pthread.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <stdint.h>
 
 #include "wait_for_event.h"
 
-struct event
-{
-    pthread_mutex_t mutex;
-    pthread_mutexattr_t mutexattr;
-    pthread_cond_t cond;
-    bool event_triggered;
-};
+/* On Linux an event is a single futex word, so signalling a thread that is
+ * not yet waiting, or waiting for an event that is already signalled, needs no
+ * system call at all, and a real handoff costs one FUTEX_WAKE and one
+ * FUTEX_WAIT instead of a mutex and condition variable round trip.  Define
+ * WAIT_FOR_EVENT_NO_FUTEX to use the portable condition variable version. */
+#if defined( __linux__ ) && !defined( WAIT_FOR_EVENT_NO_FUTEX )
+    #define WAIT_FOR_EVENT_USE_FUTEX    1
+#else
+    #define WAIT_FOR_EVENT_USE_FUTEX    0
+#endif
+
+#if ( WAIT_FOR_EVENT_USE_FUTEX == 1 )
+
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    /* Values of the futex word.  An event only ever has a single waiter - the
+     * thread that owns it. */
+    #define EVENT_CLEAR        0 /* Not signalled, nobody waiting. */
+    #define EVENT_SIGNALLED    1 /* Signalled, not yet consumed by a wait. */
+    #define EVENT_WAITING      2 /* Not signalled, the owner is (about to be) asleep in FUTEX_WAIT. */
+
+    struct event
+    {
+        int32_t futex_word;
+    };
 /*-----------------------------------------------------------*/
 
-struct event * event_create( void )
-{
-    struct event * ev = malloc( sizeof( struct event ) );
+    static long futex_wait( int32_t * word,
+                            int32_t expected,
+                            const struct timespec * abs_timeout )
+    {
+        /* FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC timeout, so a wait
+         * interrupted by a signal can simply be restarted. */
+        return syscall( SYS_futex, word, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+                        expected, abs_timeout, NULL, FUTEX_BITSET_MATCH_ANY );
+    }
+/*-----------------------------------------------------------*/
 
-    if( ev != NULL )
+    static void futex_wake( int32_t * word )
     {
-        ev->event_triggered = false;
-        pthread_mutexattr_init( &ev->mutexattr );
-        #ifndef __APPLE__
-            pthread_mutexattr_setrobust( &ev->mutexattr, PTHREAD_MUTEX_ROBUST );
-        #endif
-        pthread_mutex_init( &ev->mutex, &ev->mutexattr );
-        pthread_cond_init( &ev->cond, NULL );
+        ( void ) syscall( SYS_futex, word, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, NULL, NULL, 0 );
     }
+/*-----------------------------------------------------------*/
+
+    /* Waits until the event is signalled or abs_timeout (if not NULL) passes.
+     * Returns true if the event was consumed. */
+    static bool event_wait_until( struct event * ev,
+                                  const struct timespec * abs_timeout )
+    {
+        int32_t expected = EVENT_SIGNALLED;
+
+        for( ; ; )
+        {
+            /* Consume a pending signal. */
+            if( __atomic_compare_exchange_n( &ev->futex_word, &expected, EVENT_CLEAR, false,
+                                             __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+            {
+                return true;
+            }
 
-    return ev;
-}
+            /* Announce that we are going to sleep, unless a signal arrived in
+             * the meantime, in which case go round again and consume it. */
+            if( expected == EVENT_CLEAR )
+            {
+                if( !__atomic_compare_exchange_n( &ev->futex_word, &expected, EVENT_WAITING, false,
+                                                  __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+                {
+                    expected = EVENT_SIGNALLED;
+                    continue;
+                }
+            }
+
+            if( ( futex_wait( &ev->futex_word, EVENT_WAITING, abs_timeout ) == -1 ) &&
+                ( errno == ETIMEDOUT ) )
+            {
+                /* Withdraw from waiting.  If that fails the event was signalled
+                 * just as the wait timed out, so consume it. */
+                expected = EVENT_WAITING;
+
+                if( __atomic_compare_exchange_n( &ev->futex_word, &expected, EVENT_CLEAR, false,
+                                                 __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+                {
+                    return false;
+                }
+            }
+
+            expected = EVENT_SIGNALLED;
+        }
+    }
 /*-----------------------------------------------------------*/
 
-void event_delete( struct event * ev )
-{
-    pthread_mutex_destroy( &ev->mutex );
-    pthread_mutexattr_destroy( &ev->mutexattr );
-    pthread_cond_destroy( &ev->cond );
-    free( ev );
-}
+    struct event * event_create( void )
+    {
+        struct event * ev = malloc( sizeof( struct event ) );
+
+        if( ev != NULL )
+        {
+            ev->futex_word = EVENT_CLEAR;
+        }
+
+        return ev;
+    }
 /*-----------------------------------------------------------*/
 
-bool event_wait( struct event * ev )
-{
-    if( pthread_mutex_lock( &ev->mutex ) == EOWNERDEAD )
+    void event_delete( struct event * ev )
     {
-        #ifndef __APPLE__
-            /* If the thread owning the mutex died, make the mutex consistent. */
-            pthread_mutex_consistent( &ev->mutex );
-        #endif
+        free( ev );
     }
+/*-----------------------------------------------------------*/
 
-    while( ev->event_triggered == false )
+    bool event_wait( struct event * ev )
     {
-        pthread_cond_wait( &ev->cond, &ev->mutex );
+        return event_wait_until( ev, NULL );
     }
+/*-----------------------------------------------------------*/
 
-    ev->event_triggered = false;
-    pthread_mutex_unlock( &ev->mutex );
-    return true;
-}
+    bool event_wait_timed( struct event * ev,
+                           time_t ms )
+    {
+        struct timespec ts;
+
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+        ts.tv_sec += ms / 1000;
+        ts.tv_nsec += ( ( ms % 1000 ) * 1000000 );
+
+        if( ts.tv_nsec >= 1000000000 )
+        {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+
+        return event_wait_until( ev, &ts );
+    }
 /*-----------------------------------------------------------*/
 
-bool event_wait_timed( struct event * ev,
-                       time_t ms )
-{
-    struct timespec ts;
-    int ret = 0;
+    void event_signal( struct event * ev )
+    {
+        /* Only enter the kernel if the owner is actually asleep. */
+        if( __atomic_exchange_n( &ev->futex_word, EVENT_SIGNALLED, __ATOMIC_RELEASE ) == EVENT_WAITING )
+        {
+            futex_wake( &ev->futex_word );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#else /* WAIT_FOR_EVENT_USE_FUTEX */
+
+    struct event
+    {
+        pthread_mutex_t mutex;
+        pthread_mutexattr_t mutexattr;
+        pthread_cond_t cond;
+        bool event_triggered;
+    };
+/*-----------------------------------------------------------*/
+
+    struct event * event_create( void )
+    {
+        struct event * ev = malloc( sizeof( struct event ) );
 
-    clock_gettime( CLOCK_REALTIME, &ts );
-    ts.tv_sec += ms / 1000;
-    ts.tv_nsec += ( ( ms % 1000 ) * 1000000 );
-    if( pthread_mutex_lock( &ev->mutex ) == EOWNERDEAD )
+        if( ev != NULL )
+        {
+            ev->event_triggered = false;
+            pthread_mutexattr_init( &ev->mutexattr );
+            #ifndef __APPLE__
+                pthread_mutexattr_setrobust( &ev->mutexattr, PTHREAD_MUTEX_ROBUST );
+            #endif
+            pthread_mutex_init( &ev->mutex, &ev->mutexattr );
+            pthread_cond_init( &ev->cond, NULL );
+        }
+
+        return ev;
+    }
+/*-----------------------------------------------------------*/
+
+    void event_delete( struct event * ev )
     {
-        #ifndef __APPLE__
-            /* If the thread owning the mutex died, make the mutex consistent. */
-            pthread_mutex_consistent( &ev->mutex );
-        #endif
+        pthread_mutex_destroy( &ev->mutex );
+        pthread_mutexattr_destroy( &ev->mutexattr );
+        pthread_cond_destroy( &ev->cond );
+        free( ev );
     }
+/*-----------------------------------------------------------*/
 
-    while( ( ev->event_triggered == false ) && ( ret == 0 ) )
+    bool event_wait( struct event * ev )
     {
-        ret = pthread_cond_timedwait( &ev->cond, &ev->mutex, &ts );
+        if( pthread_mutex_lock( &ev->mutex ) == EOWNERDEAD )
+        {
+            #ifndef __APPLE__
+                /* If the thread owning the mutex died, make the mutex consistent. */
+                pthread_mutex_consistent( &ev->mutex );
+            #endif
+        }
 
-        if( ( ret == -1 ) && ( errno == ETIMEDOUT ) )
+        while( ev->event_triggered == false )
         {
-            return false;
+            pthread_cond_wait( &ev->cond, &ev->mutex );
         }
+
+        ev->event_triggered = false;
+        pthread_mutex_unlock( &ev->mutex );
+        return true;
     }
+/*-----------------------------------------------------------*/
+
+    bool event_wait_timed( struct event * ev,
+                           time_t ms )
+    {
+        struct timespec ts;
+        int ret = 0;
 
-    ev->event_triggered = false;
-    pthread_mutex_unlock( &ev->mutex );
-    return true;
-}
+        clock_gettime( CLOCK_REALTIME, &ts );
+        ts.tv_sec += ms / 1000;
+        ts.tv_nsec += ( ( ms % 1000 ) * 1000000 );
+        if( pthread_mutex_lock( &ev->mutex ) == EOWNERDEAD )
+        {
+            #ifndef __APPLE__
+                /* If the thread owning the mutex died, make the mutex consistent. */
+                pthread_mutex_consistent( &ev->mutex );
+            #endif
+        }
+
+        while( ( ev->event_triggered == false ) && ( ret == 0 ) )
+        {
+            ret = pthread_cond_timedwait( &ev->cond, &ev->mutex, &ts );
+
+            if( ( ret == -1 ) && ( errno == ETIMEDOUT ) )
+            {
+                return false;
+            }
+        }
+
+        ev->event_triggered = false;
+        pthread_mutex_unlock( &ev->mutex );
+        return true;
+    }
 /*-----------------------------------------------------------*/
 
-void event_signal( struct event * ev )
-{
-    if( pthread_mutex_lock( &ev->mutex ) == EOWNERDEAD )
+    void event_signal( struct event * ev )
     {
-        #ifndef __APPLE__
-            /* If the thread owning the mutex died, make the mutex consistent. */
-            pthread_mutex_consistent( &ev->mutex );
-        #endif
+        if( pthread_mutex_lock( &ev->mutex ) == EOWNERDEAD )
+        {
+            #ifndef __APPLE__
+                /* If the thread owning the mutex died, make the mutex consistent. */
+                pthread_mutex_consistent( &ev->mutex );
+            #endif
+        }
+        ev->event_triggered = true;
+        pthread_cond_signal( &ev->cond );
+        pthread_mutex_unlock( &ev->mutex );
     }
-    ev->event_triggered = true;
-    pthread_cond_signal( &ev->cond );
-    pthread_mutex_unlock( &ev->mutex );
-}
 /*-----------------------------------------------------------*/
+
+#endif /* WAIT_FOR_EVENT_USE_FUTEX */
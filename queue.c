@@ -82,6 +82,41 @@ typedef struct SemaphoreData
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME          ( ( TickType_t ) 0U )
 
+/* The event list item value of a task waiting to read a reader-writer lock is
+ * set to queueRW_LOCK_TAKEN_FOR_TASK when the lock is taken on its behalf.  The
+ * top bit matches taskEVENT_LIST_ITEM_VALUE_IN_USE in tasks.c, so a priority
+ * change does not overwrite the value before the task runs. */
+#if ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS )
+    #define queueRW_LOCK_TAKEN_FOR_TASK    ( ( TickType_t ) 0xC000U )
+#elif ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_32_BITS )
+    #define queueRW_LOCK_TAKEN_FOR_TASK    ( ( TickType_t ) 0xC0000000U )
+#elif ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_64_BITS )
+    #define queueRW_LOCK_TAKEN_FOR_TASK    ( ( TickType_t ) 0xC000000000000000U )
+#endif
+
+/* A task blocked in xQueueSemaphoreTakeN() holds the count it is waiting for in
+ * its event list item value, below the top two bits.  tasks.c sets the top bit
+ * while the task waits, and the value is set to
+ * queueSEMAPHORE_COUNT_TAKEN_FOR_TASK when the count is taken on its behalf. */
+#define queueSEMAPHORE_COUNT_CONTROL_BITS      queueRW_LOCK_TAKEN_FOR_TASK
+#define queueSEMAPHORE_COUNT_TAKEN_FOR_TASK    queueRW_LOCK_TAKEN_FOR_TASK
+
+/* The ucSetPriority value that marks a queue as a priority queue set.  The
+ * uxMessagesWaiting member of a priority queue set holds a bitmap with bit n set
+ * if the member of priority n may hold data, and its storage area holds one
+ * member handle per priority. */
+#define queuePRIORITY_QUEUE_SET    ( ( uint8_t ) 0xFFU )
+#define queuePRIORITY_SET_BIT( uxPriority )    ( ( ( UBaseType_t ) 1U ) << ( uxPriority ) )
+
+/* A send using a copy position for which queueCOPY_POSITION_OVERWRITES() is
+ * true succeeds even when the queue is full, in which case an item already in
+ * the queue is replaced and the number of items in the queue does not change. */
+#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+    #define queueCOPY_POSITION_OVERWRITES( xCopyPosition )    ( ( ( xCopyPosition ) == queueOVERWRITE ) || ( ( xCopyPosition ) == queueOVERWRITE_OLDEST ) )
+#else
+    #define queueCOPY_POSITION_OVERWRITES( xCopyPosition )    ( ( xCopyPosition ) == queueOVERWRITE )
+#endif
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -134,6 +169,24 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         uint8_t ucQueueType;
         uint16_t ucEverMaxMessagesWaiting;
     #endif
+
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+        UBaseType_t uxMutexSpins;            /**< The number of takes that polled the mutex while its holder was running.  Only used by mutexes. */
+        UBaseType_t uxMutexSpinAcquisitions; /**< The number of those takes that saw the mutex given while polling. */
+        UBaseType_t uxMutexBlocks;           /**< The number of times a task entered the Blocked state to wait for the mutex. */
+    #endif
+
+    #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+        UBaseType_t uxCeilingPriority; /**< The priority a task is raised to while it holds the mutex, or tskIDLE_PRIORITY if the mutex uses priority inheritance.  Only used by mutexes. */
+    #endif
+
+    #if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+        uint8_t ucSetPriority; /**< The priority of the queue within the priority queue set that contains it, or queuePRIORITY_QUEUE_SET if the queue is itself a priority queue set. */
+    #endif
+
+    #if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+        UBaseType_t uxOverrunCount; /**< The number of items discarded by sends with the queueOVERWRITE_OLDEST copy position. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -211,6 +264,14 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies one item of uxItemSize bytes into or out of the queue storage area.
+ * Used by prvCopyDataToQueue() and prvCopyDataFromQueue().
+ */
+static void prvCopyItem( void * const pvDestination,
+                         const void * const pvSource,
+                         const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -220,6 +281,35 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
     static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+
+/*
+ * Marks pxQueue as holding data in the priority queue set that contains it.
+ * Called by prvNotifyQueueSetContainer().
+ */
+    static BaseType_t prvNotifyPriorityQueueSet( Queue_t * const pxQueueSet,
+                                                 const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the highest priority member of a priority queue set that holds
+ * data, or NULL if none do.  Clears the bits of members found to be empty.
+ * Must be called from a critical section.
+ */
+    static Queue_t * prvGetReadyMember( Queue_t * const pxQueueSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by xQueueSelectFromSet() to wait for a member of a priority queue set
+ * to hold data.
+ */
+    static QueueSetMemberHandle_t prvSelectFromPriorityQueueSet( Queue_t * const pxQueueSet,
+                                                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fills in the member handles of a newly created priority queue set.
+ */
+    static void prvInitialisePriorityQueueSet( Queue_t * const pxQueueSet ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -250,6 +340,82 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  */
     static UBaseType_t prvGetHighestPriorityOfWaitToReceiveList( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+
+/*
+ * Take or give a semaphore or mutex that no task is blocked on, or part way
+ * through blocking on, in a single short critical section.  Return pdFALSE,
+ * having changed nothing, if the semaphore is contended or the take or give
+ * cannot complete without blocking - the caller then falls back to the full
+ * path.
+ */
+    static BaseType_t prvSemaphoreTakeFast( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvSemaphoreGiveFast( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+
+/*
+ * Poll a mutex that was found held, for as long as the task holding it is
+ * running on another core, up to configMUTEX_SPIN_ITERATIONS times.  Returns
+ * pdTRUE if the mutex was seen given, so the take should be attempted again
+ * rather than the calling task blocking.
+ */
+    static BaseType_t prvSpinOnMutex( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdFALSE if the mutex is held by a task that is not running.
+ */
+    static BaseType_t prvIsMutexHolderRunning( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+/*
+ * A reader-writer lock is a queue of type queueQUEUE_TYPE_RW_LOCK.
+ * uxMessagesWaiting counts the tasks holding the lock for reading, and
+ * u.xSemaphore.xMutexHolder is the task holding it for writing.  Readers wait
+ * in xTasksWaitingToReceive and writers in xTasksWaitingToSend.
+ */
+    static void prvInitialiseRWLock( Queue_t * pxNewQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the calling task could take the lock for writing (xWrite
+ * set) or reading without blocking.  Must be called from a critical section.
+ */
+    static BaseType_t prvRWLockIsAvailable( const Queue_t * const pxQueue,
+                                            const BaseType_t xWrite ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes the lock for reading on behalf of every task waiting to read it, and
+ * unblocks them.  Returns pdTRUE if a task of higher priority than the calling
+ * task was unblocked.  Must be called from a critical section.
+ */
+    static BaseType_t prvRWLockGrantToReaders( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+/*
+ * Unblocks, in the order they wait, the tasks waiting on a counting semaphore
+ * that its count covers, taking the count for those blocked in
+ * xQueueSemaphoreTakeN().  Returns pdTRUE if a task of higher priority than
+ * the calling task was unblocked.  Must be called from a critical section.
+ */
+    static BaseType_t prvSemaphoreWakeWaiters( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the task waiting at the head of xTasksWaitingToReceive after data
+ * or a count was added to the queue, or, if that task is blocked in
+ * xQueueSemaphoreTakeN(), the tasks prvSemaphoreWakeWaiters() unblocks.
+ * Returns as xTaskRemoveFromEventList().  Must be called from a critical
+ * section, with xTasksWaitingToReceive not empty.
+ */
+    static BaseType_t prvUnblockReceiver( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#else
+    #define prvUnblockReceiver( pxQueue )    xTaskRemoveFromEventList( &( ( pxQueue )->xTasksWaitingToReceive ) )
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -610,6 +776,18 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+    {
+        pxNewQueue->ucSetPriority = 0U;
+    }
+    #endif
+
+    #if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+    {
+        pxNewQueue->uxOverrunCount = ( UBaseType_t ) 0U;
+    }
+    #endif
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -630,6 +808,20 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+            {
+                pxNewQueue->uxMutexSpins = 0U;
+                pxNewQueue->uxMutexSpinAcquisitions = 0U;
+                pxNewQueue->uxMutexBlocks = 0U;
+            }
+            #endif
+
+            #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+            {
+                pxNewQueue->uxCeilingPriority = tskIDLE_PRIORITY;
+            }
+            #endif
+
             traceCREATE_MUTEX( pxNewQueue );
 
             /* Start with the semaphore in the expected state. */
@@ -689,6 +881,67 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType,
+                                                const UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+
+        traceENTER_xQueueCreateMutexWithCeiling( ucQueueType, uxCeilingPriority );
+
+        configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueCreateMutex( ucQueueType );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateMutexWithCeiling( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType,
+                                                      const UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+
+        traceENTER_xQueueCreateMutexWithCeilingStatic( ucQueueType, uxCeilingPriority, pxStaticQueue );
+
+        configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateMutexWithCeilingStatic( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_PRIORITY_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -756,6 +1009,33 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+
+    void vQueueGetMutexSpinStats( QueueHandle_t xMutex,
+                                  MutexSpinStats_t * pxSpinStats )
+    {
+        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+        traceENTER_vQueueGetMutexSpinStats( xMutex, pxSpinStats );
+
+        configASSERT( pxMutex );
+        configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+        configASSERT( pxSpinStats );
+
+        taskENTER_CRITICAL();
+        {
+            pxSpinStats->uxSpins = pxMutex->uxMutexSpins;
+            pxSpinStats->uxSpinAcquisitions = pxMutex->uxMutexSpinAcquisitions;
+            pxSpinStats->uxBlocks = pxMutex->uxMutexBlocks;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vQueueGetMutexSpinStats();
+    }
+
+#endif /* if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_RECURSIVE_MUTEXES == 1 )
 
     BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
@@ -869,104 +1149,1344 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_RECURSIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+#if ( configUSE_RW_LOCKS == 1 )
 
-    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
-                                                       const UBaseType_t uxInitialCount,
-                                                       StaticQueue_t * pxStaticQueue )
+    static void prvInitialiseRWLock( Queue_t * pxNewQueue )
     {
-        QueueHandle_t xHandle = NULL;
+        if( pxNewQueue != NULL )
+        {
+            /* The queue create function leaves the lock with no readers.  The
+             * mutex holder member records the writer. */
+            pxNewQueue->u.xSemaphore.xMutexHolder = NULL;
+            pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
 
-        traceENTER_xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-        if( ( uxMaxCount != 0U ) &&
-            ( uxInitialCount <= uxMaxCount ) )
+        QueueHandle_t xQueueCreateRWLock( void )
         {
-            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+            QueueHandle_t xNewQueue;
 
-            if( xHandle != NULL )
-            {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+            traceENTER_xQueueCreateRWLock();
 
-                traceCREATE_COUNTING_SEMAPHORE();
+            xNewQueue = xQueueGenericCreate( ( UBaseType_t ) 1, ( UBaseType_t ) 0, queueQUEUE_TYPE_RW_LOCK );
+            prvInitialiseRWLock( ( Queue_t * ) xNewQueue );
+
+            traceRETURN_xQueueCreateRWLock( xNewQueue );
+
+            return xNewQueue;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        QueueHandle_t xQueueCreateRWLockStatic( StaticQueue_t * pxStaticQueue )
+        {
+            QueueHandle_t xNewQueue;
+
+            traceENTER_xQueueCreateRWLockStatic( pxStaticQueue );
+
+            xNewQueue = xQueueGenericCreateStatic( ( UBaseType_t ) 1, ( UBaseType_t ) 0, NULL, pxStaticQueue, queueQUEUE_TYPE_RW_LOCK );
+            prvInitialiseRWLock( ( Queue_t * ) xNewQueue );
+
+            traceRETURN_xQueueCreateRWLockStatic( xNewQueue );
+
+            return xNewQueue;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvRWLockIsAvailable( const Queue_t * const pxQueue,
+                                            const BaseType_t xWrite )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxQueue->u.xSemaphore.xMutexHolder == NULL )
+        {
+            if( xWrite != pdFALSE )
+            {
+                if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+                /* Readers queue behind a waiting writer, so a stream of
+                 * readers cannot keep the writer waiting for ever. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
         else
         {
-            configASSERT( xHandle );
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_xQueueCreateCountingSemaphoreStatic( xHandle );
-
-        return xHandle;
+        return xReturn;
     }
-
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
-
-    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
-                                                 const UBaseType_t uxInitialCount )
+    static BaseType_t prvRWLockGrantToReaders( Queue_t * const pxQueue )
     {
-        QueueHandle_t xHandle = NULL;
+        BaseType_t xYieldRequired = pdFALSE;
 
-        traceENTER_xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount );
-
-        if( ( uxMaxCount != 0U ) &&
-            ( uxInitialCount <= uxMaxCount ) )
+        /* Take the lock for every waiting reader before waking it, so a writer
+         * cannot take the lock between the readers being woken and running.
+         * Each reader finds the mark in its event list item when it runs. */
+        while( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
         {
-            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+            listSET_LIST_ITEM_VALUE( listGET_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ), queueRW_LOCK_TAKEN_FOR_TASK );
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
 
-            if( xHandle != NULL )
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
             {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
-
-                traceCREATE_COUNTING_SEMAPHORE();
+                xYieldRequired = pdTRUE;
             }
             else
             {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
+
+        return xYieldRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueTakeRWLock( QueueHandle_t xRWLock,
+                                 const BaseType_t xWrite,
+                                 TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        BaseType_t xInheritanceOccurred = pdFALSE;
+        BaseType_t xMustBlock;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xRWLock;
+        List_t * const pxWaitingList = ( xWrite != pdFALSE ) ? &( pxQueue->xTasksWaitingToSend ) : &( pxQueue->xTasksWaitingToReceive );
+
+        traceENTER_xQueueTakeRWLock( xRWLock, xWrite, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize == 0 );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            configASSERT( xHandle );
-            mtCOVERAGE_TEST_MARKER();
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
         }
+        #endif
 
-        traceRETURN_xQueueCreateCountingSemaphore( xHandle );
-
-        return xHandle;
-    }
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( prvRWLockIsAvailable( pxQueue, xWrite ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE( pxQueue );
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
-/*-----------------------------------------------------------*/
+                    if( xWrite != pdFALSE )
+                    {
+                        /* Record the writer so tasks that block on the lock
+                         * can raise its priority. */
+                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                    }
+                    else
+                    {
+                        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
+                    }
 
-BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
-                              const void * const pvItemToQueue,
-                              TickType_t xTicksToWait,
-                              const BaseType_t xCopyPosition )
-{
-    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
-    TimeOut_t xTimeOut;
-    Queue_t * const pxQueue = xQueue;
+                    taskEXIT_CRITICAL();
 
-    traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+                    traceRETURN_xQueueTakeRWLock( pdPASS );
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_xQueueTakeRWLock( errQUEUE_EMPTY );
+
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    xMustBlock = ( prvRWLockIsAvailable( pxQueue, xWrite ) == pdFALSE ) ? pdTRUE : pdFALSE;
+
+                    if( ( xMustBlock != pdFALSE ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) )
+                    {
+                        /* As for a mutex, the writer inherits the priority of
+                         * the tasks it keeps waiting. */
+                        #if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+                        {
+                            vTaskSetBlockingMutexHolder( &( pxQueue->u.xSemaphore.xMutexHolder ) );
+                        }
+                        #endif
+
+                        if( xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder ) != pdFALSE )
+                        {
+                            xInheritanceOccurred = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( xMustBlock != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( pxWaitingList, xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* A reader may have been given the lock by the writer that
+                     * woke it - see prvRWLockGrantToReaders(). */
+                    if( xWrite == pdFALSE )
+                    {
+                        if( uxTaskResetEventItemValue() == queueRW_LOCK_TAKEN_FOR_TASK )
+                        {
+                            traceQUEUE_RECEIVE( pxQueue );
+                            traceRETURN_xQueueTakeRWLock( pdPASS );
+
+                            return pdPASS;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The lock became available, so attempt to take it
+                     * again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                taskENTER_CRITICAL();
+                {
+                    xMustBlock = ( prvRWLockIsAvailable( pxQueue, xWrite ) == pdFALSE ) ? pdTRUE : pdFALSE;
+
+                    if( xMustBlock != pdFALSE )
+                    {
+                        if( xInheritanceOccurred != pdFALSE )
+                        {
+                            UBaseType_t uxHighestWaitingPriority;
+                            UBaseType_t uxHighestWaitingWriterPriority = tskIDLE_PRIORITY;
+
+                            /* Disinherit down to the highest priority of the
+                             * readers and writers still waiting. */
+                            uxHighestWaitingPriority = prvGetHighestPriorityOfWaitToReceiveList( pxQueue );
+
+                            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                            {
+                                uxHighestWaitingWriterPriority = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToSend ) ) );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            if( uxHighestWaitingWriterPriority > uxHighestWaitingPriority )
+                            {
+                                uxHighestWaitingPriority = uxHighestWaitingWriterPriority;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
+                            {
+                                vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        /* Readers that queued behind this writer can now share
+                         * the lock with those already reading it. */
+                        if( ( xWrite != pdFALSE ) &&
+                            ( pxQueue->u.xSemaphore.xMutexHolder == NULL ) &&
+                            ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE ) )
+                        {
+                            if( prvRWLockGrantToReaders( pxQueue ) != pdFALSE )
+                            {
+                                queueYIELD_IF_USING_PREEMPTION();
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( xMustBlock != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueTakeRWLock( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueGiveRWLock( QueueHandle_t xRWLock,
+                                 const BaseType_t xWrite )
+    {
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xYieldRequired = pdFALSE;
+        Queue_t * const pxQueue = xRWLock;
+
+        traceENTER_xQueueGiveRWLock( xRWLock, xWrite );
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            if( xWrite != pdFALSE )
+            {
+                if( pxQueue->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+                {
+                    traceQUEUE_SEND( pxQueue );
+
+                    /* As in prvCopyDataToQueue() for a mutex. */
+                    xYieldRequired = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                    pxQueue->u.xSemaphore.xMutexHolder = NULL;
+
+                    /* Readers that waited for this writer go before the next
+                     * writer, so writers cannot starve them either. */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( prvRWLockGrantToReaders( pxQueue ) != pdFALSE )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+                {
+                    traceQUEUE_SEND( pxQueue );
+
+                    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+                    /* The last reader out wakes the writer waiting to go
+                     * next. */
+                    if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) &&
+                        ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xReturn == pdFAIL )
+        {
+            traceQUEUE_SEND_FAILED( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueGiveRWLock( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueTakeRWLockReadFromISR( QueueHandle_t xRWLock )
+    {
+        BaseType_t xReturn = pdFAIL;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xRWLock;
+
+        traceENTER_xQueueTakeRWLockReadFromISR( xRWLock );
+
+        configASSERT( pxQueue );
+
+        /* See the comments in xQueueReceiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            /* Taking the lock for reading never wakes a task, so the event
+             * lists are not touched and the queue lock does not matter. */
+            if( prvRWLockIsAvailable( pxQueue, pdFALSE ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xQueueTakeRWLockReadFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueGiveRWLockReadFromISR( QueueHandle_t xRWLock,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn = pdFAIL;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xRWLock;
+
+        traceENTER_xQueueGiveRWLockReadFromISR( xRWLock, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+
+        /* See the comments in xQueueReceiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                const int8_t cRxLock = pxQueue->cRxLock;
+
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+                if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+                {
+                    /* If the queue is locked the event list will not be
+                     * modified.  Instead update the lock count so the task that
+                     * unlocks the queue wakes the waiting writer, as
+                     * prvUnlockQueue() does for a task waiting to send. */
+                    if( cRxLock == queueUNLOCKED )
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                            {
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xQueueGiveRWLockReadFromISR( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
+                                                       const UBaseType_t uxInitialCount,
+                                                       StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xHandle = NULL;
+
+        traceENTER_xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+
+        if( ( uxMaxCount != 0U ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCountingSemaphoreStatic( xHandle );
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
+                                                 const UBaseType_t uxInitialCount )
+    {
+        QueueHandle_t xHandle = NULL;
+
+        traceENTER_xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount );
+
+        if( ( uxMaxCount != 0U ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCountingSemaphore( xHandle );
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+    static BaseType_t prvSemaphoreWakeWaiters( Queue_t * const pxQueue )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+        UBaseType_t uxUnclaimed = pxQueue->uxMessagesWaiting;
+        UBaseType_t uxWanted;
+        TickType_t xItemValue;
+
+        /* Tasks blocked in xQueueSemaphoreTake() wait ahead of those blocked in
+         * xQueueSemaphoreTakeN(), and take their one count themselves when they
+         * run, so the count is only set aside for them here.  The count wanted
+         * by a task blocked in xQueueSemaphoreTakeN() is taken on its behalf.
+         * The walk stops at the first task the remaining count does not cover,
+         * so a task waiting for a large count is not passed over by the tasks
+         * behind it for ever. */
+        while( ( uxUnclaimed > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+        {
+            xItemValue = listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+
+            if( ( xItemValue & queueSEMAPHORE_COUNT_CONTROL_BITS ) == ( TickType_t ) 0 )
+            {
+                uxWanted = ( UBaseType_t ) 1;
+            }
+            else
+            {
+                uxWanted = ( UBaseType_t ) ( xItemValue & ( TickType_t ) ~queueSEMAPHORE_COUNT_CONTROL_BITS );
+
+                if( uxWanted > uxUnclaimed )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                listSET_LIST_ITEM_VALUE( listGET_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ), queueSEMAPHORE_COUNT_TAKEN_FOR_TASK );
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - uxWanted );
+            }
+
+            uxUnclaimed = ( UBaseType_t ) ( uxUnclaimed - uxWanted );
+
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xYieldRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvUnblockReceiver( Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn;
+
+        /* A task blocked in xQueueSemaphoreTakeN() that was unblocked without
+         * the count it waits for would pass the count on to the tasks behind
+         * it and then wait again behind them, so a single give must not
+         * unblock it unless the count covers it. */
+        if( ( pxQueue->uxItemSize == ( UBaseType_t ) 0 ) &&
+            ( ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) & queueSEMAPHORE_COUNT_CONTROL_BITS ) != ( TickType_t ) 0 ) )
+        {
+            xReturn = prvSemaphoreWakeWaiters( pxQueue );
+        }
+        else
+        {
+            xReturn = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueSemaphoreGiveN( QueueHandle_t xQueue,
+                                     const UBaseType_t uxCount )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueSemaphoreGiveN( xQueue, uxCount );
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize == 0 );
+        configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+        configASSERT( uxCount > ( UBaseType_t ) 0 );
+
+        taskENTER_CRITICAL();
+        {
+            if( uxCount <= ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting ) )
+            {
+                traceQUEUE_SEND( pxQueue );
+
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxCount );
+
+                if( pxQueue->uxMessagesWaiting > pxQueue->ucEverMaxMessagesWaiting )
+                {
+                    pxQueue->ucEverMaxMessagesWaiting = ( uint16_t ) pxQueue->uxMessagesWaiting;
+                }
+
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        UBaseType_t ux;
+                        BaseType_t xYieldRequired = pdFALSE;
+
+                        /* The queue set holds one handle per count given. */
+                        for( ux = ( UBaseType_t ) 0; ux < uxCount; ux++ )
+                        {
+                            if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+
+                        if( xYieldRequired != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( prvSemaphoreWakeWaiters( pxQueue ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    if( prvSemaphoreWakeWaiters( pxQueue ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SETS */
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_SEND_FAILED( pxQueue );
+                xReturn = errQUEUE_FULL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xQueueSemaphoreGiveN( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueSemaphoreTakeN( QueueHandle_t xQueue,
+                                     const UBaseType_t uxCount,
+                                     TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        BaseType_t xMustBlock;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueSemaphoreTakeN( xQueue, uxCount, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize == 0 );
+        configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+        configASSERT( ( uxCount > ( UBaseType_t ) 0 ) && ( uxCount <= pxQueue->uxLength ) );
+
+        /* The count waited for is held in the event list item value. */
+        configASSERT( uxCount < ( UBaseType_t ) ( ( TickType_t ) ~queueSEMAPHORE_COUNT_CONTROL_BITS ) );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+
+                if( uxSemaphoreCount >= uxCount )
+                {
+                    traceQUEUE_RECEIVE( pxQueue );
+
+                    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - uxCount );
+
+                    /* As in xQueueSemaphoreTake(). */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+
+                    traceRETURN_xQueueSemaphoreTakeN( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_xQueueSemaphoreTakeN( errQUEUE_EMPTY );
+
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    xMustBlock = ( pxQueue->uxMessagesWaiting < uxCount ) ? pdTRUE : pdFALSE;
+
+                    /* A task that was unblocked without the count it waits
+                     * for, such as by xTaskAbortDelay(), may have left a count
+                     * that the tasks behind it can use.  Tasks woken here are
+                     * held on the pending ready list until the scheduler is
+                     * resumed. */
+                    if( xMustBlock != pdFALSE )
+                    {
+                        ( void ) prvSemaphoreWakeWaiters( pxQueue );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( xMustBlock != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                    /* Wait behind the tasks already waiting, so the count each
+                     * task waits for is taken for the tasks in the order they
+                     * started waiting - see prvSemaphoreWakeWaiters(). */
+                    vTaskPlaceOnUnorderedEventList( &( pxQueue->xTasksWaitingToReceive ), ( TickType_t ) uxCount, xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( uxTaskResetEventItemValue() == queueSEMAPHORE_COUNT_TAKEN_FOR_TASK )
+                    {
+                        traceQUEUE_RECEIVE( pxQueue );
+                        traceRETURN_xQueueSemaphoreTakeN( pdPASS );
+
+                        return pdPASS;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The count became available, so attempt to take it
+                     * again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                taskENTER_CRITICAL();
+                {
+                    xMustBlock = ( pxQueue->uxMessagesWaiting < uxCount ) ? pdTRUE : pdFALSE;
+
+                    /* The tasks that waited behind this one may be covered by
+                     * the count this task was waiting to grow. */
+                    if( xMustBlock != pdFALSE )
+                    {
+                        if( prvSemaphoreWakeWaiters( pxQueue ) != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( xMustBlock != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueSemaphoreTakeN( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueSemaphoreGiveNFromISR( QueueHandle_t xQueue,
+                                            const UBaseType_t uxCount,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
+        BaseType_t xYieldRequired = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+            UBaseType_t ux;
+        #endif
+
+        traceENTER_xQueueSemaphoreGiveNFromISR( xQueue, uxCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize == 0 );
+        configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+        configASSERT( uxCount > ( UBaseType_t ) 0 );
+
+        /* See the comment in xQueueGiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( uxCount <= ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting ) )
+            {
+                int8_t cTxLock = pxQueue->cTxLock;
+
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxCount );
+
+                if( pxQueue->uxMessagesWaiting > pxQueue->ucEverMaxMessagesWaiting )
+                {
+                    pxQueue->ucEverMaxMessagesWaiting = ( uint16_t ) pxQueue->uxMessagesWaiting;
+                }
+
+                /* The event list is not altered if the queue is locked.  This
+                 * will be done when the queue is unlocked later. */
+                if( cTxLock == queueUNLOCKED )
+                {
+                    #if ( configUSE_QUEUE_SETS == 1 )
+                    {
+                        if( pxQueue->pxQueueSetContainer != NULL )
+                        {
+                            for( ux = ( UBaseType_t ) 0; ux < uxCount; ux++ )
+                            {
+                                if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                                {
+                                    xYieldRequired = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                        }
+                        else
+                        {
+                            xYieldRequired = prvSemaphoreWakeWaiters( pxQueue );
+                        }
+                    }
+                    #else /* configUSE_QUEUE_SETS */
+                    {
+                        xYieldRequired = prvSemaphoreWakeWaiters( pxQueue );
+                    }
+                    #endif /* configUSE_QUEUE_SETS */
+                }
+                else
+                {
+                    /* The task that unlocks the queue wakes one waiting task
+                     * per increment of the lock count, so the lock count is
+                     * raised in one step by no more than the number of tasks
+                     * that can be woken. */
+                    const UBaseType_t uxNumberOfTasks = uxTaskGetNumberOfTasks();
+                    UBaseType_t uxIncrement = uxCount;
+                    UBaseType_t uxMaxIncrement = listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) );
+
+                    #if ( configUSE_QUEUE_SETS == 1 )
+                    {
+                        /* A member of a queue set instead posts to the set
+                         * once per increment. */
+                        if( pxQueue->pxQueueSetContainer != NULL )
+                        {
+                            uxMaxIncrement = uxCount;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_QUEUE_SETS */
+
+                    if( uxIncrement > uxMaxIncrement )
+                    {
+                        uxIncrement = uxMaxIncrement;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Capped at the number of tasks in the system, as by
+                     * prvIncrementQueueTxLock(). */
+                    if( ( UBaseType_t ) cTxLock < uxNumberOfTasks )
+                    {
+                        if( uxIncrement > ( uxNumberOfTasks - ( UBaseType_t ) cTxLock ) )
+                        {
+                            uxIncrement = uxNumberOfTasks - ( UBaseType_t ) cTxLock;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        configASSERT( ( ( UBaseType_t ) cTxLock + uxIncrement ) <= ( UBaseType_t ) queueINT8_MAX );
+                        pxQueue->cTxLock = ( int8_t ) ( ( UBaseType_t ) cTxLock + uxIncrement );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+                xReturn = errQUEUE_FULL;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+        {
+            *pxHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueSemaphoreGiveNFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueSemaphoreTakeNFromISR( QueueHandle_t xQueue,
+                                            const UBaseType_t uxCount,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueSemaphoreTakeNFromISR( xQueue, uxCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize == 0 );
+        configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+        configASSERT( uxCount > ( UBaseType_t ) 0 );
+
+        /* See the comment in xQueueReceiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+
+            /* Cannot block in an ISR, so check the whole count is available. */
+            if( uxSemaphoreCount >= uxCount )
+            {
+                const int8_t cRxLock = pxQueue->cRxLock;
+
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - uxCount );
+
+                if( cRxLock == queueUNLOCKED )
+                {
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                        {
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    prvIncrementQueueRxLock( pxQueue, cRxLock );
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xQueueSemaphoreTakeNFromISR( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
+                              const void * const pvItemToQueue,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xCopyPosition )
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE_OLDEST ) && ( ( configUSE_QUEUE_OVERWRITE_OLDEST == 0 ) || ( pxQueue->uxItemSize == ( UBaseType_t ) 0U ) ) ) );
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
         configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
     }
-    #endif
+    #endif
+
+    #if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+    {
+        /* xSemaphoreGive() sends to the back of a queue with no item size. */
+        if( ( pxQueue->uxItemSize == ( UBaseType_t ) 0U ) &&
+            ( xCopyPosition == queueSEND_TO_BACK ) &&
+            ( prvSemaphoreGiveFast( pxQueue ) != pdFALSE ) )
+        {
+            traceQUEUE_SEND( pxQueue );
+            traceRETURN_xQueueGenericSend( pdPASS );
+
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_SEMAPHORE_FAST_PATH */
 
     for( ; ; )
     {
@@ -974,9 +2494,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
         {
             /* Is there room on the queue now?  The running task must be the
              * highest priority task wanting to access the queue.  If the head item
-             * in the queue is to be overwritten then it does not matter if the
-             * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+             * in the queue is to be overwritten, or the oldest item dropped, then
+             * it does not matter if the queue is full. */
+            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( queueCOPY_POSITION_OVERWRITES( xCopyPosition ) ) )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -988,7 +2508,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 
                     if( pxQueue->pxQueueSetContainer != NULL )
                     {
-                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
+                        if( ( queueCOPY_POSITION_OVERWRITES( xCopyPosition ) ) && ( uxPreviousMessagesWaiting == pxQueue->uxLength ) )
                         {
                             /* Do not notify the queue set as an existing item
                              * was overwritten in the queue so the number of items
@@ -1013,7 +2533,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                          * queue then unblock it now. */
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( prvUnblockReceiver( pxQueue ) != pdFALSE )
                             {
                                 /* The unblocked task has a priority higher than
                                  * our own so yield immediately.  Yes it is ok to
@@ -1048,7 +2568,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                      * queue then unblock it now. */
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( prvUnblockReceiver( pxQueue ) != pdFALSE )
                         {
                             /* The unblocked task has a priority higher than
                              * our own so yield immediately.  Yes it is ok to do
@@ -1180,6 +2700,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
     configASSERT( pxQueue );
     configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE_OLDEST ) && ( ( configUSE_QUEUE_OVERWRITE_OLDEST == 0 ) || ( pxQueue->uxItemSize == ( UBaseType_t ) 0U ) ) ) );
 
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -1209,7 +2730,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
 	 * be masked. */
     uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( queueCOPY_POSITION_OVERWRITES( xCopyPosition ) ) )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1231,7 +2752,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 {
                     if( pxQueue->pxQueueSetContainer != NULL )
                     {
-                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
+                        if( ( queueCOPY_POSITION_OVERWRITES( xCopyPosition ) ) && ( uxPreviousMessagesWaiting == pxQueue->uxLength ) )
                         {
                             /* Do not notify the queue set as an existing item
                              * was overwritten in the queue so the number of items
@@ -1261,7 +2782,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                     {
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( prvUnblockReceiver( pxQueue ) != pdFALSE )
                             {
                                 /* The task waiting has a higher priority so
                                  *  record that a context switch is required. */
@@ -1289,7 +2810,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 {
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( prvUnblockReceiver( pxQueue ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -1317,6 +2838,14 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 }
                 #endif /* configUSE_QUEUE_SETS */
             }
+            else if( ( queueCOPY_POSITION_OVERWRITES( xCopyPosition ) ) && ( uxPreviousMessagesWaiting == pxQueue->uxLength ) )
+            {
+                /* The queue was already full, so no task can be waiting to
+                 * receive and a queue set already holds an event for every
+                 * item.  There is nothing for the task that unlocks the queue
+                 * to do. */
+                mtCOVERAGE_TEST_MARKER();
+            }
             else
             {
                 /* Increment the lock count so the task that unlocks the queue
@@ -1441,7 +2970,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                     {
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( prvUnblockReceiver( pxQueue ) != pdFALSE )
                             {
                                 /* The task waiting has a higher priority so
                                  *  record that a context switch is required. */
@@ -1469,7 +2998,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                 {
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( prvUnblockReceiver( pxQueue ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -1678,6 +3207,10 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
         BaseType_t xInheritanceOccurred = pdFALSE;
     #endif
 
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+        BaseType_t xSpun = pdFALSE;
+    #endif
+
     traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait );
 
     /* Check the queue pointer is not NULL. */
@@ -1694,6 +3227,22 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
     }
     #endif
 
+    #if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+    {
+        if( prvSemaphoreTakeFast( pxQueue ) != pdFALSE )
+        {
+            traceQUEUE_RECEIVE( pxQueue );
+            traceRETURN_xQueueSemaphoreTake( pdPASS );
+
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_SEMAPHORE_FAST_PATH */
+
     for( ; ; )
     {
         taskENTER_CRITICAL();
@@ -1719,6 +3268,19 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+                        {
+                            if( pxQueue->uxCeilingPriority != tskIDLE_PRIORITY )
+                            {
+                                vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif
                     }
                     else
                     {
@@ -1780,6 +3342,32 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
         }
         taskEXIT_CRITICAL();
 
+        #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+        {
+            /* A mutex held by a task running on another core is likely to be
+             * given sooner than the calling task could block and be switched
+             * back in, so poll it first - but only once per call, so a holder
+             * that keeps the mutex for long is not polled repeatedly. */
+            if( ( xSpun == pdFALSE ) && ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) )
+            {
+                xSpun = pdTRUE;
+
+                if( prvSpinOnMutex( pxQueue ) != pdFALSE )
+                {
+                    continue;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) ) */
+
         /* Interrupts and other tasks can give to and take from the semaphore
          * now the critical section has been exited. */
 
@@ -1806,7 +3394,30 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                             /* NOTE: Why needs critical section here? Seems to protect xMutexHolder->uxPriority, as an ISR
                              * might tries to gain another/this mutex that is also hold by the xMutexHolder?
                              * Need to verify if mutex is allowed in ISR context */
-                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+                                /* The holder of a priority ceiling mutex already
+                                 * runs at the ceiling, which is at least the
+                                 * priority of any task that takes the mutex, so
+                                 * there is nothing to inherit - or to disinherit
+                                 * should this task time out. */
+                                if( pxQueue->uxCeilingPriority == tskIDLE_PRIORITY )
+                            #endif
+                            {
+                                #if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+                                {
+                                    vTaskSetBlockingMutexHolder( &( pxQueue->u.xSemaphore.xMutexHolder ) );
+                                }
+                                #endif
+
+                                xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            }
+
+                            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+                            {
+                                pxQueue->uxMutexBlocks++;
+                            }
+                            #endif
                         }
                         taskEXIT_CRITICAL();
                     }
@@ -1949,7 +3560,7 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                  * any other tasks waiting for the data. */
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( prvUnblockReceiver( pxQueue ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority than this task. */
                         queueYIELD_IF_USING_PREEMPTION();
@@ -2271,6 +3882,28 @@ UBaseType_t uxQueueSpacesAvailableFromISR( const QueueHandle_t xQueue ) {
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+
+    UBaseType_t uxQueueGetOverrunCount( const QueueHandle_t xQueue )
+    {
+        UBaseType_t uxReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueGetOverrunCount( xQueue );
+
+        configASSERT( pxQueue );
+
+        /* A single read of a base type, so no critical section is needed. */
+        uxReturn = pxQueue->uxOverrunCount;
+
+        traceRETURN_uxQueueGetOverrunCount( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
 {
     UBaseType_t uxReturn;
@@ -2396,6 +4029,252 @@ UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+
+    static BaseType_t prvSemaphoreTakeFast( Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* Read without the critical section first, so a take that is going to
+         * block does not pay for two critical sections. */
+        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* A task that blocks on the queue locks it first, and stays on
+                 * an event list until it is woken, so an unlocked queue with no
+                 * task waiting to give has nothing the take would have to wake. */
+                if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+                    ( pxQueue->cRxLock == queueUNLOCKED ) &&
+                    ( pxQueue->cTxLock == queueUNLOCKED ) &&
+                    ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE ) )
+                {
+                    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+                    #if ( configUSE_MUTEXES == 1 )
+                    {
+                        /* The holder is recorded in the same critical section,
+                         * so a task that finds the mutex taken always finds its
+                         * holder to inherit the priority of. */
+                        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                        {
+                            pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                            #if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+                            {
+                                if( pxQueue->uxCeilingPriority != tskIDLE_PRIORITY )
+                                {
+                                    vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            #endif
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_MUTEXES */
+
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSemaphoreGiveFast( Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        /* As in prvSemaphoreTakeFast(), a give that has a task to wake goes
+         * straight to the full path. */
+        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                    ( pxQueue->cRxLock == queueUNLOCKED ) &&
+                    ( pxQueue->cTxLock == queueUNLOCKED ) &&
+                    ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) )
+                {
+                    xReturn = pdTRUE;
+
+                    #if ( configUSE_QUEUE_SETS == 1 )
+                    {
+                        /* The queue set has to be notified of the give. */
+                        if( pxQueue->pxQueueSetContainer != NULL )
+                        {
+                            xReturn = pdFALSE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_QUEUE_SETS */
+
+                    #if ( configUSE_MUTEXES == 1 )
+                    {
+                        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                        {
+                            /* Leave a give by a task that does not hold the
+                             * mutex to the full path, which asserts. */
+                            if( ( xReturn != pdFALSE ) && ( pxQueue->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() ) )
+                            {
+                                /* As in prvCopyDataToQueue(). */
+                                xYieldRequired = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                            }
+                            else
+                            {
+                                xReturn = pdFALSE;
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_MUTEXES */
+
+                    if( xReturn != pdFALSE )
+                    {
+                        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Giving a mutex can lower the priority of the task that held it
+         * below that of another ready task. */
+        if( xYieldRequired != pdFALSE )
+        {
+            queueYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_SEMAPHORE_FAST_PATH */
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) )
+
+    static BaseType_t prvSpinOnMutex( Queue_t * const pxQueue )
+    {
+        UBaseType_t uxPolls = 0U;
+        BaseType_t xReturn = pdFALSE;
+
+        /* The count is polled without a critical section, so the give being
+         * waited for is seen as soon as it happens.  The holder is only
+         * checked inside one, see prvIsMutexHolderRunning().  The take that
+         * follows a successful poll checks the count again inside the
+         * critical section. */
+        while( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) &&
+               ( uxPolls < ( UBaseType_t ) configMUTEX_SPIN_ITERATIONS ) &&
+               ( prvIsMutexHolderRunning( pxQueue ) != pdFALSE ) )
+        {
+            uxPolls++;
+        }
+
+        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( uxPolls > ( UBaseType_t ) 0 )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxQueue->uxMutexSpins++;
+
+                if( xReturn != pdFALSE )
+                {
+                    pxQueue->uxMutexSpinAcquisitions++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvIsMutexHolderRunning( Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdTRUE;
+
+        /* Read without a critical section, the holder could give the mutex,
+         * delete itself and be freed by the idle task between the read of
+         * xMutexHolder and the read of its TCB.  Inside the critical section
+         * the holder cannot give the mutex, so a holder read while the count
+         * is 0 stays valid until the critical section is exited. */
+        taskENTER_CRITICAL();
+        {
+            if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+            {
+                xReturn = xTaskIsRunning( pxQueue->u.xSemaphore.xMutexHolder );
+            }
+            else
+            {
+                /* Given since the poll, the caller sees the new count. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) && ( configMUTEX_SPIN_ITERATIONS > 0 ) ) */
+
 #if ( configUSE_MUTEXES == 1 )
 
     static UBaseType_t prvGetHighestPriorityOfWaitToReceiveList( const Queue_t * const pxQueue )
@@ -2451,9 +4330,37 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
         }
         #endif /* configUSE_MUTEXES */
     }
-    else if( xPosition == queueSEND_TO_BACK )
+    else if( ( xPosition == queueSEND_TO_BACK ) || ( xPosition == queueOVERWRITE_OLDEST ) )
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+        #if ( configUSE_QUEUE_OVERWRITE_OLDEST == 1 )
+        {
+            /* Only a queueOVERWRITE_OLDEST send gets here with the queue
+             * full.  The oldest item is then in the slot pcWriteTo points to,
+             * so discard it by moving the read position past that slot. */
+            if( uxMessagesWaiting == pxQueue->uxLength )
+            {
+                pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+                if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+                {
+                    pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                --uxMessagesWaiting;
+                pxQueue->uxOverrunCount++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_QUEUE_OVERWRITE_OLDEST */
+
+        prvCopyItem( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, pxQueue->uxItemSize );
         pxQueue->pcWriteTo += pxQueue->uxItemSize;
 
         if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
@@ -2467,7 +4374,7 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+        prvCopyItem( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, pxQueue->uxItemSize );
         pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
         if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead )
@@ -2526,7 +4433,30 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
             mtCOVERAGE_TEST_MARKER();
         }
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize );
+        prvCopyItem( pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, pxQueue->uxItemSize );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItem( void * const pvDestination,
+                         const void * const pvSource,
+                         const UBaseType_t uxItemSize )
+{
+    /* Queues of handles, pointers and other word sized items are common, and
+     * for them a memcpy() call with a size only known at run time costs more
+     * than the copy itself.  A memcpy() of a constant size is instead compiled
+     * to a load and a store, which also allows for unaligned items. */
+    if( uxItemSize == ( UBaseType_t ) sizeof( uint32_t ) )
+    {
+        ( void ) memcpy( pvDestination, pvSource, sizeof( uint32_t ) );
+    }
+    else if( uxItemSize == ( UBaseType_t ) ( 2U * sizeof( uint32_t ) ) )
+    {
+        ( void ) memcpy( pvDestination, pvSource, 2U * sizeof( uint32_t ) );
+    }
+    else
+    {
+        ( void ) memcpy( pvDestination, pvSource, ( size_t ) uxItemSize );
     }
 }
 /*-----------------------------------------------------------*/
@@ -2571,7 +4501,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                      * suspended. */
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( prvUnblockReceiver( pxQueue ) != pdFALSE )
                         {
                             /* The task waiting has a higher priority so record that a
                              * context switch is required. */
@@ -2594,7 +4524,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                  * the pending ready list as the scheduler is still suspended. */
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( prvUnblockReceiver( pxQueue ) != pdFALSE )
                     {
                         /* The task waiting has a higher priority so record that
                          * a context switch is required. */
@@ -3278,6 +5208,104 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* #if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_PRIORITY_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueSetHandle_t xQueueCreatePrioritySet( const UBaseType_t uxNumberOfPriorities )
+    {
+        QueueSetHandle_t pxQueue = NULL;
+
+        traceENTER_xQueueCreatePrioritySet( uxNumberOfPriorities );
+
+        /* Each priority is a bit in the ready bitmap. */
+        configASSERT( uxNumberOfPriorities <= queuePRIORITY_SET_MAX_PRIORITIES );
+
+        if( uxNumberOfPriorities <= queuePRIORITY_SET_MAX_PRIORITIES )
+        {
+            /* The storage area holds one member handle per priority, rather
+             * than one handle per item the members can hold. */
+            pxQueue = xQueueGenericCreate( uxNumberOfPriorities, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+
+            if( pxQueue != NULL )
+            {
+                prvInitialisePriorityQueueSet( pxQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreatePrioritySet( pxQueue );
+
+        return pxQueue;
+    }
+
+#endif /* #if ( ( configUSE_PRIORITY_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_PRIORITY_QUEUE_SETS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueSetHandle_t xQueueCreatePrioritySetStatic( const UBaseType_t uxNumberOfPriorities,
+                                                    uint8_t * pucQueueStorage,
+                                                    StaticQueue_t * pxStaticQueue )
+    {
+        QueueSetHandle_t pxQueue = NULL;
+
+        traceENTER_xQueueCreatePrioritySetStatic( uxNumberOfPriorities );
+
+        configASSERT( uxNumberOfPriorities <= queuePRIORITY_SET_MAX_PRIORITIES );
+
+        if( uxNumberOfPriorities <= queuePRIORITY_SET_MAX_PRIORITIES )
+        {
+            pxQueue = xQueueGenericCreateStatic( uxNumberOfPriorities, ( UBaseType_t ) sizeof( Queue_t * ), pucQueueStorage, pxStaticQueue, queueQUEUE_TYPE_SET );
+
+            if( pxQueue != NULL )
+            {
+                prvInitialisePriorityQueueSet( pxQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreatePrioritySetStatic( pxQueue );
+
+        return pxQueue;
+    }
+
+#endif /* #if ( ( configUSE_PRIORITY_QUEUE_SETS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+
+    static void prvInitialisePriorityQueueSet( Queue_t * const pxQueueSet )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        Queue_t ** const ppxMembers = ( Queue_t ** ) pxQueueSet->pcHead;
+        UBaseType_t uxPriority;
+
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < pxQueueSet->uxLength; uxPriority++ )
+        {
+            ppxMembers[ uxPriority ] = NULL;
+        }
+
+        pxQueueSet->ucSetPriority = queuePRIORITY_QUEUE_SET;
+    }
+
+#endif /* configUSE_PRIORITY_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
     BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
@@ -3294,6 +5322,18 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 /* Cannot add a queue/semaphore to more than one queue set. */
                 xReturn = pdFAIL;
             }
+
+            #if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+                else if( ( ( ( Queue_t * ) xQueueSet )->ucSetPriority == queuePRIORITY_QUEUE_SET ) ||
+                         ( ( ( Queue_t * ) xQueueOrSemaphore )->ucSetPriority == queuePRIORITY_QUEUE_SET ) )
+                {
+                    /* Members are added to a priority queue set with
+                     * xQueueAddToPrioritySet(), and a priority queue set cannot
+                     * itself be a member of a set. */
+                    xReturn = pdFAIL;
+                }
+            #endif
+
             else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxMessagesWaiting != ( UBaseType_t ) 0 )
             {
                 /* Cannot add a queue/semaphore to a queue set if there are already
@@ -3316,6 +5356,81 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+
+    BaseType_t xQueueAddToPrioritySet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                                       QueueSetHandle_t xQueueSet,
+                                       UBaseType_t uxPriority )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueueOrSemaphore = ( Queue_t * ) xQueueOrSemaphore;
+        Queue_t * const pxQueueSet = ( Queue_t * ) xQueueSet;
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        Queue_t ** const ppxMembers = ( Queue_t ** ) pxQueueSet->pcHead;
+
+        traceENTER_xQueueAddToPrioritySet( xQueueOrSemaphore, xQueueSet, uxPriority );
+
+        configASSERT( pxQueueOrSemaphore );
+        configASSERT( pxQueueSet->ucSetPriority == queuePRIORITY_QUEUE_SET );
+        configASSERT( uxPriority < pxQueueSet->uxLength );
+
+        taskENTER_CRITICAL();
+        {
+            if( ( pxQueueSet->ucSetPriority != queuePRIORITY_QUEUE_SET ) || ( uxPriority >= pxQueueSet->uxLength ) )
+            {
+                xReturn = pdFAIL;
+            }
+            else if( ( pxQueueOrSemaphore->pxQueueSetContainer != NULL ) || ( pxQueueOrSemaphore->ucSetPriority == queuePRIORITY_QUEUE_SET ) )
+            {
+                /* Cannot add a queue/semaphore to more than one queue set, or
+                 * add a priority queue set to a set. */
+                xReturn = pdFAIL;
+            }
+            else if( ppxMembers[ uxPriority ] != NULL )
+            {
+                /* Each member has its own priority. */
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                ppxMembers[ uxPriority ] = pxQueueOrSemaphore;
+                pxQueueOrSemaphore->ucSetPriority = ( uint8_t ) uxPriority;
+                pxQueueOrSemaphore->pxQueueSetContainer = pxQueueSet;
+                xReturn = pdPASS;
+
+                /* Unlike a queue set that holds a handle per item, a queue or
+                 * semaphore that already holds data can be added, as its bit
+                 * only records that it holds data. */
+                if( pxQueueOrSemaphore->uxMessagesWaiting != ( UBaseType_t ) 0 )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueueOrSemaphore ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xQueueAddToPrioritySet( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_PRIORITY_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
     BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
@@ -3331,6 +5446,28 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             /* The queue was not a member of the set. */
             xReturn = pdFAIL;
         }
+
+        #if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+            else if( pxQueueOrSemaphore->pxQueueSetContainer->ucSetPriority == queuePRIORITY_QUEUE_SET )
+            {
+                /* A priority queue set holds no events for its members, only
+                 * one bit and one handle per member, so the member can be
+                 * removed whether or not it holds data. */
+                taskENTER_CRITICAL();
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    ( ( Queue_t ** ) xQueueSet->pcHead )[ pxQueueOrSemaphore->ucSetPriority ] = NULL;
+                    xQueueSet->uxMessagesWaiting &= ~queuePRIORITY_SET_BIT( pxQueueOrSemaphore->ucSetPriority );
+                    pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+                    pxQueueOrSemaphore->ucSetPriority = 0U;
+                }
+                taskEXIT_CRITICAL();
+                xReturn = pdPASS;
+            }
+        #endif
+
         else if( pxQueueOrSemaphore->uxMessagesWaiting != ( UBaseType_t ) 0 )
         {
             /* It is dangerous to remove a queue from a set when the queue is
@@ -3366,7 +5503,16 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueSelectFromSet( xQueueSet, xTicksToWait );
 
-        ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait );
+        #if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+            if( xQueueSet->ucSetPriority == queuePRIORITY_QUEUE_SET )
+            {
+                xReturn = prvSelectFromPriorityQueueSet( xQueueSet, xTicksToWait );
+            }
+            else
+        #endif
+        {
+            ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait );
+        }
 
         traceRETURN_xQueueSelectFromSet( xReturn );
 
@@ -3384,7 +5530,25 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueSelectFromSetFromISR( xQueueSet );
 
-        ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL );
+        #if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+            if( xQueueSet->ucSetPriority == queuePRIORITY_QUEUE_SET )
+            {
+                UBaseType_t uxSavedInterruptStatus;
+
+                /* MISRA Ref 4.7.1 [Return value shall be checked] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+                /* coverity[misra_c_2012_directive_4_7_violation] */
+                uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+                {
+                    xReturn = prvGetReadyMember( xQueueSet );
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+        #endif
+        {
+            ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL );
+        }
 
         traceRETURN_xQueueSelectFromSetFromISR( xReturn );
 
@@ -3407,25 +5571,39 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * to prvNotifyQueueSetContainer is preceded by a check that
          * pxQueueSetContainer != NULL */
         configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
 
-        if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        #if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+            if( pxQueueSetContainer->ucSetPriority == queuePRIORITY_QUEUE_SET )
+            {
+                xReturn = prvNotifyPriorityQueueSet( pxQueueSetContainer, pxQueue );
+            }
+            else
+        #endif
         {
-            const int8_t cTxLock = pxQueueSetContainer->cTxLock;
+            configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
 
-            traceQUEUE_SET_SEND( pxQueueSetContainer );
+            if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+            {
+                const int8_t cTxLock = pxQueueSetContainer->cTxLock;
 
-            /* The data copied is the handle of the queue that contains data. */
-            xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+                traceQUEUE_SET_SEND( pxQueueSetContainer );
 
-            if( cTxLock == queueUNLOCKED )
-            {
-                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+                /* The data copied is the handle of the queue that contains data. */
+                xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+
+                if( cTxLock == queueUNLOCKED )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        /* The task waiting has a higher priority. */
-                        xReturn = pdTRUE;
+                        if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority. */
+                            xReturn = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
@@ -3433,21 +5611,203 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                     }
                 }
                 else
+                {
+                    prvIncrementQueueTxLock( pxQueueSetContainer, cTxLock );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUE_SETS == 1 )
+
+    static BaseType_t prvNotifyPriorityQueueSet( Queue_t * const pxQueueSet,
+                                                 const Queue_t * const pxQueue )
+    {
+        const int8_t cTxLock = pxQueueSet->cTxLock;
+        BaseType_t xReturn = pdFALSE;
+
+        /* This function must be called form a critical section. */
+
+        traceQUEUE_SET_SEND( pxQueueSet );
+
+        /* Nothing is copied, so the set cannot overflow however many items its
+         * members hold, and the bit is cleared lazily by prvGetReadyMember()
+         * once the member is found to be empty. */
+        pxQueueSet->uxMessagesWaiting |= queuePRIORITY_SET_BIT( pxQueue->ucSetPriority );
+
+        if( cTxLock == queueUNLOCKED )
+        {
+            if( listLIST_IS_EMPTY( &( pxQueueSet->xTasksWaitingToReceive ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueueSet->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    /* The task waiting has a higher priority. */
+                    xReturn = pdTRUE;
+                }
+                else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
             else
             {
-                prvIncrementQueueTxLock( pxQueueSetContainer, cTxLock );
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            prvIncrementQueueTxLock( pxQueueSet, cTxLock );
         }
 
         return xReturn;
     }
+/*-----------------------------------------------------------*/
 
-#endif /* configUSE_QUEUE_SETS */
+    static Queue_t * prvGetReadyMember( Queue_t * const pxQueueSet )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        Queue_t * const * const ppxMembers = ( Queue_t ** ) pxQueueSet->pcHead;
+        Queue_t * pxMember = NULL;
+        UBaseType_t uxPriority = pxQueueSet->uxLength;
+
+        /* Only bits below uxLength are ever set, so uxPriority cannot wrap
+         * while a bit remains. */
+        while( ( pxMember == NULL ) && ( pxQueueSet->uxMessagesWaiting != ( UBaseType_t ) 0 ) )
+        {
+            uxPriority--;
+
+            if( ( pxQueueSet->uxMessagesWaiting & queuePRIORITY_SET_BIT( uxPriority ) ) != ( UBaseType_t ) 0 )
+            {
+                if( ppxMembers[ uxPriority ]->uxMessagesWaiting != ( UBaseType_t ) 0 )
+                {
+                    pxMember = ppxMembers[ uxPriority ];
+                }
+                else
+                {
+                    /* The member has been emptied since its bit was set. */
+                    pxQueueSet->uxMessagesWaiting &= ~queuePRIORITY_SET_BIT( uxPriority );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return pxMember;
+    }
+/*-----------------------------------------------------------*/
+
+    static QueueSetMemberHandle_t prvSelectFromPriorityQueueSet( Queue_t * const pxQueueSet,
+                                                                 TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        BaseType_t xMustBlock;
+        TimeOut_t xTimeOut;
+        Queue_t * pxMember;
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /* This follows xQueueReceive(), except the member is only selected, not
+         * removed, so the caller must still read from the member it returns. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxMember = prvGetReadyMember( pxQueueSet );
+
+                if( pxMember != NULL )
+                {
+                    taskEXIT_CRITICAL();
+
+                    traceQUEUE_RECEIVE( pxQueueSet );
+
+                    return pxMember;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueueSet );
+
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueueSet );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    xMustBlock = ( prvGetReadyMember( pxQueueSet ) == NULL ) ? pdTRUE : pdFALSE;
+                }
+                taskEXIT_CRITICAL();
+
+                if( xMustBlock != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueueSet );
+                    vTaskPlaceOnEventList( &( pxQueueSet->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueueSet );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* A member holds data again.  Loop back to select it. */
+                    prvUnlockQueue( pxQueueSet );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  Loop back to make a final attempt with no block
+                 * time. */
+                prvUnlockQueue( pxQueueSet );
+                ( void ) xTaskResumeAll();
+
+                xTicksToWait = ( TickType_t ) 0;
+            }
+        }
+    }
+
+#endif /* configUSE_PRIORITY_QUEUE_SETS */
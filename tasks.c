@@ -332,6 +332,27 @@
 /* Indicates that the task is an Idle task. */
 #define taskATTRIBUTE_IS_IDLE    ( UBaseType_t ) ( 1U << 0U )
 
+/* Returns pdTRUE if the task is one of the Idle tasks. */
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskTASK_IS_IDLE( pxTCB )    ( ( ( pxTCB ) == xIdleTaskHandles[ 0 ] ) ? ( pdTRUE ) : ( pdFALSE ) )
+#else
+    #define taskTASK_IS_IDLE( pxTCB )    ( ( ( ( pxTCB )->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U ) ? ( pdTRUE ) : ( pdFALSE ) )
+#endif
+
+/* Reads the run time counter into ulValue.  When
+ * configUSE_EXTENDED_RUN_TIME_COUNTER is 1 the value returned by the port is
+ * extended to the width of configRUN_TIME_COUNTER_TYPE in software, so this
+ * must only be used from a critical section or from within the scheduler. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #if ( configUSE_EXTENDED_RUN_TIME_COUNTER == 1 )
+        #define taskGET_RUN_TIME_COUNTER_VALUE( ulValue )    ( ulValue ) = prvGetExtendedRunTimeCounterValue()
+    #elif defined( portALT_GET_RUN_TIME_COUNTER_VALUE )
+        #define taskGET_RUN_TIME_COUNTER_VALUE( ulValue )    portALT_GET_RUN_TIME_COUNTER_VALUE( ulValue )
+    #else
+        #define taskGET_RUN_TIME_COUNTER_VALUE( ulValue )    ( ulValue ) = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE()
+    #endif
+#endif /* configGENERATE_RUN_TIME_STATS */
+
 #if ( ( configNUMBER_OF_CORES > 1 ) && ( portCRITICAL_NESTING_IN_TCB == 1 ) )
     #define portGET_CRITICAL_NESTING_COUNT( xCoreID )          ( pxCurrentTCBs[ ( xCoreID ) ]->uxCriticalNesting )
     #define portSET_CRITICAL_NESTING_COUNT( xCoreID, x )       ( pxCurrentTCBs[ ( xCoreID ) ]->uxCriticalNesting = ( x ) )
@@ -397,6 +418,11 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         BaseType_t xPreemptionDisable; /**< Used to prevent the task from being preempted. */
     #endif
 
+    #if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+        TickType_t xTimeSliceTicks;          /**< The number of ticks the task may run before an equal priority task is given the processor. */
+        TickType_t xTimeSliceTicksRemaining; /**< The number of ticks left in the task's current time slice. */
+    #endif
+
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         StackType_t * pxEndOfStack; /**< Points to the highest valid address for the stack. */
     #endif
@@ -415,6 +441,10 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         UBaseType_t uxMutexesHeld;
     #endif
 
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+        TaskHandle_t * pxBlockedOnMutexHolder; /**< Points to the record of the holder of the mutex the task last blocked on.  Only valid while the task remains blocked - see prvTaskIsBlockedOnMutex(). */
+    #endif
+
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         TaskHookFunction_t pxTaskTag;
     #endif
@@ -427,6 +457,16 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /**< Stores the amount of time the task has spent in the Running state. */
     #endif
 
+    #if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+        UBaseType_t uxSwitchInCount;      /**< The number of times the task has been switched in. */
+        UBaseType_t uxPreemptedCount;     /**< The number of times the task was switched out while still in the Ready state. */
+        UBaseType_t uxBlockedCount;       /**< The number of times the task was switched out because it left the Ready state. */
+        #if ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxMigrationCount; /**< The number of times the task was switched in on a different core to the one it last ran on. */
+            BaseType_t xLastRunCore;      /**< The core the task last ran on, or taskTASK_NOT_RUNNING if it has never run. */
+        #endif
+    #endif
+
     #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         configTLS_BLOCK_TYPE xTLSBlock; /**< Memory block used as Thread Local Storage (TLS) Block for the task. */
     #endif
@@ -436,6 +476,10 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
     #endif
 
+    #if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+        UBaseType_t uxNotifyGroupCount; /**< The number of task notification groups the task is a member of, vTaskDelete() removes the task from them. */
+    #endif
+
     /* See the comments in FreeRTOS.h with the definition of
      * tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE. */
     #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
@@ -455,6 +499,27 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
  * below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+#if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+
+/*
+ * A task notification group, see xTaskNotifyGroupCreate().  Its members are
+ * held in ppxMembers[ 0 ] to ppxMembers[ uxMemberCount - 1 ].
+ */
+    typedef struct tskNotifyGroup
+    {
+        UBaseType_t uxIndexToNotify; /**< The index of the notification the members are sent. */
+        UBaseType_t uxMaxMembers;    /**< The number of entries in ppxMembers. */
+        UBaseType_t uxMemberCount;   /**< The number of entries in ppxMembers in use. */
+        TCB_t ** ppxMembers;         /**< The members, highest priority first as of the last time the group was notified. */
+        struct tskNotifyGroup * pxNextGroup; /**< The next group in pxNotifyGroups, so vTaskDelete() can find the groups a task is a member of. */
+
+        #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+            uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the group was created statically so no attempt is made to free the memory. */
+        #endif
+    } NotifyGroup_t;
+
+#endif
+
 #if ( configNUMBER_OF_CORES == 1 )
     /* MISRA Ref 8.4.1 [Declaration shall be visible] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-84 */
@@ -510,6 +575,10 @@ PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];       /**< Holds the handles of the idle tasks.  The idle tasks are created automatically when the scheduler is started. */
 
+#if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+    PRIVILEGED_DATA static NotifyGroup_t * pxNotifyGroups = NULL; /**< Every task notification group, only accessed with the scheduler suspended. */
+#endif
+
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
  * to determine the number of priority lists to read back from the remote target. */
@@ -537,6 +606,13 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
  * code working with debuggers that need to remove the static qualifier. */
 PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ] = { 0U };    /**< Holds the value of a timer/counter the last time a task was switched in. */
 PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime[ configNUMBER_OF_CORES ] = { 0U }; /**< Holds the total amount of execution time as defined by the run time counter clock. */
+PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulCoreTotalRunTime[ configNUMBER_OF_CORES ] = { 0U };      /**< Holds the run time accounted to all the tasks that have run on each core. */
+PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulCoreIdleRunTime[ configNUMBER_OF_CORES ] = { 0U };       /**< Holds the run time accounted to the Idle tasks while running on each core. */
+
+    #if ( configUSE_EXTENDED_RUN_TIME_COUNTER == 1 )
+        PRIVILEGED_DATA static configRUN_TIME_PORT_COUNTER_TYPE xLastPortRunTimeCounter = 0U; /**< Holds the value returned by the port the last time the run time counter was read. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulExtendedRunTimeCounter = 0U;     /**< Holds the run time counter extended to the width of configRUN_TIME_COUNTER_TYPE. */
+    #endif
 
 #endif
 
@@ -700,6 +776,132 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_MUTEXES == 1 )
+
+/*
+ * Raise the priority of a task that holds a mutex to uxInheritedPriority, or
+ * lower it again after a task waiting for the mutex timed out.  See
+ * xTaskPriorityInherit() and vTaskPriorityDisinheritAfterTimeout().
+ */
+    static void prvTaskInheritPriority( TCB_t * const pxTCB,
+                                        UBaseType_t uxInheritedPriority ) PRIVILEGED_FUNCTION;
+    static void prvTaskDisinheritPriorityAfterTimeout( TCB_t * const pxTCB,
+                                                       UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+
+/*
+ * Returns pdTRUE if pxTCB is blocked on a mutex.
+ */
+    static BaseType_t prvTaskIsBlockedOnMutex( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the task holding the mutex that pxTCB is blocked on, or NULL if
+ * pxTCB is not blocked on a mutex, the mutex is not held, or it is held by the
+ * calling task.  Used to follow a chain of blocked mutex holders.
+ */
+    static TCB_t * prvTaskGetBlockingMutexHolder( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move a task blocked on a mutex to the position in the mutex's list of
+ * waiting tasks that matches its event list item value.
+ */
+    static void prvTaskReorderEventListItem( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+/*
+ * Performs eAction on notification uxIndexToNotify of pxTCB, unblocking the
+ * task if it was waiting for that notification.  Returns pdFAIL if eAction is
+ * eSetValueWithoutOverwrite and the task already had a notification pending.
+ * Must be called from a critical section.
+ */
+    static BaseType_t prvTaskNotify( TCB_t * const pxTCB,
+                                     UBaseType_t uxIndexToNotify,
+                                     uint32_t ulValue,
+                                     eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+
+/*
+ * Fills in a newly allocated task notification group and adds it to
+ * pxNotifyGroups.
+ */
+    static void prvInitialiseNotifyGroup( NotifyGroup_t * pxNotifyGroup,
+                                          UBaseType_t uxIndexToNotify,
+                                          UBaseType_t uxMaxMembers,
+                                          TCB_t ** ppxMembers ) PRIVILEGED_FUNCTION;
+
+/*
+ * Puts the members of a task notification group in priority order, highest
+ * first.  Must be called with the scheduler suspended.
+ */
+    static void prvSortNotifyGroup( NotifyGroup_t * pxNotifyGroup ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE, and sets *puxMember to its position, if pxTCB is a member of
+ * the group.  Must be called with the scheduler suspended.
+ */
+    static BaseType_t prvFindNotifyGroupMember( const NotifyGroup_t * pxNotifyGroup,
+                                                const TCB_t * pxTCB,
+                                                UBaseType_t * puxMember ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes pxTCB from the group, returning pdFALSE if it was not a member.
+ * Must be called with the scheduler suspended.
+ */
+    static BaseType_t prvRemoveNotifyGroupMember( NotifyGroup_t * pxNotifyGroup,
+                                                  TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_EXTENDED_RUN_TIME_COUNTER == 1 ) )
+
+/*
+ * Read the run time counter provided by the port and add the time elapsed since
+ * the previous read to a counter of type configRUN_TIME_COUNTER_TYPE.  Only the
+ * difference between two reads is calculated in the width of the port's
+ * counter, so the result stays correct when the port's counter wraps provided
+ * it is read at least once per wrap period.  The tick interrupt reads it to
+ * guarantee that.  Must be called from a critical section or from within the
+ * scheduler.
+ */
+    static configRUN_TIME_COUNTER_TYPE prvGetExtendedRunTimeCounterValue( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+
+/*
+ * Called from vTaskSwitchContext() once the next task has been selected to
+ * update the context switch counters of the task being switched out and the
+ * task being switched in.  Nothing is counted if the same task was selected
+ * again.
+ */
+    static void prvUpdateContextSwitchStats( TCB_t * pxPreviousTCB,
+                                             TCB_t * pxNextTCB,
+                                             BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+
+/*
+ * Charge one tick to the time slice of a running task that shares its
+ * priority with other Ready state tasks.  Returns pdTRUE if the time slice
+ * has been used up, in which case a new time slice is started and the task
+ * should yield to the next task of equal priority.
+ */
+    static BaseType_t prvTimeSliceExpired( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -1936,6 +2138,19 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* configUSE_MUTEXES */
 
+    #if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+    {
+        pxNewTCB->xTimeSliceTicks = ( TickType_t ) configTASK_DEFAULT_TIME_SLICE_TICKS;
+        pxNewTCB->xTimeSliceTicksRemaining = ( TickType_t ) configTASK_DEFAULT_TIME_SLICE_TICKS;
+    }
+    #endif /* configUSE_PER_TASK_TIME_SLICE */
+
+    #if ( ( configGENERATE_CONTEXT_SWITCH_STATS == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    {
+        pxNewTCB->xLastRunCore = taskTASK_NOT_RUNNING;
+    }
+    #endif
+
     vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
     vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -2225,6 +2440,34 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
         traceENTER_vTaskDelete( xTaskToDelete );
 
+        #if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+        {
+            NotifyGroup_t * pxNotifyGroup;
+
+            /* Groups are only accessed with the scheduler suspended, so the
+             * task is taken out of them before the critical section below.  A
+             * group would otherwise keep notifying the deleted task's TCB. */
+            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
+            configASSERT( pxTCB != NULL );
+
+            if( pxTCB->uxNotifyGroupCount != ( UBaseType_t ) 0U )
+            {
+                vTaskSuspendAll();
+                {
+                    for( pxNotifyGroup = pxNotifyGroups; ( pxNotifyGroup != NULL ) && ( pxTCB->uxNotifyGroupCount != ( UBaseType_t ) 0U ); pxNotifyGroup = pxNotifyGroup->pxNextGroup )
+                    {
+                        ( void ) prvRemoveNotifyGroupMember( pxNotifyGroup, pxTCB );
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TASK_NOTIFY_GROUPS */
+
         taskENTER_CRITICAL();
         {
             /* If null is passed in here then it is the calling task that is
@@ -2232,6 +2475,14 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             pxTCB = prvGetTCBFromHandle( xTaskToDelete );
             configASSERT( pxTCB != NULL );
 
+            #if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+            {
+                /* Only fails if the task was added to a group while it was
+                 * being deleted. */
+                configASSERT( pxTCB->uxNotifyGroupCount == ( UBaseType_t ) 0U );
+            }
+            #endif
+
             /* Remove task from the ready/delayed list. */
             /* What if pxTCB is in delayedList? No worries, in taskRESET_READY_PRIORITY will 
 			 * check if pxReadyTasksLists[ ( uxPriority ) is empty, only adjust uxTopReadyPriority
@@ -3174,6 +3425,70 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+
+    void vTaskSetTimeSlice( TaskHandle_t xTask,
+                            TickType_t xTimeSliceTicks )
+    {
+        TCB_t * pxTCB;
+
+        traceENTER_vTaskSetTimeSlice( xTask, xTimeSliceTicks );
+
+        /* A time slice must contain at least one tick. */
+        configASSERT( xTimeSliceTicks > ( TickType_t ) 0U );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            pxTCB->xTimeSliceTicks = xTimeSliceTicks;
+
+            /* Don't let a shortened time slice be extended by the ticks left
+             * over from the previous setting. */
+            if( pxTCB->xTimeSliceTicksRemaining > xTimeSliceTicks )
+            {
+                pxTCB->xTimeSliceTicksRemaining = xTimeSliceTicks;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskSetTimeSlice();
+    }
+
+#endif /* #if ( configUSE_PER_TASK_TIME_SLICE == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+
+    TickType_t xTaskGetTimeSlice( ConstTaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        TickType_t xTimeSliceTicks;
+
+        traceENTER_xTaskGetTimeSlice( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            xTimeSliceTicks = pxTCB->xTimeSliceTicks;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xTaskGetTimeSlice( xTimeSliceTicks );
+
+        return xTimeSliceTicks;
+    }
+
+#endif /* #if ( configUSE_PER_TASK_TIME_SLICE == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskSuspend == 1 )
 
     void vTaskSuspend( TaskHandle_t xTaskToSuspend )
@@ -3202,6 +3517,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+            {
+                /* The task starts a whole time slice when it is resumed. */
+                pxTCB->xTimeSliceTicksRemaining = pxTCB->xTimeSliceTicks;
+            }
+            #endif
+
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
@@ -3790,6 +4112,28 @@ void vTaskStartScheduler( void )
          * FreeRTOSConfig.h file. */
         portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+        #if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+        {
+            /* The first task to run on each core is started by the port
+             * layer rather than by vTaskSwitchContext(), so count it here. */
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                ( pxCurrentTCB->uxSwitchInCount )++;
+            }
+            #else
+            {
+                BaseType_t xCoreID;
+
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    ( pxCurrentTCBs[ xCoreID ]->uxSwitchInCount )++;
+                    pxCurrentTCBs[ xCoreID ]->xLastRunCore = xCoreID;
+                }
+            }
+            #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+        }
+        #endif /* configGENERATE_CONTEXT_SWITCH_STATS */
+
         traceTASK_SWITCHED_IN();
 
         traceSTARTING_SCHEDULER( xIdleTaskHandles );
@@ -3832,6 +4176,15 @@ void vTaskEndScheduler( void )
 {
     traceENTER_vTaskEndScheduler();
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* A core whose idle task is deleted while it is running has no task
+         * left to select, so the other cores are stopped before the idle
+         * tasks are deleted below.  They stay on the task they were running. */
+        portSTOP_OTHER_CORES();
+    }
+    #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+
     #if ( INCLUDE_vTaskDelete == 1 )
     {
         BaseType_t xCoreID;
@@ -4531,11 +4884,11 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
                 {
                     if( pulTotalRunTime != NULL )
                     {
-                        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                            portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
-                        #else
-                            *pulTotalRunTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
-                        #endif
+                        taskENTER_CRITICAL();
+                        {
+                            taskGET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                        }
+                        taskEXIT_CRITICAL();
                     }
                 }
                 #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
@@ -4810,6 +5163,15 @@ BaseType_t xTaskIncrementTick( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_EXTENDED_RUN_TIME_COUNTER == 1 ) )
+        {
+            /* Read the port's run time counter on every tick so a wrap of the
+             * port's counter cannot go unnoticed even if no context switch
+             * occurs for longer than the counter's wrap period. */
+            ( void ) prvGetExtendedRunTimeCounterValue();
+        }
+        #endif
+
         /* See if this tick has made a timeout expire.  Tasks are stored in
          * the  queue in the order of their wake time - meaning once one task
          * has been found whose block time has not expired there is no need to
@@ -4916,7 +5278,12 @@ BaseType_t xTaskIncrementTick( void )
             {
                 if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U )
                 {
-                    xSwitchRequired = pdTRUE;
+                    #if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+                        if( prvTimeSliceExpired( pxCurrentTCB ) != pdFALSE )
+                    #endif
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
                 }
                 else
                 {
@@ -4931,7 +5298,12 @@ BaseType_t xTaskIncrementTick( void )
                 {
                     if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ) ) > 1U )
                     {
-                        xYieldPendings[ xCoreID ] = pdTRUE;
+                        #if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+                            if( prvTimeSliceExpired( pxCurrentTCBs[ xCoreID ] ) != pdFALSE )
+                        #endif
+                        {
+                            xYieldPendings[ xCoreID ] = pdTRUE;
+                        }
                     }
                     else
                     {
@@ -5177,22 +5549,27 @@ BaseType_t xTaskIncrementTick( void )
 
             #if ( configGENERATE_RUN_TIME_STATS == 1 )
             {
-                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime[ 0 ] );
-                #else
-                    ulTotalRunTime[ 0 ] = portGET_RUN_TIME_COUNTER_VALUE();
-                #endif
+                taskGET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime[ 0 ] );
 
                 /* Add the amount of time the task has been running to the
                  * accumulated time so far.  The time the task started running was
                  * stored in ulTaskSwitchedInTime.  Note that there is no overflow
                  * protection here so count values are only valid until the timer
-                 * overflows.  The guard against negative values is to protect
-                 * against suspect run time stat counter implementations - which
-                 * are provided by the application, not the kernel. */
+                 * overflows, unless configUSE_EXTENDED_RUN_TIME_COUNTER is 1.  The
+                 * guard against negative values is to protect against suspect run
+                 * time stat counter implementations - which are provided by the
+                 * application, not the kernel. */
                 if( ulTotalRunTime[ 0 ] > ulTaskSwitchedInTime[ 0 ] )
                 {
-                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime[ 0 ] - ulTaskSwitchedInTime[ 0 ] );
+                    const configRUN_TIME_COUNTER_TYPE ulTimeSinceLastSwitchedIn = ulTotalRunTime[ 0 ] - ulTaskSwitchedInTime[ 0 ];
+
+                    pxCurrentTCB->ulRunTimeCounter += ulTimeSinceLastSwitchedIn;
+                    ulCoreTotalRunTime[ 0 ] += ulTimeSinceLastSwitchedIn;
+
+                    if( taskTASK_IS_IDLE( pxCurrentTCB ) == pdTRUE )
+                    {
+                        ulCoreIdleRunTime[ 0 ] += ulTimeSinceLastSwitchedIn;
+                    }
                 }
                 else
                 {
@@ -5220,7 +5597,18 @@ BaseType_t xTaskIncrementTick( void )
             /* coverity[misra_c_2012_rule_11_5_violation] */
         /* NOTE: critical section is not required here since vTaskSwitchContext is only literally called in two places, one in vTaskSwitchContext 
 		 * with scheduler suspended. Another in pendSV handerler that temperarily raised base pri. */
-            taskSELECT_HIGHEST_PRIORITY_TASK();
+            #if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+            {
+                TCB_t * const pxPreviousTCB = pxCurrentTCB;
+
+                taskSELECT_HIGHEST_PRIORITY_TASK();
+                prvUpdateContextSwitchStats( pxPreviousTCB, pxCurrentTCB, 0 );
+            }
+            #else
+            {
+                taskSELECT_HIGHEST_PRIORITY_TASK();
+            }
+            #endif /* configGENERATE_CONTEXT_SWITCH_STATS */
             traceTASK_SWITCHED_IN();
 
             /* Macro to inject port specific behaviour immediately after
@@ -5235,6 +5623,13 @@ BaseType_t xTaskIncrementTick( void )
             }
             #endif
 
+            /* A task that is running is not blocked on a mutex. */
+            #if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+            {
+                pxCurrentTCB->pxBlockedOnMutexHolder = NULL;
+            }
+            #endif
+
             #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
             {
                 /* Switch C-Runtime's TLS Block to point to the TLS
@@ -5280,22 +5675,27 @@ BaseType_t xTaskIncrementTick( void )
 
                 #if ( configGENERATE_RUN_TIME_STATS == 1 )
                 {
-                    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                        portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime[ xCoreID ] );
-                    #else
-                        ulTotalRunTime[ xCoreID ] = portGET_RUN_TIME_COUNTER_VALUE();
-                    #endif
+                    taskGET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime[ xCoreID ] );
 
                     /* Add the amount of time the task has been running to the
                      * accumulated time so far.  The time the task started running was
                      * stored in ulTaskSwitchedInTime.  Note that there is no overflow
                      * protection here so count values are only valid until the timer
-                     * overflows.  The guard against negative values is to protect
-                     * against suspect run time stat counter implementations - which
-                     * are provided by the application, not the kernel. */
+                     * overflows, unless configUSE_EXTENDED_RUN_TIME_COUNTER is 1.  The
+                     * guard against negative values is to protect against suspect run
+                     * time stat counter implementations - which are provided by the
+                     * application, not the kernel. */
                     if( ulTotalRunTime[ xCoreID ] > ulTaskSwitchedInTime[ xCoreID ] )
                     {
-                        pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTime[ xCoreID ] - ulTaskSwitchedInTime[ xCoreID ] );
+                        const configRUN_TIME_COUNTER_TYPE ulTimeSinceLastSwitchedIn = ulTotalRunTime[ xCoreID ] - ulTaskSwitchedInTime[ xCoreID ];
+
+                        pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ulTimeSinceLastSwitchedIn;
+                        ulCoreTotalRunTime[ xCoreID ] += ulTimeSinceLastSwitchedIn;
+
+                        if( taskTASK_IS_IDLE( pxCurrentTCBs[ xCoreID ] ) == pdTRUE )
+                        {
+                            ulCoreIdleRunTime[ xCoreID ] += ulTimeSinceLastSwitchedIn;
+                        }
                     }
                     else
                     {
@@ -5317,7 +5717,18 @@ BaseType_t xTaskIncrementTick( void )
                 #endif
 
                 /* Select a new task to run. */
-                taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
+                #if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+                {
+                    TCB_t * const pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+
+                    taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
+                    prvUpdateContextSwitchStats( pxPreviousTCB, pxCurrentTCBs[ xCoreID ], xCoreID );
+                }
+                #else
+                {
+                    taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
+                }
+                #endif /* configGENERATE_CONTEXT_SWITCH_STATS */
                 traceTASK_SWITCHED_IN();
 
                 /* Macro to inject port specific behaviour immediately after
@@ -5332,6 +5743,13 @@ BaseType_t xTaskIncrementTick( void )
                 }
                 #endif
 
+                /* A task that is running is not blocked on a mutex. */
+                #if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+                {
+                    pxCurrentTCBs[ xCoreID ]->pxBlockedOnMutexHolder = NULL;
+                }
+                #endif
+
                 #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
                 {
                     /* Switch C-Runtime's TLS Block to point to the TLS
@@ -6291,6 +6709,20 @@ static void prvCheckTasksWaitingTermination( void )
         }
         #endif
 
+        #if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+        {
+            pxTaskStatus->uxSwitchInCount = pxTCB->uxSwitchInCount;
+            pxTaskStatus->uxPreemptedCount = pxTCB->uxPreemptedCount;
+            pxTaskStatus->uxBlockedCount = pxTCB->uxBlockedCount;
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                pxTaskStatus->uxMigrationCount = pxTCB->uxMigrationCount;
+            }
+            #endif
+        }
+        #endif
+
         /* Obtaining the task state is a little fiddly, so is only done if the
          * value of eState passed into this function is eInvalid - otherwise the
          * state is just set to whatever is passed in. */
@@ -6601,14 +7033,116 @@ static void prvResetNextTaskUnblockTime( void )
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_RECURSIVE_MUTEXES == 1 ) ) || ( configNUMBER_OF_CORES > 1 )
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_EXTENDED_RUN_TIME_COUNTER == 1 ) )
 
-    #if ( configNUMBER_OF_CORES == 1 )
-        TaskHandle_t xTaskGetCurrentTaskHandle( void )
-        {
-            TaskHandle_t xReturn;
+    static configRUN_TIME_COUNTER_TYPE prvGetExtendedRunTimeCounterValue( void )
+    {
+        configRUN_TIME_PORT_COUNTER_TYPE xPortRunTimeCounter;
 
-            traceENTER_xTaskGetCurrentTaskHandle();
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( xPortRunTimeCounter );
+        #else
+            xPortRunTimeCounter = ( configRUN_TIME_PORT_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        /* The subtraction is performed in the width of the port's counter so
+         * the elapsed time is correct even if the counter wrapped since it was
+         * last read. */
+        ulExtendedRunTimeCounter += ( configRUN_TIME_COUNTER_TYPE ) ( ( configRUN_TIME_PORT_COUNTER_TYPE ) ( xPortRunTimeCounter - xLastPortRunTimeCounter ) );
+        xLastPortRunTimeCounter = xPortRunTimeCounter;
+
+        return ulExtendedRunTimeCounter;
+    }
+
+#endif /* #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_EXTENDED_RUN_TIME_COUNTER == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 )
+
+    static void prvUpdateContextSwitchStats( TCB_t * pxPreviousTCB,
+                                             TCB_t * pxNextTCB,
+                                             BaseType_t xCoreID )
+    {
+        if( pxPreviousTCB != pxNextTCB )
+        {
+            /* A task that is still referenced from a ready list was switched
+             * out involuntarily (or yielded).  Otherwise it blocked, suspended
+             * itself or deleted itself. */
+            if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE )
+            {
+                ( pxPreviousTCB->uxPreemptedCount )++;
+            }
+            else
+            {
+                ( pxPreviousTCB->uxBlockedCount )++;
+            }
+
+            ( pxNextTCB->uxSwitchInCount )++;
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                if( ( pxNextTCB->xLastRunCore != taskTASK_NOT_RUNNING ) && ( pxNextTCB->xLastRunCore != xCoreID ) )
+                {
+                    ( pxNextTCB->uxMigrationCount )++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxNextTCB->xLastRunCore = xCoreID;
+            }
+            #else
+            {
+                ( void ) xCoreID;
+            }
+            #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* #if ( configGENERATE_CONTEXT_SWITCH_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+
+    static BaseType_t prvTimeSliceExpired( TCB_t * pxTCB )
+    {
+        BaseType_t xReturn;
+
+        if( pxTCB->xTimeSliceTicksRemaining > ( TickType_t ) 1U )
+        {
+            pxTCB->xTimeSliceTicksRemaining--;
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            /* The task has used its whole time slice so reload the count.
+             * The count is also reloaded when the task blocks or is suspended,
+             * but not when it is switched in, so a task that is preempted (or
+             * yields) part way through its time slice completes the remainder
+             * of it when it next runs. */
+            pxTCB->xTimeSliceTicksRemaining = pxTCB->xTimeSliceTicks;
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* #if ( configUSE_PER_TASK_TIME_SLICE == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_RECURSIVE_MUTEXES == 1 ) ) || ( configNUMBER_OF_CORES > 1 )
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+        {
+            TaskHandle_t xReturn;
+
+            traceENTER_xTaskGetCurrentTaskHandle();
 
             /* A critical section is not required as this is not called from
              * an interrupt and the current TCB will always be the same for any
@@ -6704,72 +7238,313 @@ static void prvResetNextTaskUnblockTime( void )
 
 #if ( configUSE_MUTEXES == 1 )
 
-    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+    static void prvTaskInheritPriority( TCB_t * const pxTCB,
+                                        UBaseType_t uxInheritedPriority )
     {
-        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
-        BaseType_t xReturn = pdFALSE;
+        /* Adjust the mutex holder state to account for its new priority.  Only
+         * reset the event list item value if the value is not being used for
+         * anything else. */
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxInheritedPriority );
 
-        traceENTER_xTaskPriorityInherit( pxMutexHolder );
+            #if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+            {
+                prvTaskReorderEventListItem( pxTCB );
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        /* If the mutex is taken by an interrupt, the mutex holder is NULL. Priority
-         * inheritance is not applied in this scenario. */
-        if( pxMutexHolder != NULL )
+        /* If the task being modified is in the ready state it will need to be
+         * moved into a new list. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
         {
-            /* If the holder of the mutex has a priority below the priority of
-             * the task attempting to obtain the mutex then it will temporarily
-             * inherit the priority of the task attempting to obtain the mutex. */
-            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                /* It is known that the task is in its ready list so there is
+                 * no need to check again and the port level reset macro can be
+                 * called directly. */
+                portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Inherit the priority before being moved into the new list. */
+            pxTCB->uxPriority = uxInheritedPriority;
+            prvAddTaskToReadyList( pxTCB );
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* The priority of the task is raised. Yield for this task
+                 * if it is not running. */
+                if( taskTASK_IS_RUNNING( pxTCB ) != pdTRUE )
+                {
+                    prvYieldForTask( pxTCB );
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES > 1 ) */
+        }
+        else
+        {
+            /* Just inherit the priority. */
+            pxTCB->uxPriority = uxInheritedPriority;
+        }
+
+        traceTASK_PRIORITY_INHERIT( pxTCB, uxInheritedPriority );
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static void prvTaskDisinheritPriorityAfterTimeout( TCB_t * const pxTCB,
+                                                       UBaseType_t uxHighestPriorityWaitingTask )
+    {
+        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
+        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+
+        /* The task must hold at least one mutex. */
+        configASSERT( pxTCB->uxMutexesHeld );
+
+        /* Determine the priority to which the priority of the task that
+         * holds the mutex should be set.  This will be the greater of the
+         * holding task's base priority and the priority of the highest
+         * priority task that is waiting to obtain the mutex. */
+        if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+        {
+            uxPriorityToUse = uxHighestPriorityWaitingTask;
+        }
+        else
+        {
+            uxPriorityToUse = pxTCB->uxBasePriority;
+        }
+
+        /* Does the priority need to change? */
+        if( pxTCB->uxPriority != uxPriorityToUse )
+        {
+            /* Only disinherit if no other mutexes are held.  This is a
+             * simplification in the priority inheritance implementation.  If
+             * the task that holds the mutex is also holding other mutexes then
+             * the other mutexes may have caused the priority inheritance. */
+            /* NOTE: The reason is that uxPriority might also be raised by other mutex
+			 * that holding by the mutexHolder. But we don't have access to the 
+			 * other mutex, thus not sure if we need to decrease mutexHolder->uxPriority
+			 * But if mutexHolder holds only one mutex, then we definitely know its 
+			 * priority should be decreased to min(mutexHolder->basePriority, uxPriority of the highest priority task that in the mutex's receiving queue ) */
+            if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
             {
-                /* Adjust the mutex holder state to account for its new
-                 * priority.  Only reset the event list item value if the value is
-                 * not being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
+                /* If a task has timed out because it already holds the
+                 * mutex it was trying to obtain then it cannot of inherited
+                 * its own priority. */
+                configASSERT( pxTCB != pxCurrentTCB );
+
+                /* Disinherit the priority, remembering the previous
+                 * priority to facilitate determining the subject task's
+                 * state. */
+                traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+                uxPriorityUsedOnEntry = pxTCB->uxPriority;
+                pxTCB->uxPriority = uxPriorityToUse;
+
+                /* Only reset the event list item value if the value is not
+                 * being used for anything else. */
+                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
                 {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority );
-                    /* NOTE: If the event list item is already in a event list, should change its position */
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse );
+
+                    #if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+                    {
+                        prvTaskReorderEventListItem( pxTCB );
+                    }
+                    #endif
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                /* If the task being modified is in the ready state it will need
-                 * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                /* If the running task is not the task that holds the mutex
+                 * then the task that holds the mutex could be in either the
+                 * Ready, Blocked or Suspended states.  Only remove the task
+                 * from its current state list if it is in the Ready state as
+                 * the task's priority is going to change and there is one
+                 * Ready list per priority. */
+                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                 {
-                    if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
                         /* It is known that the task is in its ready list so
                          * there is no need to check again and the port level
                          * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
+                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
 
-                    /* Inherit the priority before being moved into the new list. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-                    prvAddTaskToReadyList( pxMutexHolderTCB );
+                    prvAddTaskToReadyList( pxTCB );
                     #if ( configNUMBER_OF_CORES > 1 )
                     {
-                        /* The priority of the task is raised. Yield for this task
-                         * if it is not running. */
-                        if( taskTASK_IS_RUNNING( pxMutexHolderTCB ) != pdTRUE )
+                        /* The priority of the task is dropped. Yield the core on
+                         * which the task is running. */
+                        if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
                         {
-                            prvYieldForTask( pxMutexHolderTCB );
+                            prvYieldCore( pxTCB->xTaskRunState );
                         }
                     }
                     #endif /* if ( configNUMBER_OF_CORES > 1 ) */
                 }
                 else
                 {
-                    /* Just inherit the priority. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+                    mtCOVERAGE_TEST_MARKER();
                 }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+
+    static BaseType_t prvTaskIsBlockedOnMutex( const TCB_t * const pxTCB )
+    {
+        BaseType_t xReturn = pdFALSE;
+        const List_t * pxEventList;
+
+        /* pxBlockedOnMutexHolder is set when the task is about to block on a
+         * mutex, and cleared when the task next runs.  The task is still
+         * blocked if it has not been removed from the mutex's event list, or
+         * moved from it to the pending ready list. */
+        if( pxTCB->pxBlockedOnMutexHolder != NULL )
+        {
+            pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+            if( ( pxEventList != NULL ) && ( pxEventList != &xPendingReadyList ) )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+
+    static TCB_t * prvTaskGetBlockingMutexHolder( const TCB_t * const pxTCB )
+    {
+        TCB_t * pxHolderTCB = NULL;
+
+        if( prvTaskIsBlockedOnMutex( pxTCB ) != pdFALSE )
+        {
+            /* The holder is read through the mutex rather than remembered, as
+             * the mutex may have changed hands while the task was blocked. */
+            pxHolderTCB = *( pxTCB->pxBlockedOnMutexHolder );
+
+            /* Do not follow a chain that leads back to the calling task - the
+             * tasks in it are deadlocked. */
+            if( pxHolderTCB == pxCurrentTCB )
+            {
+                pxHolderTCB = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxHolderTCB;
+    }
+
+#endif /* ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+
+    static void prvTaskReorderEventListItem( TCB_t * const pxTCB )
+    {
+        List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+        /* A task whose priority changes while it is blocked on a mutex is moved
+         * to its new place in the mutex's priority ordered list of waiting
+         * tasks, so the mutex goes to the task that now has the highest
+         * priority. */
+        if( prvTaskIsBlockedOnMutex( pxTCB ) != pdFALSE )
+        {
+            ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) )
+
+    void vTaskSetBlockingMutexHolder( TaskHandle_t * const pxMutexHolder )
+    {
+        traceENTER_vTaskSetBlockingMutexHolder( pxMutexHolder );
+
+        pxCurrentTCB->pxBlockedOnMutexHolder = pxMutexHolder;
+
+        traceRETURN_vTaskSetBlockingMutexHolder();
+    }
+
+#endif /* ( ( configUSE_MUTEXES == 1 ) && ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+    {
+        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
 
-                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+        traceENTER_xTaskPriorityInherit( pxMutexHolder );
+
+        /* If the mutex is taken by an interrupt, the mutex holder is NULL. Priority
+         * inheritance is not applied in this scenario. */
+        if( pxMutexHolder != NULL )
+        {
+            /* If the holder of the mutex has a priority below the priority of
+             * the task attempting to obtain the mutex then it will temporarily
+             * inherit the priority of the task attempting to obtain the mutex. */
+            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+            {
+                prvTaskInheritPriority( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
 
                 /* Inheritance occurred. */
                 xReturn = pdTRUE;
@@ -6798,6 +7573,30 @@ static void prvResetNextTaskUnblockTime( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+        {
+            TCB_t * pxTCB = pxMutexHolderTCB;
+            UBaseType_t uxDepth;
+
+            /* If the mutex holder is itself blocked on a mutex then raise the
+             * holder of that mutex too, and so on along the chain, so the
+             * calling task does not wait behind tasks of lower priority. */
+            for( uxDepth = ( UBaseType_t ) 1; ( pxTCB != NULL ) && ( uxDepth < ( UBaseType_t ) configMAX_PRIORITY_INHERITANCE_DEPTH ); uxDepth++ )
+            {
+                pxTCB = prvTaskGetBlockingMutexHolder( pxTCB );
+
+                if( ( pxTCB != NULL ) && ( pxTCB->uxPriority < pxCurrentTCB->uxPriority ) )
+                {
+                    prvTaskInheritPriority( pxTCB, pxCurrentTCB->uxPriority );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        #endif /* configMAX_PRIORITY_INHERITANCE_DEPTH */
+
         traceRETURN_xTaskPriorityInherit( xReturn );
 
         return xReturn;
@@ -6912,124 +7711,94 @@ static void prvResetNextTaskUnblockTime( void )
                                               UBaseType_t uxHighestPriorityWaitingTask )
     {
         TCB_t * const pxTCB = pxMutexHolder;
-        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
-        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
 
         traceENTER_vTaskPriorityDisinheritAfterTimeout( pxMutexHolder, uxHighestPriorityWaitingTask );
 
         if( pxMutexHolder != NULL )
         {
-            /* If pxMutexHolder is not NULL then the holder must hold at least
-             * one mutex. */
-            configASSERT( pxTCB->uxMutexesHeld );
+            prvTaskDisinheritPriorityAfterTimeout( pxTCB, uxHighestPriorityWaitingTask );
 
-            /* Determine the priority to which the priority of the task that
-             * holds the mutex should be set.  This will be the greater of the
-             * holding task's base priority and the priority of the highest
-             * priority task that is waiting to obtain the mutex. */
-            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+            #if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
             {
-                uxPriorityToUse = uxHighestPriorityWaitingTask;
-            }
-            else
-            {
-                uxPriorityToUse = pxTCB->uxBasePriority;
-            }
-
-            /* Does the priority need to change? */
-            if( pxTCB->uxPriority != uxPriorityToUse )
-            {
-                /* Only disinherit if no other mutexes are held.  This is a
-                 * simplification in the priority inheritance implementation.  If
-                 * the task that holds the mutex is also holding other mutexes then
-                 * the other mutexes may have caused the priority inheritance. */
-                /* NOTE: The reason is that uxPriority might also be raised by other mutex
-				 * that holding by the mutexHolder. But we don't have access to the 
-				 * other mutex, thus not sure if we need to decrease mutexHolder->uxPriority
-				 * But if mutexHolder holds only one mutex, then we definitely know its 
-				 * priority should be decreased to min(mutexHolder->basePriority, uxPriority of the highest priority task that in the mutex's receiving queue ) */
-                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
-                {
-                    /* If a task has timed out because it already holds the
-                     * mutex it was trying to obtain then it cannot of inherited
-                     * its own priority. */
-                    configASSERT( pxTCB != pxCurrentTCB );
-
-                    /* Disinherit the priority, remembering the previous
-                     * priority to facilitate determining the subject task's
-                     * state. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
-                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
-                    pxTCB->uxPriority = uxPriorityToUse;
-
-                    /* Only reset the event list item value if the value is not
-                     * being used for anything else. */
-                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
-                    {
-                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse );
-                        /* NOTE: Should also check if pxTCB is in a event list (say, waiting for another mutex). If yes, update its position in the event list */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                TCB_t * pxChainTCB = pxTCB;
+                TCB_t * pxNextTCB;
+                UBaseType_t uxDepth, uxHighestPriorityWaitingOnNext;
 
-                    /* If the running task is not the task that holds the mutex
-                     * then the task that holds the mutex could be in either the
-                     * Ready, Blocked or Suspended states.  Only remove the task
-                     * from its current state list if it is in the Ready state as
-                     * the task's priority is going to change and there is one
-                     * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                    {
-                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                        {
-                            /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
-                             * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                /* Undo the priority the timed out task passed along the chain
+                 * of blocked mutex holders, but only down as far as the highest
+                 * priority task still waiting at each step.  Mutex wait lists
+                 * are ordered by priority, so that task is at the head. */
+                for( uxDepth = ( UBaseType_t ) 1; ( pxChainTCB != NULL ) && ( uxDepth < ( UBaseType_t ) configMAX_PRIORITY_INHERITANCE_DEPTH ); uxDepth++ )
+                {
+                    pxNextTCB = prvTaskGetBlockingMutexHolder( pxChainTCB );
 
-                        prvAddTaskToReadyList( pxTCB );
-                        #if ( configNUMBER_OF_CORES > 1 )
-                        {
-                            /* The priority of the task is dropped. Yield the core on
-                             * which the task is running. */
-                            if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
-                            {
-                                prvYieldCore( pxTCB->xTaskRunState );
-                            }
-                        }
-                        #endif /* if ( configNUMBER_OF_CORES > 1 ) */
+                    if( pxNextTCB != NULL )
+                    {
+                        uxHighestPriorityWaitingOnNext = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( listLIST_ITEM_CONTAINER( &( pxChainTCB->xEventListItem ) ) ) );
+                        prvTaskDisinheritPriorityAfterTimeout( pxNextTCB, uxHighestPriorityWaitingOnNext );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+
+                    pxChainTCB = pxNextTCB;
                 }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+            }
+            #endif /* configMAX_PRIORITY_INHERITANCE_DEPTH */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskPriorityDisinheritAfterTimeout();
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_CEILING_MUTEXES == 1 )
+
+    void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+
+        traceENTER_vTaskPriorityRaiseToCeiling( uxCeilingPriority );
+
+        /* The ceiling of a mutex must be at least the priority of every task
+         * that takes it, otherwise the protocol does not bound blocking. */
+        configASSERT( pxTCB->uxBasePriority <= uxCeilingPriority );
+
+        if( pxTCB->uxPriority < uxCeilingPriority )
+        {
+            /* The calling task has just taken the mutex, so is running and in
+             * its ready list, and its event list item is not in use.  The raised
+             * priority is dropped by xTaskPriorityDisinherit() when the task
+             * gives back the last mutex it holds. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+            pxTCB->uxPriority = uxCeilingPriority;
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority );
+            prvAddTaskToReadyList( pxTCB );
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_vTaskPriorityDisinheritAfterTimeout();
+        traceRETURN_vTaskPriorityRaiseToCeiling();
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_PRIORITY_CEILING_MUTEXES */
 /*-----------------------------------------------------------*/
 
 #if ( configNUMBER_OF_CORES > 1 )
@@ -7767,6 +8536,32 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) )
+
+    BaseType_t xTaskIsRunning( TaskHandle_t xTask )
+    {
+        const TCB_t * const pxTCB = xTask;
+        BaseType_t xReturn = pdFALSE;
+
+        traceENTER_xTaskIsRunning( xTask );
+
+        if( pxTCB != NULL )
+        {
+            xReturn = taskTASK_IS_RUNNING( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskIsRunning( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_MUTEXES == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn,
@@ -7987,113 +8782,126 @@ TickType_t uxTaskResetEventItemValue( void )
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
 	/* Set notification value to a target task, if the target task is already in taskWAITING_NOTIFICATION, unblock it */
-    BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
-                                   UBaseType_t uxIndexToNotify,
-                                   uint32_t ulValue,
-                                   eNotifyAction eAction,
-                                   uint32_t * pulPreviousNotificationValue )
+    static BaseType_t prvTaskNotify( TCB_t * const pxTCB,
+                                     UBaseType_t uxIndexToNotify,
+                                     uint32_t ulValue,
+                                     eNotifyAction eAction )
     {
-        TCB_t * pxTCB;
         BaseType_t xReturn = pdPASS;
         uint8_t ucOriginalNotifyState;
 
-        traceENTER_xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue );
+        ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
-        configASSERT( xTaskToNotify );
-        pxTCB = xTaskToNotify;
+        pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
-        taskENTER_CRITICAL();
+        switch( eAction )
         {
-            if( pulPreviousNotificationValue != NULL )
-            {
-                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
-            }
-
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+            case eSetBits:
+                pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+                break;
 
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+            case eIncrement:
+                ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+                break;
 
-            switch( eAction )
-            {
-                case eSetBits:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
-                    break;
+            case eSetValueWithOverwrite:
+                pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                break;
 
-                case eIncrement:
-                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-                    break;
+            case eSetValueWithoutOverwrite:
 
-                case eSetValueWithOverwrite:
+                if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                {
                     pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    break;
+                }
+                else
+                {
+                    /* The value could not be written to the task. */
+                    xReturn = pdFAIL;
+                }
 
-                case eSetValueWithoutOverwrite:
+                break;
 
-                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
-                    {
-                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    }
-                    else
-                    {
-                        /* The value could not be written to the task. */
-                        xReturn = pdFAIL;
-                    }
+            case eNoAction:
 
-                    break;
+                /* The task is being notified without its notify value being
+                 * updated. */
+                break;
 
-                case eNoAction:
+            default:
 
-                    /* The task is being notified without its notify value being
-                     * updated. */
-                    break;
+                /* Should not get here if all enums are handled.
+                 * Artificially force an assert by testing a value the
+                 * compiler can't assume is const. */
+                configASSERT( xTickCount == ( TickType_t ) 0 );
 
-                default:
+                break;
+        }
 
-                    /* Should not get here if all enums are handled.
-                     * Artificially force an assert by testing a value the
-                     * compiler can't assume is const. */
-                    configASSERT( xTickCount == ( TickType_t ) 0 );
+        traceTASK_NOTIFY( uxIndexToNotify );
 
-                    break;
-            }
+        /* If the task is in the blocked state specifically to wait for a
+         * notification then unblock it now. */
+        if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+        {
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxTCB );
 
-            traceTASK_NOTIFY( uxIndexToNotify );
+            /* The task should not have been on an event list. */
+            configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            #if ( configUSE_TICKLESS_IDLE != 0 )
             {
-                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                prvAddTaskToReadyList( pxTCB );
+                /* If a task is blocked waiting for a notification then
+                 * xNextTaskUnblockTime might be set to the blocked task's time
+                 * out time.  If the task is unblocked for a reason other than
+                 * a timeout xNextTaskUnblockTime is normally left unchanged,
+                 * because it will automatically get reset to a new value when
+                 * the tick count equals xNextTaskUnblockTime.  However if
+                 * tickless idling is used it might be more important to enter
+                 * sleep mode at the earliest possible time - so reset
+                 * xNextTaskUnblockTime here to ensure it is updated at the
+                 * earliest possible time. */
+                prvResetNextTaskUnblockTime();
+            }
+            #endif
 
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+            /* Check if the notified task has a priority above the currently
+             * executing task. */
+            taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                #if ( configUSE_TICKLESS_IDLE != 0 )
-                {
-                    /* If a task is blocked waiting for a notification then
-                     * xNextTaskUnblockTime might be set to the blocked task's time
-                     * out time.  If the task is unblocked for a reason other than
-                     * a timeout xNextTaskUnblockTime is normally left unchanged,
-                     * because it will automatically get reset to a new value when
-                     * the tick count equals xNextTaskUnblockTime.  However if
-                     * tickless idling is used it might be more important to enter
-                     * sleep mode at the earliest possible time - so reset
-                     * xNextTaskUnblockTime here to ensure it is updated at the
-                     * earliest possible time. */
-                    prvResetNextTaskUnblockTime();
-                }
-                #endif
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-                /* Check if the notified task has a priority above the currently
-                 * executing task. */
-                taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
-            }
-            else
+    BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
+                                   UBaseType_t uxIndexToNotify,
+                                   uint32_t ulValue,
+                                   eNotifyAction eAction,
+                                   uint32_t * pulPreviousNotificationValue )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue );
+
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( xTaskToNotify );
+        pxTCB = xTaskToNotify;
+
+        taskENTER_CRITICAL();
+        {
+            if( pulPreviousNotificationValue != NULL )
             {
-                mtCOVERAGE_TEST_MARKER();
+                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
             }
+
+            xReturn = prvTaskNotify( pxTCB, uxIndexToNotify, ulValue, eAction );
         }
         taskEXIT_CRITICAL();
 
@@ -8320,177 +9128,647 @@ TickType_t uxTaskResetEventItemValue( void )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        pxTCB = xTaskToNotify;
+        pxTCB = xTaskToNotify;
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+            /* 'Giving' is equivalent to incrementing a count in a counting
+             * semaphore. */
+            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+
+            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
+
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            {
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+
+                    #if ( configUSE_TICKLESS_IDLE != 0 )
+                    {
+                        /* If a task is blocked waiting for a notification then
+                         * xNextTaskUnblockTime might be set to the blocked task's time
+                         * out time.  If the task is unblocked for a reason other than
+                         * a timeout xNextTaskUnblockTime is normally left unchanged,
+                         * because it will automatically get reset to a new value when
+                         * the tick count equals xNextTaskUnblockTime.  However if
+                         * tickless idling is used it might be more important to enter
+                         * sleep mode at the earliest possible time - so reset
+                         * xNextTaskUnblockTime here to ensure it is updated at the
+                         * earliest possible time. */
+                        prvResetNextTaskUnblockTime();
+                    }
+                    #endif
+                }
+                else
+                {
+                    /* The delayed and ready lists cannot be accessed, so hold
+                     * this task pending until the scheduler is resumed. */
+                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
+
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter in an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPendings[ 0 ] = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+                {
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        prvYieldForTask( pxTCB );
+
+                        if( xYieldPendings[ portGET_CORE_ID() ] == pdTRUE )
+                        {
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                        }
+                    }
+                    #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+                }
+                #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_vTaskGenericNotifyGiveFromISR();
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
+                                             UBaseType_t uxIndexToClear )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskGenericNotifyStateClear( xTask, uxIndexToClear );
+
+        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
+            {
+                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xTaskGenericNotifyStateClear( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
+                                            UBaseType_t uxIndexToClear,
+                                            uint32_t ulBitsToClear )
+    {
+        TCB_t * pxTCB;
+        uint32_t ulReturn;
+
+        traceENTER_ulTaskGenericNotifyValueClear( xTask, uxIndexToClear, ulBitsToClear );
+
+        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            /* Return the notification as it was before the bits were cleared,
+             * then clear the bit mask. */
+            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_ulTaskGenericNotifyValueClear( ulReturn );
+
+        return ulReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+
+    static void prvInitialiseNotifyGroup( NotifyGroup_t * pxNotifyGroup,
+                                          UBaseType_t uxIndexToNotify,
+                                          UBaseType_t uxMaxMembers,
+                                          TCB_t ** ppxMembers )
+    {
+        pxNotifyGroup->uxIndexToNotify = uxIndexToNotify;
+        pxNotifyGroup->uxMaxMembers = uxMaxMembers;
+        pxNotifyGroup->uxMemberCount = ( UBaseType_t ) 0U;
+        pxNotifyGroup->ppxMembers = ppxMembers;
+
+        vTaskSuspendAll();
+        {
+            pxNotifyGroup->pxNextGroup = pxNotifyGroups;
+            pxNotifyGroups = pxNotifyGroup;
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSortNotifyGroup( NotifyGroup_t * pxNotifyGroup )
+    {
+        UBaseType_t uxMember, uxPosition;
+        TCB_t * pxTCB;
+
+        /* An insertion sort, so the usual case of a group whose members have
+         * not changed priority since it was last notified takes a single pass.
+         * Members of equal priority keep their order. */
+        for( uxMember = ( UBaseType_t ) 1U; uxMember < pxNotifyGroup->uxMemberCount; uxMember++ )
+        {
+            pxTCB = pxNotifyGroup->ppxMembers[ uxMember ];
+
+            for( uxPosition = uxMember; uxPosition > ( UBaseType_t ) 0U; uxPosition-- )
+            {
+                if( pxNotifyGroup->ppxMembers[ uxPosition - 1U ]->uxPriority >= pxTCB->uxPriority )
+                {
+                    break;
+                }
+                else
+                {
+                    pxNotifyGroup->ppxMembers[ uxPosition ] = pxNotifyGroup->ppxMembers[ uxPosition - 1U ];
+                }
+            }
+
+            pxNotifyGroup->ppxMembers[ uxPosition ] = pxTCB;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvFindNotifyGroupMember( const NotifyGroup_t * pxNotifyGroup,
+                                                const TCB_t * pxTCB,
+                                                UBaseType_t * puxMember )
+    {
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxMember;
+
+        for( uxMember = ( UBaseType_t ) 0U; uxMember < pxNotifyGroup->uxMemberCount; uxMember++ )
+        {
+            if( pxNotifyGroup->ppxMembers[ uxMember ] == pxTCB )
+            {
+                *puxMember = uxMember;
+                xReturn = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvRemoveNotifyGroupMember( NotifyGroup_t * pxNotifyGroup,
+                                                  TCB_t * pxTCB )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxMember;
+
+        xReturn = prvFindNotifyGroupMember( pxNotifyGroup, pxTCB, &uxMember );
+
+        if( xReturn != pdFALSE )
+        {
+            /* Close the gap, keeping the remaining members in order. */
+            for( ; uxMember < ( pxNotifyGroup->uxMemberCount - 1U ); uxMember++ )
+            {
+                pxNotifyGroup->ppxMembers[ uxMember ] = pxNotifyGroup->ppxMembers[ uxMember + 1U ];
+            }
+
+            pxNotifyGroup->uxMemberCount--;
+            pxTCB->uxNotifyGroupCount--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFY_GROUPS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    TaskNotifyGroupHandle_t xTaskNotifyGroupCreate( UBaseType_t uxIndexToNotify,
+                                                    UBaseType_t uxMaxMembers )
+    {
+        NotifyGroup_t * pxNotifyGroup = NULL;
+
+        traceENTER_xTaskNotifyGroupCreate( uxIndexToNotify, uxMaxMembers );
+
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( uxMaxMembers > ( UBaseType_t ) 0U );
+
+        /* Check for multiplication and addition overflow before allocating the
+         * group and its array of members in one block. */
+        if( ( uxMaxMembers > ( UBaseType_t ) 0U ) &&
+            ( ( SIZE_MAX / sizeof( TCB_t * ) ) >= uxMaxMembers ) &&
+            ( ( SIZE_MAX - sizeof( NotifyGroup_t ) ) >= ( ( size_t ) uxMaxMembers * sizeof( TCB_t * ) ) ) )
+        {
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxNotifyGroup = pvPortMalloc( sizeof( NotifyGroup_t ) + ( ( size_t ) uxMaxMembers * sizeof( TCB_t * ) ) );
+
+            if( pxNotifyGroup != NULL )
+            {
+                /* The array of members follows the group structure, which holds
+                 * a pointer so the array is suitably aligned. */
+                prvInitialiseNotifyGroup( pxNotifyGroup, uxIndexToNotify, uxMaxMembers, ( TCB_t ** ) &( pxNotifyGroup[ 1 ] ) );
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    pxNotifyGroup->ucStaticallyAllocated = pdFALSE;
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskNotifyGroupCreate( pxNotifyGroup );
+
+        return pxNotifyGroup;
+    }
+
+#endif /* ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    TaskNotifyGroupHandle_t xTaskNotifyGroupCreateStatic( UBaseType_t uxIndexToNotify,
+                                                          UBaseType_t uxMaxMembers,
+                                                          TaskHandle_t * pxMemberBuffer,
+                                                          StaticTaskNotifyGroup_t * pxNotifyGroupBuffer )
+    {
+        NotifyGroup_t * pxNotifyGroup = NULL;
+
+        traceENTER_xTaskNotifyGroupCreateStatic( uxIndexToNotify, uxMaxMembers, pxMemberBuffer, pxNotifyGroupBuffer );
+
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( uxMaxMembers > ( UBaseType_t ) 0U );
+        configASSERT( pxMemberBuffer );
+        configASSERT( pxNotifyGroupBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticTaskNotifyGroup_t equals the size of the
+             * real task notification group structure. */
+            volatile size_t xSize = sizeof( StaticTaskNotifyGroup_t );
+            configASSERT( xSize == sizeof( NotifyGroup_t ) );
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( ( uxMaxMembers > ( UBaseType_t ) 0U ) && ( pxMemberBuffer != NULL ) && ( pxNotifyGroupBuffer != NULL ) )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxNotifyGroup = ( NotifyGroup_t * ) pxNotifyGroupBuffer;
+
+            prvInitialiseNotifyGroup( pxNotifyGroup, uxIndexToNotify, uxMaxMembers, pxMemberBuffer );
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                pxNotifyGroup->ucStaticallyAllocated = pdTRUE;
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskNotifyGroupCreateStatic( pxNotifyGroup );
+
+        return pxNotifyGroup;
+    }
+
+#endif /* ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFY_GROUPS == 1 )
+
+    void vTaskNotifyGroupDelete( TaskNotifyGroupHandle_t xNotifyGroup )
+    {
+        NotifyGroup_t * pxNotifyGroup = xNotifyGroup;
+        NotifyGroup_t ** ppxLink;
+        UBaseType_t uxMember;
+
+        traceENTER_vTaskNotifyGroupDelete( xNotifyGroup );
+
+        configASSERT( pxNotifyGroup );
+
+        /* The members are no longer members of the group. */
+        vTaskSuspendAll();
+        {
+            for( uxMember = ( UBaseType_t ) 0U; uxMember < pxNotifyGroup->uxMemberCount; uxMember++ )
+            {
+                pxNotifyGroup->ppxMembers[ uxMember ]->uxNotifyGroupCount--;
+            }
+
+            for( ppxLink = &pxNotifyGroups; *ppxLink != pxNotifyGroup; ppxLink = &( ( *ppxLink )->pxNextGroup ) )
+            {
+                /* A group that has not been created cannot be deleted. */
+                configASSERT( *ppxLink != NULL );
+            }
+
+            *ppxLink = pxNotifyGroup->pxNextGroup;
+        }
+        ( void ) xTaskResumeAll();
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        {
+            /* The group can only have been allocated dynamically - free it
+             * again. */
+            vPortFree( pxNotifyGroup );
+        }
+        #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The group could have been allocated statically or dynamically, so
+             * check before attempting to free the memory. */
+            if( pxNotifyGroup->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                vPortFree( pxNotifyGroup );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+        {
+            ( void ) pxNotifyGroup;
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+        traceRETURN_vTaskNotifyGroupDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskNotifyGroupAddMember( TaskNotifyGroupHandle_t xNotifyGroup,
+                                          TaskHandle_t xTask )
+    {
+        NotifyGroup_t * pxNotifyGroup = xNotifyGroup;
+        TCB_t * pxTCB;
+        UBaseType_t uxMember;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskNotifyGroupAddMember( xNotifyGroup, xTask );
+
+        configASSERT( pxNotifyGroup );
+
+        /* If null is passed in here then the calling task is being added. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        /* Like an event group, the group is only accessed with the scheduler
+         * suspended, never from a critical section or an interrupt. */
+        vTaskSuspendAll();
+        {
+            if( prvFindNotifyGroupMember( pxNotifyGroup, pxTCB, &uxMember ) != pdFALSE )
+            {
+                /* Already a member. */
+                xReturn = pdPASS;
+            }
+            else if( pxNotifyGroup->uxMemberCount < pxNotifyGroup->uxMaxMembers )
+            {
+                /* The members are put in priority order when the group is
+                 * next notified. */
+                pxNotifyGroup->ppxMembers[ pxNotifyGroup->uxMemberCount ] = pxTCB;
+                pxNotifyGroup->uxMemberCount++;
+                pxTCB->uxNotifyGroupCount++;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_xTaskNotifyGroupAddMember( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskNotifyGroupRemoveMember( TaskNotifyGroupHandle_t xNotifyGroup,
+                                             TaskHandle_t xTask )
+    {
+        NotifyGroup_t * pxNotifyGroup = xNotifyGroup;
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskNotifyGroupRemoveMember( xNotifyGroup, xTask );
 
-        /* MISRA Ref 4.7.1 [Return value shall be checked] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
-        /* coverity[misra_c_2012_directive_4_7_violation] */
-        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        configASSERT( pxNotifyGroup );
+
+        /* If null is passed in here then the calling task is being removed. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        vTaskSuspendAll();
         {
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+            xReturn = ( prvRemoveNotifyGroupMember( pxNotifyGroup, pxTCB ) != pdFALSE ) ? pdPASS : pdFAIL;
+        }
+        ( void ) xTaskResumeAll();
 
-            /* 'Giving' is equivalent to incrementing a count in a counting
-             * semaphore. */
-            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+        traceRETURN_xTaskNotifyGroupRemoveMember( xReturn );
 
-            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+    BaseType_t xTaskNotifyGroupNotify( TaskNotifyGroupHandle_t xNotifyGroup,
+                                       uint32_t ulValue,
+                                       eNotifyAction eAction )
+    {
+        NotifyGroup_t * pxNotifyGroup = xNotifyGroup;
+        UBaseType_t uxMember = ( UBaseType_t ) 0U;
+        UBaseType_t uxBatchEnd;
+        BaseType_t xReturn = pdPASS;
+
+        traceENTER_xTaskNotifyGroupNotify( xNotifyGroup, ulValue, eAction );
+
+        configASSERT( pxNotifyGroup );
+
+        /* With the scheduler suspended no member can run, change priority or
+         * leave the group before every member has been notified.  The members
+         * are notified highest priority first, a batch at a time, so the time
+         * spent in any one critical section does not grow with the size of the
+         * group.  A context switch a notified member needs is held pending
+         * until the scheduler is resumed. */
+        vTaskSuspendAll();
+        {
+            prvSortNotifyGroup( pxNotifyGroup );
+
+            while( uxMember < pxNotifyGroup->uxMemberCount )
             {
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                uxBatchEnd = pxNotifyGroup->uxMemberCount;
 
-                if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+                if( ( uxBatchEnd - uxMember ) > ( UBaseType_t ) configTASK_NOTIFY_GROUP_BATCH_SIZE )
                 {
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-
-                    #if ( configUSE_TICKLESS_IDLE != 0 )
-                    {
-                        /* If a task is blocked waiting for a notification then
-                         * xNextTaskUnblockTime might be set to the blocked task's time
-                         * out time.  If the task is unblocked for a reason other than
-                         * a timeout xNextTaskUnblockTime is normally left unchanged,
-                         * because it will automatically get reset to a new value when
-                         * the tick count equals xNextTaskUnblockTime.  However if
-                         * tickless idling is used it might be more important to enter
-                         * sleep mode at the earliest possible time - so reset
-                         * xNextTaskUnblockTime here to ensure it is updated at the
-                         * earliest possible time. */
-                        prvResetNextTaskUnblockTime();
-                    }
-                    #endif
+                    uxBatchEnd = uxMember + ( UBaseType_t ) configTASK_NOTIFY_GROUP_BATCH_SIZE;
                 }
                 else
                 {
-                    /* The delayed and ready lists cannot be accessed, so hold
-                     * this task pending until the scheduler is resumed. */
-                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    mtCOVERAGE_TEST_MARKER();
                 }
 
-                #if ( configNUMBER_OF_CORES == 1 )
+                taskENTER_CRITICAL();
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    for( ; uxMember < uxBatchEnd; uxMember++ )
                     {
-                        /* The notified task has a priority above the currently
-                         * executing task so a yield is required. */
-                        if( pxHigherPriorityTaskWoken != NULL )
+                        if( prvTaskNotify( pxNotifyGroup->ppxMembers[ uxMember ], pxNotifyGroup->uxIndexToNotify, ulValue, eAction ) == pdFAIL )
                         {
-                            *pxHigherPriorityTaskWoken = pdTRUE;
+                            /* eSetValueWithoutOverwrite found a notification
+                             * pending for this member. */
+                            xReturn = pdFAIL;
                         }
-
-                        /* Mark that a yield is pending in case the user is not
-                         * using the "xHigherPriorityTaskWoken" parameter in an ISR
-                         * safe FreeRTOS function. */
-                        xYieldPendings[ 0 ] = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                #else /* #if ( configNUMBER_OF_CORES == 1 ) */
-                {
-                    #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        prvYieldForTask( pxTCB );
-
-                        if( xYieldPendings[ portGET_CORE_ID() ] == pdTRUE )
+                        else
                         {
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
+                            mtCOVERAGE_TEST_MARKER();
                         }
                     }
-                    #endif /* #if ( configUSE_PREEMPTION == 1 ) */
                 }
-                #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+                taskEXIT_CRITICAL();
             }
         }
-        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        ( void ) xTaskResumeAll();
 
-        traceRETURN_vTaskGenericNotifyGiveFromISR();
+        traceRETURN_xTaskNotifyGroupNotify( xReturn );
+
+        return xReturn;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_TASK_NOTIFY_GROUPS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
-    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
-                                             UBaseType_t uxIndexToClear )
+    static void prvNotifyGroupSetBitsCallback( void * pvNotifyGroup,
+                                               uint32_t ulBitsToSet )
     {
-        TCB_t * pxTCB;
-        BaseType_t xReturn;
+        /* MISRA Ref 11.5.4 [Callback function parameter] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        ( void ) xTaskNotifyGroupNotify( pvNotifyGroup, ulBitsToSet, eSetBits );
+    }
+/*-----------------------------------------------------------*/
 
-        traceENTER_xTaskGenericNotifyStateClear( xTask, uxIndexToClear );
+    static void prvNotifyGroupGiveCallback( void * pvNotifyGroup,
+                                            uint32_t ulUnused )
+    {
+        ( void ) ulUnused;
 
-        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        /* MISRA Ref 11.5.4 [Callback function parameter] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        ( void ) xTaskNotifyGroupNotify( pvNotifyGroup, 0U, eIncrement );
+    }
+/*-----------------------------------------------------------*/
 
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
-        configASSERT( pxTCB != NULL );
+    BaseType_t xTaskNotifyGroupSetBitsFromISR( TaskNotifyGroupHandle_t xNotifyGroup,
+                                               uint32_t ulBitsToSet,
+                                               BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
 
-        taskENTER_CRITICAL();
-        {
-            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
-            {
-                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
-                xReturn = pdPASS;
-            }
-            else
-            {
-                xReturn = pdFAIL;
-            }
-        }
-        taskEXIT_CRITICAL();
+        traceENTER_xTaskNotifyGroupSetBitsFromISR( xNotifyGroup, ulBitsToSet, pxHigherPriorityTaskWoken );
 
-        traceRETURN_xTaskGenericNotifyStateClear( xReturn );
+        /* As with xEventGroupSetBitsFromISR(), the members are notified by the
+         * RTOS daemon task, so the interrupt does not spend time proportional
+         * to the size of the group. */
+        xReturn = xTimerPendFunctionCallFromISR( prvNotifyGroupSetBitsCallback, ( void * ) xNotifyGroup, ulBitsToSet, pxHigherPriorityTaskWoken );
+
+        traceRETURN_xTaskNotifyGroupSetBitsFromISR( xReturn );
 
         return xReturn;
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-
-    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
-                                            UBaseType_t uxIndexToClear,
-                                            uint32_t ulBitsToClear )
+    BaseType_t xTaskNotifyGroupGiveFromISR( TaskNotifyGroupHandle_t xNotifyGroup,
+                                            BaseType_t * pxHigherPriorityTaskWoken )
     {
-        TCB_t * pxTCB;
-        uint32_t ulReturn;
-
-        traceENTER_ulTaskGenericNotifyValueClear( xTask, uxIndexToClear, ulBitsToClear );
-
-        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        BaseType_t xReturn;
 
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
-        configASSERT( pxTCB != NULL );
+        traceENTER_xTaskNotifyGroupGiveFromISR( xNotifyGroup, pxHigherPriorityTaskWoken );
 
-        taskENTER_CRITICAL();
-        {
-            /* Return the notification as it was before the bits were cleared,
-             * then clear the bit mask. */
-            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
-            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
-        }
-        taskEXIT_CRITICAL();
+        xReturn = xTimerPendFunctionCallFromISR( prvNotifyGroupGiveCallback, ( void * ) xNotifyGroup, 0U, pxHigherPriorityTaskWoken );
 
-        traceRETURN_ulTaskGenericNotifyValueClear( ulReturn );
+        traceRETURN_xTaskNotifyGroupGiveFromISR( xReturn );
 
-        return ulReturn;
+        return xReturn;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* ( ( configUSE_TASK_NOTIFY_GROUPS == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
@@ -8509,11 +9787,7 @@ TickType_t uxTaskResetEventItemValue( void )
         {
             if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
             {
-                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
-                #else
-                    ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
-                #endif
+                taskGET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
 
                 #if ( configNUMBER_OF_CORES == 1 )
                     ulTimeSinceLastSwitchedIn = ulTotalTime - ulTaskSwitchedInTime[ 0 ];
@@ -8545,11 +9819,11 @@ TickType_t uxTaskResetEventItemValue( void )
 
         ulTaskRunTime = ulTaskGetRunTimeCounter( xTask );
 
-        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-            portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
-        #else
-            ulTotalTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
-        #endif
+        taskENTER_CRITICAL();
+        {
+            taskGET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
+        }
+        taskEXIT_CRITICAL();
 
         /* For percentage calculations. */
         ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
@@ -8586,11 +9860,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
         taskENTER_CRITICAL();
         {
-            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
-            #else
-                ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
-            #endif
+            taskGET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
 
             for( i = 0; i < ( BaseType_t ) configNUMBER_OF_CORES; i++ )
             {
@@ -8620,6 +9890,94 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetCoreRunTimeCounter( BaseType_t xCoreID )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTotalTime = 0, ulCoreRunTime = 0;
+
+        traceENTER_ulTaskGetCoreRunTimeCounter( xCoreID );
+
+        configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
+
+        taskENTER_CRITICAL();
+        {
+            ulCoreRunTime = ulCoreTotalRunTime[ xCoreID ];
+
+            /* Include the time the task that is currently running on the
+             * core has been running for. */
+            if( xSchedulerRunning != pdFALSE )
+            {
+                taskGET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
+
+                if( ulTotalTime > ulTaskSwitchedInTime[ xCoreID ] )
+                {
+                    ulCoreRunTime += ( ulTotalTime - ulTaskSwitchedInTime[ xCoreID ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_ulTaskGetCoreRunTimeCounter( ulCoreRunTime );
+
+        return ulCoreRunTime;
+    }
+
+#endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetCoreIdleRunTimeCounter( BaseType_t xCoreID )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTotalTime = 0, ulCoreIdleTime = 0;
+
+        traceENTER_ulTaskGetCoreIdleRunTimeCounter( xCoreID );
+
+        configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
+
+        taskENTER_CRITICAL();
+        {
+            ulCoreIdleTime = ulCoreIdleRunTime[ xCoreID ];
+
+            /* Include the time the core has been running an Idle task for if
+             * an Idle task is running on it now. */
+            #if ( configNUMBER_OF_CORES == 1 )
+                if( ( xSchedulerRunning != pdFALSE ) && ( taskTASK_IS_IDLE( pxCurrentTCB ) == pdTRUE ) )
+            #else
+                if( ( xSchedulerRunning != pdFALSE ) && ( taskTASK_IS_IDLE( pxCurrentTCBs[ xCoreID ] ) == pdTRUE ) )
+            #endif
+            {
+                taskGET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
+
+                if( ulTotalTime > ulTaskSwitchedInTime[ xCoreID ] )
+                {
+                    ulCoreIdleTime += ( ulTotalTime - ulTaskSwitchedInTime[ xCoreID ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_ulTaskGetCoreIdleRunTimeCounter( ulCoreIdleTime );
+
+        return ulCoreIdleTime;
+    }
+
+#endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
@@ -8629,11 +9987,11 @@ TickType_t uxTaskResetEventItemValue( void )
 
         traceENTER_ulTaskGetIdleRunTimePercent();
 
-        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-            portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
-        #else
-            ulTotalTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
-        #endif
+        taskENTER_CRITICAL();
+        {
+            taskGET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
+        }
+        taskEXIT_CRITICAL();
 
         ulTotalTime *= configNUMBER_OF_CORES;
 
@@ -8676,6 +10034,14 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     }
     #endif
 
+    #if ( configUSE_PER_TASK_TIME_SLICE == 1 )
+    {
+        /* The task is giving up the processor, so it starts a whole time slice
+         * when it next runs. */
+        pxCurrentTCB->xTimeSliceTicksRemaining = pxCurrentTCB->xTimeSliceTicks;
+    }
+    #endif
+
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -8937,7 +10303,16 @@ void vTaskResetState( void )
         {
             ulTaskSwitchedInTime[ xCoreID ] = 0U;
             ulTotalRunTime[ xCoreID ] = 0U;
+            ulCoreTotalRunTime[ xCoreID ] = 0U;
+            ulCoreIdleRunTime[ xCoreID ] = 0U;
         }
+
+        #if ( configUSE_EXTENDED_RUN_TIME_COUNTER == 1 )
+        {
+            xLastPortRunTimeCounter = 0U;
+            ulExtendedRunTimeCounter = 0U;
+        }
+        #endif
     }
     #endif /* #if ( configGENERATE_RUN_TIME_STATS == 1 ) */
 }
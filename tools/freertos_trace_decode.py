@@ -0,0 +1,265 @@
+#!/usr/bin/env python3
+"""
+Decodes a dump of the FreeRTOS binary trace recorder (freertos_trace.c) into a
+timeline.
+
+The dump is the raw contents of xTraceRecorder, either written out with
+vTraceRecorderDump() or saved with a debugger, for example in GDB:
+
+    dump binary memory trace.bin &xTraceRecorder (char *)&xTraceRecorder + sizeof(xTraceRecorder)
+
+Usage:
+
+    freertos_trace_decode.py trace.bin             # timeline of every event
+    freertos_trace_decode.py --summary trace.bin   # per task scheduling summary
+    freertos_trace_decode.py --heap-trace trace.bin  # allocations, for examples/benchmark/heap_benchmark
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x52545246
+HEADER_FORMAT = 'IHHIIIII'
+NAME_LENGTH = 16
+EVENT_FORMAT = 'IHBBII'
+API_RETURN_FLAG = 0x80
+
+# Keep in sync with the traceRECORDER_EVENT_ definitions in include/freertos_trace.h.
+EVENT_NAMES = {
+    0x01: 'TASK_SWITCHED_IN',
+    0x02: 'TASK_SWITCHED_OUT',
+    0x03: 'TASK_READY',
+    0x04: 'TASK_CREATE',
+    0x05: 'TASK_DELETE',
+    0x06: 'TASK_SUSPEND',
+    0x07: 'TASK_RESUME',
+    0x08: 'TASK_RESUME_FROM_ISR',
+    0x09: 'TASK_PRIORITY_SET',
+    0x0A: 'TASK_PRIORITY_INHERIT',
+    0x0B: 'TASK_PRIORITY_DISINHERIT',
+    0x0C: 'TASK_DELAY_UNTIL',
+    0x10: 'QUEUE_CREATE',
+    0x11: 'QUEUE_DELETE',
+    0x12: 'QUEUE_SEND',
+    0x13: 'QUEUE_SEND_FAILED',
+    0x14: 'QUEUE_SEND_FROM_ISR',
+    0x15: 'QUEUE_RECEIVE',
+    0x16: 'QUEUE_RECEIVE_FAILED',
+    0x17: 'QUEUE_RECEIVE_FROM_ISR',
+    0x18: 'QUEUE_PEEK',
+    0x19: 'BLOCKING_ON_QUEUE_SEND',
+    0x1A: 'BLOCKING_ON_QUEUE_RECEIVE',
+    0x1B: 'BLOCKING_ON_QUEUE_PEEK',
+    0x20: 'TASK_NOTIFY_TAKE_BLOCK',
+    0x21: 'TASK_NOTIFY_WAIT_BLOCK',
+    0x28: 'EVENT_GROUP_SET_BITS',
+    0x29: 'EVENT_GROUP_WAIT_BLOCK',
+    0x2C: 'BLOCKING_ON_STREAM_SEND',
+    0x2D: 'BLOCKING_ON_STREAM_RECEIVE',
+    0x30: 'TIMER_EXPIRED',
+    0x34: 'MALLOC',
+    0x35: 'FREE',
+    0x38: 'ISR_ENTER',
+    0x39: 'ISR_EXIT',
+    0x3A: 'ISR_EXIT_TO_SCHEDULER',
+    0x40: 'vTaskDelay',
+    0x41: 'xTaskDelayUntil',
+    0x42: 'xQueueGenericSend',
+    0x43: 'xQueueReceive',
+    0x44: 'xQueueSemaphoreTake',
+    0x45: 'xQueuePeek',
+    0x46: 'xQueueGenericSendFromISR',
+    0x47: 'xQueueGiveFromISR',
+    0x48: 'xQueueReceiveFromISR',
+    0x49: 'xTaskGenericNotify',
+    0x4A: 'xTaskGenericNotifyFromISR',
+    0x4B: 'vTaskGenericNotifyGiveFromISR',
+    0x4C: 'xTaskGenericNotifyWait',
+    0x4D: 'ulTaskGenericNotifyTake',
+    0x4E: 'xEventGroupWaitBits',
+    0x4F: 'xStreamBufferSend',
+    0x50: 'xStreamBufferReceive',
+}
+
+EVENT_TASK_SWITCHED_IN = 0x01
+EVENT_TASK_SWITCHED_OUT = 0x02
+EVENT_TASK_READY = 0x03
+EVENT_MALLOC = 0x34
+EVENT_FREE = 0x35
+FIRST_API_EVENT = 0x40
+
+
+def event_name(event_id):
+    if (event_id >= FIRST_API_EVENT) and (event_id & API_RETURN_FLAG):
+        api = EVENT_NAMES.get(event_id & ~API_RETURN_FLAG)
+        if api is not None:
+            return api + ' returned'
+    elif event_id >= FIRST_API_EVENT:
+        api = EVENT_NAMES.get(event_id)
+        if api is not None:
+            return api + ' called'
+    return EVENT_NAMES.get(event_id, 'EVENT_0x%02X' % event_id)
+
+
+class Trace:
+    def __init__(self, data):
+        self.endian = '<'
+        if struct.unpack_from('<I', data)[0] != MAGIC:
+            self.endian = '>'
+            if struct.unpack_from('>I', data)[0] != MAGIC:
+                raise ValueError('not a trace recorder dump (bad magic)')
+
+        offset = 0
+        (_, self.version, event_size, self.events_per_core, self.num_cores,
+         self.timestamp_hz, max_names, _) = struct.unpack_from(self.endian + HEADER_FORMAT, data, offset)
+        offset += struct.calcsize(HEADER_FORMAT)
+
+        if event_size != struct.calcsize(EVENT_FORMAT):
+            raise ValueError('unsupported event size %d' % event_size)
+
+        self.names = {}
+        for _ in range(max_names):
+            handle, = struct.unpack_from(self.endian + 'I', data, offset)
+            name = data[offset + 4:offset + 4 + NAME_LENGTH].split(b'\0', 1)[0]
+            offset += 4 + NAME_LENGTH
+            if handle != 0:
+                self.names[handle] = name.decode('ascii', 'replace')
+
+        # Events of each core in recording order, with the 32-bit timestamps
+        # unwrapped into a monotonically increasing count.
+        self.events = []
+        self.dropped = []
+        for core in range(self.num_cores):
+            head, = struct.unpack_from(self.endian + 'I', data, offset)
+            offset += 4
+            ring = [struct.unpack_from(self.endian + EVENT_FORMAT, data, offset + i * event_size)
+                    for i in range(self.events_per_core)]
+            offset += self.events_per_core * event_size
+
+            count = min(head, self.events_per_core)
+            self.dropped.append(head - count)
+            first = (head - count) % self.events_per_core
+            epoch = 0
+            previous = None
+            for i in range(count):
+                timestamp, event_id, core_id, _, handle, argument = ring[(first + i) % self.events_per_core]
+                if (previous is not None) and (timestamp < previous):
+                    epoch += 1 << 32
+                previous = timestamp
+                self.events.append((epoch + timestamp, core, i, event_id, handle, argument))
+
+        self.events.sort()
+
+    def object_name(self, handle):
+        if handle == 0:
+            return '-'
+        return self.names.get(handle, '0x%08X' % handle)
+
+    def format_time(self, timestamp):
+        if self.timestamp_hz:
+            return '%.3f us' % (timestamp * 1e6 / self.timestamp_hz)
+        return '%d' % timestamp
+
+
+def print_timeline(trace):
+    if not trace.events:
+        return
+    start = trace.events[0][0]
+    print('%14s  %4s  %-34s %-18s %s' % ('Time', 'Core', 'Event', 'Object', 'Argument'))
+    for timestamp, core, _, event_id, handle, argument in trace.events:
+        print('%14s  %4d  %-34s %-18s %d' % (trace.format_time(timestamp - start), core,
+                                             event_name(event_id), trace.object_name(handle), argument))
+
+
+def print_summary(trace):
+    running = {}          # core -> (task handle, switched in time)
+    ready_since = {}      # task handle -> time it became ready
+    open_calls = {}       # (task handle, api) -> enter time
+    tasks = {}            # task handle -> [switch ins, run time, latency sum, latency count, latency max]
+    apis = {}             # api -> [calls, duration sum, duration max]
+
+    for timestamp, core, _, event_id, handle, argument in trace.events:
+        if event_id == EVENT_TASK_READY:
+            ready_since.setdefault(handle, timestamp)
+        elif event_id == EVENT_TASK_SWITCHED_IN:
+            stats = tasks.setdefault(handle, [0, 0, 0, 0, 0])
+            stats[0] += 1
+            running[core] = (handle, timestamp)
+            became_ready = ready_since.pop(handle, None)
+            if became_ready is not None:
+                latency = timestamp - became_ready
+                stats[2] += latency
+                stats[3] += 1
+                stats[4] = max(stats[4], latency)
+        elif event_id == EVENT_TASK_SWITCHED_OUT:
+            task, since = running.pop(core, (None, None))
+            if task == handle:
+                tasks.setdefault(handle, [0, 0, 0, 0, 0])[1] += timestamp - since
+        elif event_id >= FIRST_API_EVENT:
+            task = running.get(core, (0, 0))[0]
+            api = event_id & ~API_RETURN_FLAG
+            if event_id & API_RETURN_FLAG:
+                entered = open_calls.pop((task, api), None)
+                if entered is not None:
+                    stats = apis.setdefault(api, [0, 0, 0])
+                    stats[0] += 1
+                    stats[1] += timestamp - entered
+                    stats[2] = max(stats[2], timestamp - entered)
+            else:
+                open_calls[(task, api)] = timestamp
+
+    for core in range(trace.num_cores):
+        print('Core %d: %d events lost to ring overwrite' % (core, trace.dropped[core]))
+
+    print('\n%-18s %10s %16s %18s %18s' % ('Task', 'SwitchIns', 'RunTime', 'AvgReadyLatency', 'MaxReadyLatency'))
+    for handle, (switch_ins, run_time, latency_sum, latency_count, latency_max) in \
+            sorted(tasks.items(), key=lambda item: -item[1][1]):
+        average = latency_sum // latency_count if latency_count else 0
+        print('%-18s %10d %16s %18s %18s' % (trace.object_name(handle), switch_ins, trace.format_time(run_time),
+                                             trace.format_time(average), trace.format_time(latency_max)))
+
+    print('\n%-30s %10s %18s %18s' % ('API', 'Calls', 'AvgDuration', 'MaxDuration'))
+    for api, (calls, duration_sum, duration_max) in sorted(apis.items()):
+        print('%-30s %10d %18s %18s' % (EVENT_NAMES.get(api, '0x%02X' % api), calls,
+                                        trace.format_time(duration_sum // calls), trace.format_time(duration_max)))
+
+
+def print_heap_trace(trace):
+    # The size recorded by heap_2, heap_4 and heap_5 is that of the whole block,
+    # including its header and alignment padding.
+    print('# pvPortMalloc()/vPortFree() calls, sizes as recorded by the heap')
+    for core in range(trace.num_cores):
+        if trace.dropped[core]:
+            print('# core %d: %d events lost to ring overwrite' % (core, trace.dropped[core]))
+    for _, _, _, event_id, handle, argument in trace.events:
+        if event_id == EVENT_MALLOC:
+            print('malloc 0x%08X %d' % (handle, argument))
+        elif event_id == EVENT_FREE:
+            print('free 0x%08X' % handle)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode a FreeRTOS binary trace recorder dump.')
+    parser.add_argument('dump', help='file holding the contents of xTraceRecorder')
+    parser.add_argument('--summary', action='store_true',
+                        help='print per task run time and ready-to-running latency, and API call durations')
+    parser.add_argument('--heap-trace', action='store_true',
+                        help='print the allocations and frees in the format replayed by heap_benchmark')
+    args = parser.parse_args()
+
+    with open(args.dump, 'rb') as dump:
+        trace = Trace(dump.read())
+
+    if args.heap_trace:
+        print_heap_trace(trace)
+    elif args.summary:
+        print_summary(trace)
+    else:
+        print_timeline(trace)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())